@@ -0,0 +1,192 @@
+#ifndef BATCHKALMANFILTER_H
+#define BATCHKALMANFILTER_H
+
+#include <BayesFilters/FilteringAlgorithm.h>
+#include <BayesFilters/LinearMeasurementModel.h>
+#include <BayesFilters/LinearStateModel.h>
+
+#include <Eigen/Dense>
+
+#include <memory>
+
+namespace bfl {
+    class BatchKalmanFilter;
+}
+
+/**
+ * Kalman filter of many independent targets sharing the same linear state model and linear measurement model.
+ *
+ * The means and the covariance matrices of the targets are stored in a structure-of-arrays layout:
+ * means() has one row per target, and covariances() has one row per target holding the entries of its
+ * covariance matrix in column-major order. Hence, the same entry of all the targets is a contiguous column
+ * and the prediction and the correction of all the targets are evaluated with products by small matrices
+ * built from the model matrices, and with element-wise operations on columns, without per-target calls.
+ *
+ * The measurement model provides, with LinearMeasurementModel::measure(), a matrix with one column per target,
+ * and evaluates the innovations of all the targets with one call to MeasurementModel::innovation(), given the
+ * predicted measurements and the measurements with one column per target.
+ * The targets are split in contiguous ranges processed by num_threads threads, see utils::parallel_for().
+ */
+class bfl::BatchKalmanFilter : public bfl::FilteringAlgorithm
+{
+public:
+    BatchKalmanFilter(std::unique_ptr<LinearStateModel> state_model, std::unique_ptr<LinearMeasurementModel> measurement_model, const std::size_t targets) noexcept;
+
+    BatchKalmanFilter(std::unique_ptr<LinearStateModel> state_model, std::unique_ptr<LinearMeasurementModel> measurement_model, const std::size_t targets, const unsigned int num_threads) noexcept;
+
+    BatchKalmanFilter(BatchKalmanFilter&& batch_kf) noexcept;
+
+    virtual ~BatchKalmanFilter() noexcept;
+
+    /**
+     * Set the mean and the covariance matrix of a target.
+     */
+    void setState(const std::size_t target, const Eigen::Ref<const Eigen::VectorXd>& mean, const Eigen::Ref<const Eigen::MatrixXd>& covariance);
+
+    Eigen::VectorXd getMean(const std::size_t target) const;
+
+    Eigen::MatrixXd getCovariance(const std::size_t target) const;
+
+    /**
+     * Means of the targets, one per row.
+     */
+    const Eigen::MatrixXd& means() const;
+
+    /**
+     * Covariance matrices of the targets, one per row in column-major order.
+     */
+    const Eigen::MatrixXd& covariances() const;
+
+    std::size_t getNumberOfTargets() const;
+
+    unsigned int getNumberOfThreads() const;
+
+    /**
+     * Predict the state of all the targets.
+     */
+    void predict();
+
+    /**
+     * Correct the state of all the targets given their measurements, one per column.
+     * Return false, leaving the state unchanged, if the noise covariance matrix or the innovations are not available.
+     * The targets whose covariance matrix of the predicted measurement S is singular are corrected with a LDL'
+     * decomposition, see correctTarget(). Return false if S is not positive semidefinite for some targets,
+     * whose state is left unchanged, after correcting the other ones.
+     */
+    bool correct(const Eigen::Ref<const Eigen::MatrixXd>& measurements);
+
+    /**
+     * Correct the state of all the targets using LinearMeasurementModel::measure().
+     * Return false, leaving the state unchanged, if the measurements or the noise covariance matrix are not available.
+     */
+    bool correct();
+
+    bool skip(const std::string& what_step, const bool status) override;
+
+protected:
+    bool initialization() override;
+
+    void filteringStep() override;
+
+    bool runCondition() override;
+
+    /**
+     * Fetch the model matrices and build the matrices acting on the rows of means() and covariances(),
+     * unless the cached ones are still valid according to the revisions of the models.
+     */
+    void updateStateModelMatrices();
+
+    /**
+     * As updateStateModelMatrices(), returning false if the noise covariance matrix is not available.
+     */
+    bool updateMeasurementModelMatrices();
+
+    void predictRange(const std::size_t begin, const std::size_t size);
+
+    void correctRange(const std::size_t begin, const std::size_t size);
+
+    /**
+     * Correct a single target with a LDL' decomposition of S, using the pseudo-inverse of S if it is singular.
+     * Return false, leaving the target unchanged, if S is not positive semidefinite.
+     */
+    bool correctTarget(const std::size_t target);
+
+    std::unique_ptr<LinearStateModel> state_model_;
+
+    std::unique_ptr<LinearMeasurementModel> measurement_model_;
+
+    std::size_t targets_;
+
+    unsigned int num_threads_;
+
+    std::size_t state_size_ = 0;
+
+    std::size_t meas_size_ = 0;
+
+    bool skip_prediction_ = false;
+
+    bool skip_correction_ = false;
+
+    /**
+     * State of the targets in structure-of-arrays layout.
+     */
+    Eigen::MatrixXd mean_;
+
+    Eigen::MatrixXd covariance_;
+
+    /**
+     * Matrices acting on the rows of mean_ and covariance_:
+     * F', (F kron F)' such that vec(F * P * F') = vec(P) * (F kron F)', vec(Q)',
+     * H', (I kron H)' such that vec(H * P) = vec(P) * (I kron H)', (H kron H)' and vec(R)'.
+     */
+    Eigen::MatrixXd Ft_;
+
+    Eigen::MatrixXd FF_t_;
+
+    Eigen::RowVectorXd Q_vec_;
+
+    bool valid_state_model_matrices_ = false;
+
+    std::size_t state_model_revision_ = 0;
+
+    Eigen::MatrixXd Ht_;
+
+    Eigen::MatrixXd IH_t_;
+
+    Eigen::MatrixXd HH_t_;
+
+    Eigen::RowVectorXd R_vec_;
+
+    bool valid_measurement_model_matrices_ = false;
+
+    std::size_t measurement_model_revision_ = 0;
+
+    /**
+     * Innovations returned by the measurement model, one per column.
+     */
+    Eigen::MatrixXd model_innovations_;
+
+    /**
+     * Buffers in structure-of-arrays layout: predicted means and covariance matrices, innovations, H * P,
+     * the covariance matrices of the predicted measurements with their Cholesky factors, and the diagonal
+     * entry of S being factorized.
+     */
+    Eigen::MatrixXd mean_buffer_;
+
+    Eigen::MatrixXd covariance_buffer_;
+
+    Eigen::MatrixXd innovations_;
+
+    Eigen::MatrixXd HP_;
+
+    Eigen::MatrixXd S_;
+
+    Eigen::ArrayXd pivots_;
+
+    /**
+     * Targets whose S is not positive definite, to be corrected by correctTarget().
+     */
+    Eigen::Array<bool, Eigen::Dynamic, 1> fallback_;
+};
+
+#endif /* BATCHKALMANFILTER_H */
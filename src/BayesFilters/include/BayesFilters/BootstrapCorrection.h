@@ -37,7 +37,11 @@ protected:
     void correctStep(const ParticleSet& pred_particles, ParticleSet& cor_particles) override;
 
     bool valid_likelihood_ = false;
-    Eigen::VectorXd likelihood_;
+
+    /**
+     * The likelihood is stored in the log space, as required by the weights update.
+     */
+    Eigen::VectorXd log_likelihood_;
 };
 
 #endif /* UPDATEPARTICLES_H */
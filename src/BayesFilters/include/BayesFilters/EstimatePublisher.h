@@ -0,0 +1,145 @@
+#ifndef ESTIMATEPUBLISHER_H
+#define ESTIMATEPUBLISHER_H
+
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/ParticleSet.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class EstimatePublisher;
+}
+
+/**
+ * Publication of the latest estimate of a filter, written by the filtering thread once per step
+ * and read by any number of threads.
+ *
+ * Writing never waits for the readers and reading never blocks the writer. The estimate is stored in two slots,
+ * each one guarded by a sequence counter (seqlock): publish() overwrites the older slot, read() copies the newer
+ * one and copies it again in the unlikely case the writer has overwritten it in the meantime, i.e. if two
+ * publications take place during a copy.
+ *
+ * The sizes of the published data are fixed on construction, so that no memory is allocated afterwards.
+ * There must be a single writer.
+ */
+class bfl::EstimatePublisher
+{
+public:
+    struct Snapshot
+    {
+        /**
+         * Index of the filtering step of the estimate.
+         */
+        std::size_t step = 0;
+
+        Eigen::VectorXd estimate;
+
+        /**
+         * The belief, if published: state and weight are set for particle sets, mean and covariance
+         * for Gaussian mixtures and particle sets with Gaussian belief.
+         * The weights are copied as they are stored in the belief, i.e. log-weights for particle sets.
+         */
+        Eigen::MatrixXd state;
+
+        Eigen::VectorXd weight;
+
+        Eigen::MatrixXd mean;
+
+        Eigen::MatrixXd covariance;
+    };
+
+    /**
+     * Publish the estimate only.
+     */
+    EstimatePublisher(const std::size_t estimate_size) noexcept;
+
+    /**
+     * Publish the estimate and a Gaussian mixture sized as belief.
+     */
+    EstimatePublisher(const std::size_t estimate_size, const GaussianMixture& belief) noexcept;
+
+    /**
+     * Publish the estimate and a particle set sized as belief.
+     */
+    EstimatePublisher(const std::size_t estimate_size, const ParticleSet& belief) noexcept;
+
+    virtual ~EstimatePublisher() noexcept = default;
+
+    void publish(const std::size_t step, const Eigen::Ref<const Eigen::VectorXd>& estimate);
+
+    void publish(const std::size_t step, const Eigen::Ref<const Eigen::VectorXd>& estimate, const GaussianMixture& belief);
+
+    void publish(const std::size_t step, const Eigen::Ref<const Eigen::VectorXd>& estimate, const ParticleSet& belief);
+
+    /**
+     * Copy the latest publication into snapshot, resizing its matrices if needed.
+     * Return false, leaving snapshot untouched, if nothing has been published yet.
+     */
+    bool read(Snapshot& snapshot) const;
+
+    std::pair<bool, Snapshot> read() const;
+
+    /**
+     * Number of publications so far.
+     */
+    std::size_t getPublications() const;
+
+private:
+    enum Block : std::size_t
+    {
+        estimate_block = 0,
+        state_block,
+        weight_block,
+        mean_block,
+        covariance_block,
+        number_of_blocks
+    };
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence{0};
+
+        std::atomic<std::size_t> step{0};
+
+        /**
+         * The blocks of the publication, one after the other.
+         * Atomic elements accessed with relaxed ordering, so that a copy concurrent to a publication is not a data race.
+         */
+        std::unique_ptr<std::atomic<double>[]> data;
+    };
+
+    EstimatePublisher(const std::array<std::pair<std::size_t, std::size_t>, number_of_blocks>& sizes) noexcept;
+
+    /**
+     * Throw if the sizes of a block differ from the ones given on construction.
+     */
+    void checkBlock(const Block block, const Eigen::Ref<const Eigen::MatrixXd>& matrix) const;
+
+    /**
+     * Open the slot of the next publication, set the step and mark it as being written.
+     */
+    Slot& beginWrite(const std::size_t step);
+
+    void writeBlock(Slot& slot, const Block block, const Eigen::Ref<const Eigen::MatrixXd>& matrix);
+
+    void endWrite(Slot& slot);
+
+    /**
+     * Rows and columns of the blocks.
+     */
+    const std::array<std::pair<std::size_t, std::size_t>, number_of_blocks> sizes_;
+
+    std::array<std::size_t, number_of_blocks + 1> offsets_;
+
+    std::array<Slot, 2> slots_;
+
+    std::atomic<std::size_t> publications_{0};
+};
+
+#endif /* ESTIMATEPUBLISHER_H */
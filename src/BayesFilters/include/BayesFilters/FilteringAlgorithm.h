@@ -1,8 +1,11 @@
 #ifndef FILTERINGALGORITHM_H
 #define FILTERINGALGORITHM_H
 
+#include <BayesFilters/FilteringStatistics.h>
 #include <BayesFilters/Logger.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <string>
@@ -12,6 +15,8 @@
 
 namespace bfl {
     class FilteringAlgorithm;
+    class FilteringExecutor;
+    class ReplayRunner;
     typedef typename std::unordered_map<std::string, double>      FilteringParamtersD;
     typedef typename std::unordered_map<std::string, std::string> FilteringParamtersS;
 }
@@ -24,6 +29,12 @@ public:
 
     bool boot();
 
+    /**
+     * Boot the filter without starting a dedicated thread: each filtering step is run as a task by the executor.
+     * The executor must outlive the filtering recursion, i.e. until wait() returns.
+     */
+    bool boot(FilteringExecutor& executor);
+
     void run();
 
     bool wait();
@@ -38,6 +49,35 @@ public:
 
     bool isRunning();
 
+    /**
+     * Run a filtering step only when notifyMeasurement() is called, instead of running them back to back.
+     * The filtering thread blocks in between. Notifications received while a filtering step is running
+     * are merged and trigger a single further step.
+     */
+    void enableEventDrivenRun();
+
+    /**
+     * As enableEventDrivenRun(), but if no notification is received within timeout from the previous step,
+     * a filtering step runs anyway. Since no new measurement is available, MeasurementModel::freezeMeasurements()
+     * is expected to fail and the correction to be skipped, resulting in a prediction-only step.
+     * The timeout is not supported by filters booted on a FilteringExecutor: this method throws if the filter
+     * is booted on an executor, and boot(FilteringExecutor&) fails if the timeout is enabled.
+     */
+    void enableEventDrivenRun(const std::chrono::microseconds& timeout);
+
+    void disableEventDrivenRun();
+
+    /**
+     * Signal that a new measurement is available, e.g. from an Agent or a MeasurementModel.
+     */
+    void notifyMeasurement();
+
+    /**
+     * Timing statistics of the filtering steps and of their phases.
+     * The first element is false if the library has been built without the ENABLE_INSTRUMENTATION option.
+     */
+    std::pair<bool, FilteringStatistics::Report> getStatistics() const;
+
     virtual bool skip(const std::string& what_step, const bool status) = 0;
 
 protected:
@@ -47,6 +87,15 @@ protected:
 
     virtual bool runCondition() = 0;
 
+#if defined(BFL_INSTRUMENTATION)
+    /**
+     * Filled by the filtering algorithms through the BFL_STATISTICS_SCOPE() and BFL_STATISTICS() macros.
+     */
+    FilteringStatistics statistics_;
+#endif
+
+    friend class ReplayRunner;
+
 private:
     unsigned int filtering_step_ = 0;
 
@@ -54,6 +103,25 @@ private:
 
     void filteringRecursion();
 
+    /**
+     * Run one step of filteringRecursion() as a task of executor_, then submit the next one.
+     */
+    void scheduledStep();
+
+    void submitStep();
+
+    /**
+     * Block until a measurement is notified or the timeout expires.
+     * Return false if woken up by teardown(), reset() or reboot() instead.
+     */
+    bool waitMeasurement();
+
+    /**
+     * Submit the next step of a filter booted on an executor, if it is waiting for a measurement.
+     * To be called while holding mtx_run_.
+     */
+    void resumeWaitingStep();
+
     std::mutex mtx_run_;
 
     std::condition_variable cv_run_;
@@ -63,6 +131,36 @@ private:
     bool reset_ = false;
 
     bool teardown_ = false;
+
+    /**
+     * State of the filtering recursion run by an executor.
+     */
+    FilteringExecutor* executor_ = nullptr;
+
+    bool initialized_ = false;
+
+    bool parked_ = false;
+
+    bool finished_ = false;
+
+    std::condition_variable cv_finished_;
+
+    /**
+     * State of the event-driven run mode, protected by mtx_run_.
+     * event_driven_ is only written holding mtx_run_, but it is atomic so that the filtering steps can skip
+     * locking mtx_run_ when the event-driven run mode is disabled.
+     */
+    std::atomic<bool> event_driven_{false};
+
+    bool event_timeout_enabled_ = false;
+
+    std::chrono::microseconds event_timeout_;
+
+    std::size_t pending_measurements_ = 0;
+
+    bool waiting_measurement_ = false;
+
+    std::condition_variable cv_measurement_;
 };
 
 #endif /* FILTERINGALGORITHM_H */
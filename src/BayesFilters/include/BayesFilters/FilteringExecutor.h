@@ -0,0 +1,85 @@
+#ifndef FILTERINGEXECUTOR_H
+#define FILTERINGEXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bfl {
+    class FilteringExecutor;
+}
+
+/**
+ * Work-stealing thread pool running the filtering steps of many FilteringAlgorithm instances.
+ *
+ * A FilteringAlgorithm booted with FilteringAlgorithm::boot(FilteringExecutor&) does not start its own thread.
+ * Instead, each of its filtering steps is submitted as a task to the executor, keeping the semantics of
+ * FilteringAlgorithm::run(), wait(), reset(), reboot() and teardown().
+ *
+ * Each worker owns a queue of tasks, processed in order. Tasks submitted by a worker are queued in its own queue,
+ * the other ones are distributed among the workers in round robin. A worker with an empty queue steals
+ * the most recent task from the queues of the other workers, or sleeps until a new task is submitted.
+ *
+ * The workers may be pinned to the cores, worker i to core i modulo the number of cores (Linux only).
+ * All the FilteringAlgorithm instances using the executor must be torn down and waited for before it is destroyed.
+ */
+class bfl::FilteringExecutor
+{
+public:
+    FilteringExecutor(const unsigned int num_workers) noexcept;
+
+    FilteringExecutor(const unsigned int num_workers, const bool pin_workers) noexcept;
+
+    virtual ~FilteringExecutor() noexcept;
+
+    /**
+     * Queue a task to be run by one of the workers.
+     */
+    void submit(std::function<void()> task);
+
+    unsigned int getNumberOfWorkers() const;
+
+    /**
+     * Return true if the workers have been pinned to the cores.
+     */
+    bool isPinned() const;
+
+private:
+    struct Worker
+    {
+        std::thread thread;
+
+        std::mutex mutex;
+
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(const unsigned int index);
+
+    bool pop(const unsigned int index, std::function<void()>& task);
+
+    bool pinWorker(const unsigned int index);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    /**
+     * Number of queued tasks, protected by mutex_, on which idle workers wait.
+     */
+    std::mutex mutex_;
+
+    std::condition_variable cv_tasks_;
+
+    std::size_t queued_tasks_ = 0;
+
+    unsigned int next_worker_ = 0;
+
+    bool stop_ = false;
+
+    bool pinned_ = false;
+};
+
+#endif /* FILTERINGEXECUTOR_H */
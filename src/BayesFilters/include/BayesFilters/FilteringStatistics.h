@@ -0,0 +1,175 @@
+#ifndef FILTERINGSTATISTICS_H
+#define FILTERINGSTATISTICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace bfl {
+    class FilteringStatistics;
+}
+
+/**
+ * Timing statistics of the phases of the filtering steps of a FilteringAlgorithm.
+ *
+ * The durations, measured with a monotonic clock, and the effective sample size of particle filters are stored
+ * in rolling windows of the latest samples, summarized by their median, 99th percentile and maximum.
+ * The number of steps and of resamplings are counted since the last reset.
+ *
+ * The samples are recorded by one thread at a time, the one running the filtering steps, without locks:
+ * each window is guarded by a sequence counter, and getReport(), which can be called by any thread,
+ * copies a window again if it has been written in the meantime. Hence, polling the statistics never
+ * stalls the filtering steps.
+ *
+ * The statistics are collected only if the library is built with the ENABLE_INSTRUMENTATION CMake option,
+ * defining BFL_INSTRUMENTATION. Otherwise the BFL_STATISTICS_SCOPE() and BFL_STATISTICS() macros,
+ * used by the filtering algorithms, expand to nothing.
+ */
+class bfl::FilteringStatistics
+{
+public:
+    enum class Phase : std::size_t
+    {
+        Prediction = 0,
+        Correction,
+        Normalization,
+        Resampling,
+        Logging,
+        Step
+    };
+
+    static constexpr std::size_t number_of_phases = 6;
+
+    /**
+     * Summary of a rolling window. Durations are in microseconds.
+     */
+    struct Summary
+    {
+        std::size_t samples = 0;
+
+        double p50 = 0.0;
+
+        double p99 = 0.0;
+
+        double max = 0.0;
+    };
+
+    struct Report
+    {
+        std::size_t steps = 0;
+
+        /**
+         * Indexed by Phase.
+         */
+        std::array<Summary, number_of_phases> phases;
+
+        Summary effective_sample_size;
+
+        std::size_t resamplings = 0;
+
+        /**
+         * Number of resamplings per filtering step.
+         */
+        double resampling_frequency = 0.0;
+
+        const Summary& phase(const Phase phase) const;
+    };
+
+    /**
+     * Measure the duration of a phase from its construction to its destruction.
+     */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(FilteringStatistics& statistics, const Phase phase) noexcept;
+
+        ~ScopedTimer() noexcept;
+
+    private:
+        FilteringStatistics& statistics_;
+
+        const Phase phase_;
+
+        const std::chrono::steady_clock::time_point start_;
+    };
+
+    FilteringStatistics() noexcept;
+
+    FilteringStatistics(const std::size_t window_size) noexcept;
+
+    virtual ~FilteringStatistics() noexcept = default;
+
+    /**
+     * Recording the duration of Phase::Step also counts a filtering step.
+     */
+    void recordDuration(const Phase phase, const std::chrono::steady_clock::duration& duration);
+
+    void recordEffectiveSampleSize(const double effective_sample_size);
+
+    void recordResampling();
+
+    Report getReport() const;
+
+    /**
+     * Must not be called concurrently with the record methods, e.g. while the filter is running.
+     */
+    void reset();
+
+private:
+    /**
+     * Ring buffer of the latest window_size_ samples, with a sequence counter that is odd while the window is written.
+     */
+    struct Window
+    {
+        std::unique_ptr<std::atomic<double>[]> samples;
+
+        std::atomic<std::size_t> sequence{0};
+
+        std::size_t next = 0;
+
+        std::atomic<std::size_t> count{0};
+    };
+
+    void push(Window& window, const double sample);
+
+    /**
+     * Copy a consistent snapshot of the window into the first elements of samples, of size window_size_, and summarize it.
+     */
+    Summary summarize(const Window& window, std::vector<double>& samples) const;
+
+    static void increment(std::atomic<std::size_t>& counter);
+
+    const std::size_t window_size_;
+
+    std::array<Window, number_of_phases> phases_;
+
+    Window effective_sample_size_;
+
+    std::atomic<std::size_t> steps_{0};
+
+    std::atomic<std::size_t> resamplings_{0};
+};
+
+
+#if defined(BFL_INSTRUMENTATION)
+/**
+ * Time the rest of the enclosing scope as the given phase, in a FilteringAlgorithm method.
+ * At most one per scope.
+ */
+#define BFL_STATISTICS_SCOPE(phase) \
+    bfl::FilteringStatistics::ScopedTimer bfl_statistics_scope_(statistics_, bfl::FilteringStatistics::Phase::phase)
+
+/**
+ * Evaluate the statement only if the statistics are enabled.
+ */
+#define BFL_STATISTICS(statement) statement
+#else
+#define BFL_STATISTICS_SCOPE(phase)
+
+#define BFL_STATISTICS(statement)
+#endif
+
+#endif /* FILTERINGSTATISTICS_H */
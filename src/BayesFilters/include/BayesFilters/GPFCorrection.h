@@ -8,7 +8,6 @@
 #include <BayesFilters/PFCorrection.h>
 #include <BayesFilters/StateModel.h>
 
-#include <functional>
 #include <memory>
 #include <random>
 
@@ -41,10 +40,18 @@ public:
 protected:
     void correctStep(const bfl::ParticleSet& pred_particles, bfl::ParticleSet& corr_particles) override;
 
-    Eigen::VectorXd sampleFromProposal(const Eigen::VectorXd& mean, const Eigen::MatrixXd& covariance);
+    /**
+     * Replace the state of each particle with a sample from its proposal distribution,
+     * a Gaussian having the mean and the covariance associated to the particle.
+     * Each covariance matrix is factorized once and the factor is used both to sample
+     * and to evaluate the proposal. Return the logarithm of the proposal in the samples.
+     */
+    Eigen::VectorXd sampleFromProposal(bfl::ParticleSet& particles);
 
     double evaluateProposal(const Eigen::VectorXd& state, const Eigen::VectorXd& mean, const Eigen::MatrixXd& covariance);
 
+    double logEvaluateProposal(const Eigen::VectorXd& state, const Eigen::VectorXd& mean, const Eigen::MatrixXd& covariance);
+
     std::unique_ptr<bfl::GaussianCorrection> gaussian_correction_;
 
     std::unique_ptr<bfl::LikelihoodModel> likelihood_model_;
@@ -60,10 +67,9 @@ protected:
     std::normal_distribution<double> distribution_;
 
     /**
-     * Random number generator function from a Normal distribution.
-     * A call to `gaussian_random_sample_()` returns a double-precision floating-point random number.
+     * Standard normal samples used by sampleFromProposal(), drawn in bulk for all the particles.
      */
-    std::function<double()> gaussian_random_sample_;
+    Eigen::MatrixXd rand_vectors_;
 };
 
 #endif /* GPFCORRECTION_H */
@@ -1,6 +1,7 @@
 #ifndef GAUSSIANFILTER_H
 #define GAUSSIANFILTER_H
 
+#include <BayesFilters/EstimatePublisher.h>
 #include <BayesFilters/FilteringAlgorithm.h>
 #include <BayesFilters/Gaussian.h>
 #include <BayesFilters/GaussianPrediction.h>
@@ -30,6 +31,18 @@ public:
 
     bool skip(const std::string& what_step, const bool status) override;
 
+    /**
+     * Publish the corrected mean at the end of each filtering step, together with the corrected Gaussian
+     * if full_belief is true. Other threads read the latest publication from getPublisher() without
+     * blocking the filter. To be called before boot().
+     */
+    void enablePublication(const bool full_belief);
+
+    /**
+     * Throw if enablePublication() has not been called.
+     */
+    const EstimatePublisher& getPublisher() const;
+
 protected:
     Gaussian predicted_state_;
 
@@ -38,6 +51,10 @@ protected:
     std::unique_ptr<GaussianPrediction> prediction_;
 
     std::unique_ptr<GaussianCorrection> correction_;
+
+    std::unique_ptr<EstimatePublisher> publisher_;
+
+    bool publish_belief_ = false;
 };
 
 #endif /* GAUSSIANFILTER_H */
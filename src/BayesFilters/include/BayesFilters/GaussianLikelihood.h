@@ -3,6 +3,8 @@
 
 #include <BayesFilters/LikelihoodModel.h>
 
+#include <Eigen/Cholesky>
+
 namespace bfl {
     class GaussianLikelihood;
 }
@@ -17,10 +19,39 @@ public:
 
     virtual ~GaussianLikelihood() noexcept { };
 
+    bool hasPreparedLogLikelihood() const override;
+
+    /**
+     * Update the Cholesky factorization of the noise covariance matrix
+     * only if the matrix changed since the last call.
+     */
+    bool prepareLogLikelihood(const MeasurementModel& measurement_model) override;
+
+    std::pair<bool, Eigen::VectorXd> preparedLogLikelihood(const MeasurementModel& measurement_model, const Eigen::Ref<const Eigen::MatrixXd>& pred_states) const override;
+
 protected:
     std::pair<bool, Eigen::VectorXd> likelihood(const MeasurementModel& measurement_model, const Eigen::Ref<const Eigen::MatrixXd>& pred_states) override;
 
+    std::pair<bool, Eigen::VectorXd> logLikelihood(const MeasurementModel& measurement_model, const Eigen::Ref<const Eigen::MatrixXd>& pred_states) override;
+
+    /**
+     * Return false if the matrix is not positive definite.
+     */
+    bool updateFactorization(const Eigen::Ref<const Eigen::MatrixXd>& covariance_matrix);
+
     double scale_factor_;
+
+    /**
+     * Noise covariance matrix, its Cholesky factorization
+     * and the logarithm of its determinant.
+     */
+    Eigen::MatrixXd covariance_matrix_;
+
+    Eigen::LLT<Eigen::MatrixXd> covariance_llt_;
+
+    double log_determinant_ = 0.0;
+
+    bool valid_factorization_ = false;
 };
 
 #endif /* GAUSSIANLIKELIHOOD_H */
@@ -66,6 +66,13 @@ public:
     std::size_t dim_noise;
 
 protected:
+    /**
+     * If allocate_mean_covariance is false, neither the means nor the covariance
+     * matrices of the components are allocated.
+     * Intended for derived classes, e.g. ParticleSet, that may not need them.
+     */
+    GaussianMixture(const std::size_t components, const std::size_t dim_linear, const std::size_t dim_circular, const bool allocate_mean_covariance);
+
     Eigen::MatrixXd mean_;
 
     Eigen::MatrixXd covariance_;
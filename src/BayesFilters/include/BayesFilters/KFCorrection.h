@@ -5,7 +5,9 @@
 #include <BayesFilters/GaussianMixture.h>
 #include <BayesFilters/LinearMeasurementModel.h>
 
+#include <Eigen/Cholesky>
 #include <Eigen/Dense>
+#include <Eigen/SparseCore>
 
 namespace bfl {
     class KFCorrection;
@@ -28,8 +30,51 @@ protected:
 
     std::pair<bool, Eigen::VectorXd> likelihood(const Eigen::Ref<const Eigen::MatrixXd>& innovations);
 
-private:
+    /**
+     * Correct all the components of the mixture given the innovations, one per column,
+     * using the cached model matrices H_ and R_.
+     */
+    virtual void correctComponents(const GaussianMixture& pred_state, const Eigen::Ref<const Eigen::MatrixXd>& innovations, GaussianMixture& corr_state);
+
+    /**
+     * Fetch the measurement matrix and the noise covariance matrix from the model,
+     * unless the cached ones are still valid according to LinearMeasurementModel::getRevision().
+     * Return false if the noise covariance matrix is not available.
+     */
+    bool updateModelMatrices();
+
     std::unique_ptr<LinearMeasurementModel> measurement_model_;
+
+    /**
+     * Cached measurement matrix and noise covariance matrix.
+     */
+    Eigen::MatrixXd H_;
+
+    Eigen::MatrixXd R_;
+
+    /**
+     * Sparse representation of the measurement matrix, if provided by the model,
+     * see LinearMeasurementModel::getSparseMeasurementMatrix().
+     */
+    bool sparse_H_ = false;
+
+    Eigen::SparseMatrix<double> H_sparse_;
+
+    bool valid_model_matrices_ = false;
+
+    std::size_t model_revision_ = 0;
+
+    /**
+     * Buffers reused across steps: Px * H', the covariance matrix Py of the predicted
+     * measurement with its LDL' decomposition, and a factor of K * Py * K'.
+     */
+    Eigen::MatrixXd PxHt_;
+
+    Eigen::MatrixXd Py_;
+
+    Eigen::LDLT<Eigen::MatrixXd> Py_ldlt_;
+
+    Eigen::MatrixXd W_;
 };
 
 #endif /* KFCORRECTION_H */
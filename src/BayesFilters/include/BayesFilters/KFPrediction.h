@@ -6,6 +6,9 @@
 #include <BayesFilters/LinearStateModel.h>
 #include <BayesFilters/ExogenousModel.h>
 
+#include <Eigen/Dense>
+#include <Eigen/SparseCore>
+
 #include <memory>
 
 namespace bfl {
@@ -27,9 +30,39 @@ public:
 protected:
     void predictStep(const GaussianMixture& prev_state, GaussianMixture& pred_state) override;
 
+    /**
+     * Fetch the state transition matrix and the noise covariance matrix from the model,
+     * unless the cached ones are still valid according to LinearStateModel::getRevision().
+     */
+    void updateModelMatrices();
+
     std::unique_ptr<LinearStateModel> state_model_;
 
     std::unique_ptr<ExogenousModel> exogenous_model_;
+
+    /**
+     * Cached state transition matrix and noise covariance matrix.
+     */
+    Eigen::MatrixXd F_;
+
+    Eigen::MatrixXd Q_;
+
+    /**
+     * Sparse representation of the state transition matrix, if provided by the model,
+     * see LinearStateModel::getSparseStateTransitionMatrix().
+     */
+    bool sparse_F_ = false;
+
+    Eigen::SparseMatrix<double> F_sparse_;
+
+    bool valid_model_matrices_ = false;
+
+    std::size_t model_revision_ = 0;
+
+    /**
+     * Buffer for F * P reused across steps.
+     */
+    Eigen::MatrixXd FP_;
 };
 
 #endif /* KFPREDICTION_H */
@@ -15,18 +15,64 @@ class bfl::LTIMeasurementModel : public bfl::LinearMeasurementModel
 public:
     LTIMeasurementModel(const Eigen::Ref<const Eigen::MatrixXd>& measurement_matrix, const Eigen::Ref<const Eigen::MatrixXd>& noise_covariance_matrix);
 
+    /**
+     * The measurement matrix is provided as a sparse matrix if at most max_sparse_density of its entries are non-zero,
+     * utils::default_max_sparse_density with the other constructor.
+     */
+    LTIMeasurementModel(const Eigen::Ref<const Eigen::MatrixXd>& measurement_matrix, const Eigen::Ref<const Eigen::MatrixXd>& noise_covariance_matrix, const double max_sparse_density);
+
     virtual ~LTIMeasurementModel() noexcept { };
 
     std::pair<bool, Eigen::MatrixXd> getNoiseCovarianceMatrix() const override;
 
     Eigen::MatrixXd getMeasurementMatrix() const override;
 
+    /**
+     * Return the measurement matrix as a sparse matrix if at most max_sparse_density of its entries are non-zero.
+     * The sparse matrix is evaluated again only when revision_ changes.
+     */
+    std::pair<bool, Eigen::SparseMatrix<double>> getSparseMeasurementMatrix() const override;
+
+    /**
+     * Allow the filtering steps to cache the measurement and noise covariance matrices until the revision changes.
+     * Derived classes changing H_ or R_ after enabling the revision tracking must increment revision_.
+     */
+    void enableRevisionTracking();
+
+    void disableRevisionTracking();
+
+    /**
+     * Return false, the default, unless the revision tracking has been enabled.
+     */
+    std::pair<bool, std::size_t> getRevision() const override;
+
+    /**
+     * Use the measurement matrix in place, without copying it.
+     */
+    std::pair<bool, bfl::Data> predictedMeasure(const Eigen::Ref<const Eigen::MatrixXd>& cur_states) const override;
+
 protected:
     /* Measurement matrix. */
     Eigen::MatrixXd H_;
 
     /* Matrix covariance of the zero mean additive white measurement noise. */
     Eigen::MatrixXd R_;
+
+    /* Maximum fraction of non-zero entries of H_ to provide it as a sparse matrix. */
+    double max_sparse_density_;
+
+    /* Revision of H_ and R_, to be incremented by derived classes changing them. */
+    std::size_t revision_ = 0;
+
+    /* Whether the revision is reported to the filtering steps. */
+    bool revision_tracking_ = false;
+
+    /* Sparse representation of H_, evaluated at revision sparse_revision_. */
+    mutable std::pair<bool, Eigen::SparseMatrix<double>> sparse_H_;
+
+    mutable bool valid_sparse_H_ = false;
+
+    mutable std::size_t sparse_revision_ = 0;
 };
 
 #endif /* LTIMEMEASUREMENTMODEL_H */
@@ -15,6 +15,12 @@ class bfl::LTIStateModel : public bfl::LinearStateModel
 public:
     LTIStateModel(const Eigen::Ref<const Eigen::MatrixXd>& transition_matrix, const Eigen::Ref<const Eigen::MatrixXd>& noise_covariance_matrix);
 
+    /**
+     * The state transition matrix is provided as a sparse matrix if at most max_sparse_density of its entries are non-zero,
+     * utils::default_max_sparse_density with the other constructor.
+     */
+    LTIStateModel(const Eigen::Ref<const Eigen::MatrixXd>& transition_matrix, const Eigen::Ref<const Eigen::MatrixXd>& noise_covariance_matrix, const double max_sparse_density);
+
     virtual ~LTIStateModel() noexcept { };
 
     void propagate(const Eigen::Ref<const Eigen::MatrixXd>& cur_states, Eigen::Ref<Eigen::MatrixXd> prop_states) override;
@@ -23,10 +29,29 @@ public:
 
     Eigen::MatrixXd getStateTransitionMatrix() override;
 
+    /**
+     * Return the state transition matrix as a sparse matrix if at most max_sparse_density of its entries are non-zero.
+     * The sparse matrix is evaluated again only when revision_ changes.
+     */
+    std::pair<bool, Eigen::SparseMatrix<double>> getSparseStateTransitionMatrix() override;
+
     bool setProperty(const std::string& property) override;
 
     Eigen::MatrixXd getJacobian() override;
 
+    /**
+     * Allow the filtering steps to cache the state transition and noise covariance matrices until the revision changes.
+     * Derived classes changing F_ or Q_ after enabling the revision tracking must increment revision_.
+     */
+    void enableRevisionTracking();
+
+    void disableRevisionTracking();
+
+    /**
+     * Return false, the default, unless the revision tracking has been enabled.
+     */
+    std::pair<bool, std::size_t> getRevision() const override;
+
 protected:
     /*
      * State transition matrix.
@@ -37,6 +62,30 @@ protected:
      * Noise covariance matrix of zero mean additive white noise.
      */
     Eigen::MatrixXd Q_;
+
+    /*
+     * Maximum fraction of non-zero entries of F_ to provide it as a sparse matrix.
+     */
+    double max_sparse_density_;
+
+    /*
+     * Revision of F_ and Q_, to be incremented by derived classes changing them.
+     */
+    std::size_t revision_ = 0;
+
+    /*
+     * Whether the revision is reported to the filtering steps.
+     */
+    bool revision_tracking_ = false;
+
+    /*
+     * Sparse representation of F_, evaluated at revision sparse_revision_.
+     */
+    std::pair<bool, Eigen::SparseMatrix<double>> sparse_F_;
+
+    bool valid_sparse_F_ = false;
+
+    std::size_t sparse_revision_ = 0;
 };
 
 #endif /* LTISTATEMODEL_H */
@@ -16,6 +16,33 @@ public:
     virtual ~LikelihoodModel() noexcept { };
 
     virtual std::pair<bool, Eigen::VectorXd> likelihood(const MeasurementModel& measurement_model, const Eigen::Ref<const Eigen::MatrixXd>& pred_states) = 0;
+
+    /**
+     * Evaluate the logarithm of the likelihood.
+     * The default implementation takes the logarithm of likelihood(). Models that can
+     * evaluate it directly should override this method to avoid underflows.
+     */
+    virtual std::pair<bool, Eigen::VectorXd> logLikelihood(const MeasurementModel& measurement_model, const Eigen::Ref<const Eigen::MatrixXd>& pred_states);
+
+    /**
+     * Models that can evaluate the log-likelihood of blocks of states from multiple threads return true and split
+     * logLikelihood() in prepareLogLikelihood(), evaluating once the quantities shared by all the states,
+     * e.g. a factorization of the noise covariance matrix, and the const preparedLogLikelihood().
+     * The default implementation returns false.
+     */
+    virtual bool hasPreparedLogLikelihood() const;
+
+    /**
+     * Return false if the log-likelihood cannot be evaluated with the current measurement model.
+     * The default implementation returns true.
+     */
+    virtual bool prepareLogLikelihood(const MeasurementModel& measurement_model);
+
+    /**
+     * Evaluate the log-likelihood of the states after prepareLogLikelihood(). Safe to call concurrently.
+     * The default implementation returns false.
+     */
+    virtual std::pair<bool, Eigen::VectorXd> preparedLogLikelihood(const MeasurementModel& measurement_model, const Eigen::Ref<const Eigen::MatrixXd>& pred_states) const;
 };
 
 #endif /* LIKELIHOODMODEL_H */
@@ -4,6 +4,7 @@
 #include <BayesFilters/AdditiveMeasurementModel.h>
 
 #include <Eigen/Dense>
+#include <Eigen/SparseCore>
 
 namespace bfl {
     class LinearMeasurementModel;
@@ -17,9 +18,28 @@ public:
 
     virtual Eigen::MatrixXd getMeasurementMatrix() const = 0;
 
+    /**
+     * Return true and a sparse representation of the measurement matrix if it is sparse enough
+     * for the filtering steps to multiply by it as a sparse matrix, e.g. a selection matrix.
+     * Return false, the default, to use the dense measurement matrix.
+     */
+    virtual std::pair<bool, Eigen::SparseMatrix<double>> getSparseMeasurementMatrix() const;
+
     virtual std::pair<bool, bfl::Data> predictedMeasure(const Eigen::Ref<const Eigen::MatrixXd>& cur_states) const override;
 
+    /**
+     * Return the difference between the measurements and the predicted measurements, one per column.
+     * The measurements are either one column, compared with all the predicted measurements,
+     * or one column per predicted measurement, as used by BatchKalmanFilter.
+     */
     virtual std::pair<bool, bfl::Data> innovation(const bfl::Data& predicted_measurements, const bfl::Data& measurements) const override;
+
+    /**
+     * Return true and a revision number if the measurement matrix and the noise covariance matrix
+     * may be cached by the filtering steps as long as the revision number does not change.
+     * Return false, the default, if they have to be fetched at every step.
+     */
+    virtual std::pair<bool, std::size_t> getRevision() const;
 };
 
 #endif /* LINEARMEMEASUREMENTMODEL_H */
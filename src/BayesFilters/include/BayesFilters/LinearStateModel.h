@@ -2,6 +2,7 @@
 #define LINEARSTATEMODEL_H
 
 #include <Eigen/Dense>
+#include <Eigen/SparseCore>
 
 #include <BayesFilters/AdditiveStateModel.h>
 
@@ -18,6 +19,20 @@ public:
     virtual void propagate(const Eigen::Ref<const Eigen::MatrixXd>& cur_states, Eigen::Ref<Eigen::MatrixXd> mot_states) override;
 
     virtual Eigen::MatrixXd getStateTransitionMatrix() = 0;
+
+    /**
+     * Return true and a sparse representation of the state transition matrix if it is sparse enough
+     * for the filtering steps to multiply by it as a sparse matrix, e.g. a block diagonal matrix of
+     * many small blocks. Return false, the default, to use the dense state transition matrix.
+     */
+    virtual std::pair<bool, Eigen::SparseMatrix<double>> getSparseStateTransitionMatrix();
+
+    /**
+     * Return true and a revision number if the state transition matrix and the noise covariance matrix
+     * may be cached by the filtering steps as long as the revision number does not change.
+     * Return false, the default, if they have to be fetched at every step.
+     */
+    virtual std::pair<bool, std::size_t> getRevision() const;
 };
 
 #endif /* LINEARSTATEMODEL_H */
@@ -0,0 +1,55 @@
+#ifndef METROPOLISRESAMPLING_H
+#define METROPOLISRESAMPLING_H
+
+#include <BayesFilters/ParticleSet.h>
+#include <BayesFilters/Resampling.h>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class MetropolisResampling;
+}
+
+
+/**
+ * Metropolis resampling.
+ *
+ * The parent of each particle is drawn by running a Metropolis chain of num_iterations
+ * steps, starting from the particle itself, that proposes a uniformly drawn particle j
+ * and accepts it with probability w_j / w_k, k being the current state of the chain.
+ * Only ratios of weights are required, hence neither the cumulative sum nor the
+ * normalization of the weights is needed and particles are processed independently on
+ * num_threads threads.
+ *
+ * The result is biased for a finite number of iterations. The bias decreases as
+ * num_iterations increases, a few tens of iterations being usually enough.
+ *
+ * This class implements the algorithm:
+ * Murray, L. M., Lee, A., Jacob, P. E. (2016),
+ * 'Parallel Resampling in the Particle Filter.',
+ * Journal of Computational and Graphical Statistics, 25(3), 789-805
+ */
+class bfl::MetropolisResampling : public Resampling
+{
+public:
+    MetropolisResampling(const unsigned int num_iterations, const unsigned int num_threads, const unsigned int seed) noexcept;
+
+    MetropolisResampling(const unsigned int num_iterations, const unsigned int num_threads) noexcept;
+
+    MetropolisResampling(const unsigned int num_iterations) noexcept;
+
+    MetropolisResampling(MetropolisResampling&& resampling) noexcept;
+
+    virtual ~MetropolisResampling() noexcept;
+
+    MetropolisResampling& operator=(MetropolisResampling&& resampling) noexcept;
+
+    void resample(const bfl::ParticleSet& cor_particles, bfl::ParticleSet& res_particles, Eigen::Ref<Eigen::VectorXi> res_parents) override;
+
+protected:
+    unsigned int num_iterations_;
+
+    unsigned int num_threads_;
+};
+
+#endif /* METROPOLISRESAMPLING_H */
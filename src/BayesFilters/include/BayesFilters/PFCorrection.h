@@ -5,6 +5,7 @@
 #include <BayesFilters/MeasurementModel.h>
 #include <BayesFilters/ParticleSet.h>
 
+#include <functional>
 #include <memory>
 #include <utility>
 
@@ -30,6 +31,23 @@ public:
 
     virtual std::pair<bool, Eigen::VectorXd> getLikelihood() = 0;
 
+    /**
+     * Evaluate the likelihood of the particles on `num_threads` threads.
+     * If greater than one, the measurement and the likelihood models
+     * must be safe to call concurrently.
+     */
+    virtual void setNumberOfThreads(const std::size_t num_threads);
+
+    /**
+     * Split the particles in blocks of `block_size` columns when evaluating their likelihood.
+     * If zero, the particles are split in as many blocks as threads.
+     */
+    virtual void setBlockSize(const std::size_t block_size);
+
+    virtual std::size_t getNumberOfThreads() const;
+
+    virtual std::size_t getBlockSize() const;
+
 protected:
     /* FIXME
        There may no need for the folloiwng method to exist.
@@ -43,11 +61,27 @@ protected:
 
     virtual void correctStep(const bfl::ParticleSet& pred_particles, bfl::ParticleSet& cor_particles) = 0;
 
+    /**
+     * Evaluate the log-likelihood of the states using the likelihood and the measurement models.
+     * The states are processed in column blocks according to setNumberOfThreads() and setBlockSize().
+     */
+    std::pair<bool, Eigen::VectorXd> evaluateLogLikelihood(const Eigen::Ref<const Eigen::MatrixXd>& states);
+
+    /**
+     * Evaluate block_log_likelihood on the column blocks of the states, in parallel.
+     */
+    std::pair<bool, Eigen::VectorXd> evaluateBlocks(const Eigen::Ref<const Eigen::MatrixXd>& states, const std::size_t block_size,
+                                                    const std::function<std::pair<bool, Eigen::VectorXd>(const Eigen::Ref<const Eigen::MatrixXd>&)>& block_log_likelihood);
+
     PFCorrection() noexcept;
 
 private:
     bool skip_ = false;
 
+    std::size_t num_threads_ = 1;
+
+    std::size_t block_size_ = 0;
+
     friend class PFCorrectionDecorator;
 };
 
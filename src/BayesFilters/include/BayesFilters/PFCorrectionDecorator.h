@@ -20,6 +20,14 @@ public:
 
     std::pair<bool, Eigen::VectorXd> getLikelihood() override;
 
+    void setNumberOfThreads(const std::size_t num_threads) override;
+
+    void setBlockSize(const std::size_t block_size) override;
+
+    std::size_t getNumberOfThreads() const override;
+
+    std::size_t getBlockSize() const override;
+
 protected:
     PFCorrectionDecorator(std::unique_ptr<PFCorrection> correction) noexcept;
 
@@ -0,0 +1,52 @@
+#ifndef PARALLELSYSTEMATICRESAMPLING_H
+#define PARALLELSYSTEMATICRESAMPLING_H
+
+#include <BayesFilters/ParticleSet.h>
+#include <BayesFilters/Resampling.h>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class ParallelSystematicResampling;
+}
+
+
+/**
+ * Systematic resampling split across num_threads worker threads.
+ *
+ * The cumulative sum of the weights is evaluated with a parallel block-wise prefix sum,
+ * then each thread draws a contiguous range of particles, locating the parent of the
+ * first particle of its range with a binary search.
+ * Given the same seed, the resampled particles and parents are identical to those of Resampling.
+ */
+class bfl::ParallelSystematicResampling : public Resampling
+{
+public:
+    ParallelSystematicResampling(const unsigned int num_threads, const unsigned int seed) noexcept;
+
+    ParallelSystematicResampling(const unsigned int num_threads) noexcept;
+
+    ParallelSystematicResampling() noexcept;
+
+    ParallelSystematicResampling(ParallelSystematicResampling&& resampling) noexcept;
+
+    virtual ~ParallelSystematicResampling() noexcept;
+
+    ParallelSystematicResampling& operator=(ParallelSystematicResampling&& resampling) noexcept;
+
+    void resample(const bfl::ParticleSet& cor_particles, bfl::ParticleSet& res_particles, Eigen::Ref<Eigen::VectorXi> res_parents) override;
+
+    unsigned int getNumberOfThreads() const;
+
+protected:
+    unsigned int num_threads_;
+
+    /**
+     * Sum of the weights of each block and total of the preceding blocks.
+     */
+    Eigen::VectorXd block_sum_;
+
+    Eigen::VectorXd block_offset_;
+};
+
+#endif /* PARALLELSYSTEMATICRESAMPLING_H */
@@ -17,10 +17,23 @@ public:
 
     ParticleSet(const std::size_t components, const std::size_t dim_linear, const std::size_t dim_circular) noexcept;
 
+    /**
+     * If gaussian_belief is false, the particle set stores the state and the weight
+     * of the particles only, without allocating the mean and the covariance matrix
+     * of the Gaussian belief associated to each particle.
+     * This is the case of particle filters, e.g. a bootstrap filter, that never use them.
+     */
+    ParticleSet(const std::size_t components, const std::size_t dim_linear, const std::size_t dim_circular, const bool gaussian_belief) noexcept;
+
     virtual ~ParticleSet() noexcept;
 
     ParticleSet& operator+=(const ParticleSet& rhs);
 
+    /**
+     * Exchange the content of two particle sets without copying nor allocating memory.
+     */
+    void swap(ParticleSet& other) noexcept;
+
     Eigen::Ref<Eigen::MatrixXd> state();
 
     Eigen::Ref<Eigen::MatrixXd> state(const std::size_t i);
@@ -33,8 +46,16 @@ public:
 
     const double& state(const std::size_t i, const std::size_t j) const;
 
+    /**
+     * Return true if the mean and the covariance matrix of the Gaussian belief
+     * associated to each particle are stored.
+     */
+    bool hasGaussianBelief() const;
+
 protected:
     Eigen::MatrixXd state_;
+
+    bool gaussian_belief_;
 };
 
 bfl::ParticleSet operator+(bfl::ParticleSet lhs, const bfl::ParticleSet& rhs);
@@ -0,0 +1,55 @@
+#ifndef RECORDEDAGENT_H
+#define RECORDEDAGENT_H
+
+#include <BayesFilters/Agent.h>
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class RecordedAgent;
+}
+
+
+/**
+ * Agent replaying a recorded sequence of data, held in memory, one element per call to bufferData().
+ * Intended for measurement models fed with a dataset, e.g. when running a filter with ReplayRunner.
+ */
+class bfl::RecordedAgent : public Agent
+{
+public:
+    RecordedAgent(std::vector<Data> recording) noexcept;
+
+    /**
+     * Each column of recording, as an Eigen::MatrixXd, is an element of the sequence.
+     */
+    RecordedAgent(const Eigen::Ref<const Eigen::MatrixXd>& recording) noexcept;
+
+    virtual ~RecordedAgent() noexcept;
+
+    /**
+     * Return false once the whole sequence has been buffered.
+     */
+    bool bufferData() override;
+
+    Data getData() const override;
+
+    /**
+     * Property "reset" restarts the sequence from the beginning.
+     */
+    bool setProperty(const std::string& property) override;
+
+    std::size_t getLength() const;
+
+protected:
+    std::vector<Data> recording_;
+
+    /**
+     * Number of buffered elements, the current one being recording_[buffered_ - 1].
+     */
+    std::size_t buffered_ = 0;
+};
+
+#endif /* RECORDEDAGENT_H */
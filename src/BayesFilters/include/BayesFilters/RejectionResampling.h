@@ -0,0 +1,52 @@
+#ifndef REJECTIONRESAMPLING_H
+#define REJECTIONRESAMPLING_H
+
+#include <BayesFilters/ParticleSet.h>
+#include <BayesFilters/Resampling.h>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class RejectionResampling;
+}
+
+
+/**
+ * Rejection resampling.
+ *
+ * The parent of each particle is drawn by rejection sampling, starting from the particle
+ * itself and proposing uniformly drawn particles j until one is accepted with probability
+ * w_j / w_max. Only ratios of weights are required, hence neither the cumulative sum nor
+ * the normalization of the weights is needed and particles are processed independently
+ * on num_threads threads.
+ *
+ * Unlike MetropolisResampling the result is unbiased, but the number of proposals per
+ * particle is random, with mean N * w_max.
+ *
+ * This class implements the algorithm:
+ * Murray, L. M., Lee, A., Jacob, P. E. (2016),
+ * 'Parallel Resampling in the Particle Filter.',
+ * Journal of Computational and Graphical Statistics, 25(3), 789-805
+ */
+class bfl::RejectionResampling : public Resampling
+{
+public:
+    RejectionResampling(const unsigned int num_threads, const unsigned int seed) noexcept;
+
+    RejectionResampling(const unsigned int num_threads) noexcept;
+
+    RejectionResampling() noexcept;
+
+    RejectionResampling(RejectionResampling&& resampling) noexcept;
+
+    virtual ~RejectionResampling() noexcept;
+
+    RejectionResampling& operator=(RejectionResampling&& resampling) noexcept;
+
+    void resample(const bfl::ParticleSet& cor_particles, bfl::ParticleSet& res_particles, Eigen::Ref<Eigen::VectorXi> res_parents) override;
+
+protected:
+    unsigned int num_threads_;
+};
+
+#endif /* REJECTIONRESAMPLING_H */
@@ -0,0 +1,55 @@
+#ifndef REPLAYRUNNER_H
+#define REPLAYRUNNER_H
+
+#include <BayesFilters/FilteringAlgorithm.h>
+
+#include <cstddef>
+
+namespace bfl {
+    class ReplayRunner;
+}
+
+
+/**
+ * Run a FilteringAlgorithm offline, e.g. over a recorded dataset, as fast as possible.
+ *
+ * The filtering recursion runs on the calling thread: no thread is started and the synchronization of
+ * FilteringAlgorithm::run() and wait() is skipped altogether. As in the threaded recursion, the filter is initialized,
+ * then filtering steps are run while FilteringAlgorithm::runCondition() is true, re-initializing the filter
+ * after FilteringAlgorithm::reset() and stopping after FilteringAlgorithm::teardown().
+ * A teardown() issued before the replay is honored, hence a torn down filter is initialized but runs no step.
+ * The event-driven run mode is ignored, since all the measurements are available.
+ *
+ * The filter must not be booted, or it must have been waited for.
+ */
+class bfl::ReplayRunner
+{
+public:
+    struct Report
+    {
+        std::size_t steps = 0;
+
+        double seconds = 0.0;
+
+        double steps_per_second = 0.0;
+    };
+
+    ReplayRunner(FilteringAlgorithm& filter) noexcept;
+
+    virtual ~ReplayRunner() noexcept = default;
+
+    /**
+     * Run until FilteringAlgorithm::runCondition() returns false.
+     */
+    Report run();
+
+    /**
+     * Run at most max_steps filtering steps, e.g. the length of the recorded sequence.
+     */
+    Report run(const std::size_t max_steps);
+
+private:
+    FilteringAlgorithm& filter_;
+};
+
+#endif /* REPLAYRUNNER_H */
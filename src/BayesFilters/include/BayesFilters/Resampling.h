@@ -36,8 +36,63 @@ public:
 
     virtual double neff(const Eigen::Ref<const Eigen::VectorXd>& cor_weights);
 
-private:
+protected:
+    /**
+     * The cumulative sum of the weights is evaluated in blocks of cumsum_block_size_ particles.
+     * Each block is first scanned on its own, then the total of the preceding blocks is added to it.
+     * Since the partition does not depend on the number of threads, serial and parallel
+     * implementations evaluate exactly the same cumulative sum.
+     */
+    static const std::size_t cumsum_block_size_ = 4096;
+
+    std::size_t numberOfBlocks(const std::size_t num_particles) const;
+
+    /**
+     * Evaluate the cumulative sum of the exponentiated log weights block by block.
+     */
+    void cumulativeSum(const Eigen::Ref<const Eigen::VectorXd>& cor_weights, Eigen::Ref<Eigen::VectorXd> csw) const;
+
+    /**
+     * As cumulativeSum(), with the weights in the log domain if log_weights is true, in the linear domain otherwise.
+     */
+    void cumulativeSum(const Eigen::Ref<const Eigen::VectorXd>& cor_weights, Eigen::Ref<Eigen::VectorXd> csw, const bool log_weights) const;
+
+    /**
+     * Evaluate the cumulative sum of the exponentiated log weights of the block-th block
+     * and return the sum of its weights.
+     */
+    double blockCumulativeSum(const Eigen::Ref<const Eigen::VectorXd>& cor_weights, Eigen::Ref<Eigen::VectorXd> csw, const std::size_t block) const;
+
+    /**
+     * As blockCumulativeSum(), with the weights in the log domain if log_weights is true, in the linear domain otherwise.
+     */
+    double blockCumulativeSum(const Eigen::Ref<const Eigen::VectorXd>& cor_weights, Eigen::Ref<Eigen::VectorXd> csw, const std::size_t block, const bool log_weights) const;
+
+    /**
+     * Add offset to the cumulative sum of the block-th block.
+     */
+    void blockOffset(Eigen::Ref<Eigen::VectorXd> csw, const std::size_t block, const double offset) const;
+
+    /**
+     * Draw particles j in [begin, end) using the systematic scheme, i.e. u_j = u_1 + j / N,
+     * given the cumulative sum csw of the weights.
+     */
+    void systematicSelection(const bfl::ParticleSet& cor_particles, bfl::ParticleSet& res_particles, Eigen::Ref<Eigen::VectorXi> res_parents,
+                             const Eigen::Ref<const Eigen::VectorXd>& csw, const double u_1, const std::size_t begin, const std::size_t end) const;
+
+    /**
+     * Copy the parent-th particle of cor_particles in the j-th particle of res_particles
+     * and reset its weight to 1 / N.
+     */
+    void assignParent(const bfl::ParticleSet& cor_particles, bfl::ParticleSet& res_particles, Eigen::Ref<Eigen::VectorXi> res_parents,
+                      const std::size_t j, const int parent) const;
+
     std::mt19937_64 generator_;
+
+    /**
+     * Cumulative sum of the weights, reused across calls to avoid reallocations.
+     */
+    Eigen::VectorXd csw_;
 };
 
 #endif /* RESAMPLING_H */
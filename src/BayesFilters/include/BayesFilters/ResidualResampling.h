@@ -0,0 +1,43 @@
+#ifndef RESIDUALRESAMPLING_H
+#define RESIDUALRESAMPLING_H
+
+#include <BayesFilters/ParticleSet.h>
+#include <BayesFilters/Resampling.h>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class ResidualResampling;
+}
+
+
+/**
+ * Residual resampling.
+ *
+ * Each particle is first replicated floor(N * w_i) times, then the remaining
+ * R = N - sum_i floor(N * w_i) particles are drawn with systematic resampling
+ * from the residual weights (N * w_i - floor(N * w_i)) / R.
+ */
+class bfl::ResidualResampling : public Resampling
+{
+public:
+    ResidualResampling(const unsigned int seed) noexcept;
+
+    ResidualResampling() noexcept;
+
+    ResidualResampling(ResidualResampling&& resampling) noexcept;
+
+    virtual ~ResidualResampling() noexcept;
+
+    ResidualResampling& operator=(ResidualResampling&& resampling) noexcept;
+
+    void resample(const bfl::ParticleSet& cor_particles, bfl::ParticleSet& res_particles, Eigen::Ref<Eigen::VectorXi> res_parents) override;
+
+protected:
+    /**
+     * Expected number of copies of each particle, then its residual weight, reused across calls.
+     */
+    Eigen::VectorXd residual_weights_;
+};
+
+#endif /* RESIDUALRESAMPLING_H */
@@ -1,6 +1,7 @@
 #ifndef SIS_H
 #define SIS_H
 
+#include <BayesFilters/EstimatePublisher.h>
 #include <BayesFilters/ParticleFilter.h>
 #include <BayesFilters/ParticleSet.h>
 #include <BayesFilters/PFCorrection.h>
@@ -24,6 +25,13 @@ public:
 
     SIS(unsigned int num_particle, std::size_t state_size_linear, std::size_t state_size_circular, std::unique_ptr<ParticleSetInitialization> initialization, std::unique_ptr<PFPrediction> prediction, std::unique_ptr<PFCorrection> correction, std::unique_ptr<Resampling> resampling) noexcept;
 
+    /**
+     * If gaussian_belief is false, the particle sets of the filter do not store the mean and the
+     * covariance of the Gaussian belief associated to each particle (see ParticleSet).
+     * Use it for filters, e.g. a bootstrap filter, whose prediction and correction steps never use them.
+     */
+    SIS(unsigned int num_particle, std::size_t state_size_linear, std::size_t state_size_circular, std::unique_ptr<ParticleSetInitialization> initialization, std::unique_ptr<PFPrediction> prediction, std::unique_ptr<PFCorrection> correction, std::unique_ptr<Resampling> resampling, const bool gaussian_belief) noexcept;
+
     SIS(SIS&& sir_pf) noexcept;
 
     virtual ~SIS() noexcept;
@@ -34,6 +42,19 @@ public:
 
     bool runCondition() override;
 
+    /**
+     * Publish the weighted mean of the corrected particles at the end of each filtering step, together with
+     * the corrected particle set if full_belief is true. Other threads read the latest publication from
+     * getPublisher() without blocking the filter. To be called before boot().
+     * The published weights of the particle set are log-weights, as those of ParticleSet.
+     */
+    void enablePublication(const bool full_belief);
+
+    /**
+     * Throw if enablePublication() has not been called.
+     */
+    const EstimatePublisher& getPublisher() const;
+
 protected:
     unsigned int num_particle_;
 
@@ -43,6 +64,27 @@ protected:
 
     ParticleSet cor_particle_;
 
+    /**
+     * Resampling buffers, allocated once and swapped with cor_particle_
+     * whenever resampling takes place.
+     */
+    ParticleSet res_particle_;
+
+    Eigen::VectorXi res_parent_;
+
+    std::unique_ptr<EstimatePublisher> publisher_;
+
+    bool publish_belief_ = false;
+
+    /**
+     * Buffers of the published estimate.
+     */
+    Eigen::VectorXd publication_weight_;
+
+    Eigen::VectorXd publication_estimate_;
+
+    void publish();
+
     void filteringStep() override;
 
     std::vector<std::string> log_filenames(const std::string& prefix_path, const std::string& prefix_name) override
@@ -0,0 +1,85 @@
+#ifndef SRUKFCORRECTION_H
+#define SRUKFCORRECTION_H
+
+#include <BayesFilters/AdditiveMeasurementModel.h>
+#include <BayesFilters/GaussianCorrection.h>
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/sigma_point.h>
+#include <BayesFilters/SquareRootCovariance.h>
+
+#include <memory>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class SRUKFCorrection;
+}
+
+/**
+ * Correction step of the square-root unscented Kalman filter.
+ * The Kalman gain is evaluated using triangular solves with the square root of the
+ * covariance matrix of the predicted measurement and the square root of the covariance
+ * matrix of the state is updated using rank-one downdates.
+ *
+ * R. Van der Merwe, E. A. Wan, "The square-root unscented Kalman filter for state and parameter-estimation",
+ * 2001 IEEE International Conference on Acoustics, Speech, and Signal Processing.
+ */
+class bfl::SRUKFCorrection : public bfl::GaussianCorrection
+{
+public:
+    SRUKFCorrection(std::unique_ptr<bfl::AdditiveMeasurementModel> meas_model, const size_t n, const double alpha, const double beta, const double kappa) noexcept;
+
+    SRUKFCorrection(std::unique_ptr<bfl::AdditiveMeasurementModel> meas_model, const bfl::sigma_point::UTWeight& ut_weight) noexcept;
+
+    /**
+     * Share `square_root` with a SRUKFPrediction, such that each step uses the
+     * square roots evaluated by the other one.
+     */
+    SRUKFCorrection(std::unique_ptr<bfl::AdditiveMeasurementModel> meas_model, const bfl::sigma_point::UTWeight& ut_weight, std::shared_ptr<bfl::SquareRootCovariance> square_root) noexcept;
+
+    SRUKFCorrection(SRUKFCorrection&& srukf_correction) noexcept;
+
+    virtual ~SRUKFCorrection() noexcept;
+
+    MeasurementModel& getMeasurementModel() override;
+
+protected:
+    void correctStep(const bfl::GaussianMixture& pred_state, bfl::GaussianMixture& corr_state) override;
+
+    std::pair<bool, Eigen::VectorXd> likelihood(const Eigen::Ref<const Eigen::MatrixXd>& innovations) override;
+
+    std::unique_ptr<bfl::AdditiveMeasurementModel> measurement_model_;
+
+    /**
+     * Unscented transform weight.
+     */
+    bfl::sigma_point::UTWeight ut_weight_;
+
+    /**
+     * Unscented transform workspace, reused across steps.
+     */
+    bfl::sigma_point::UTWorkspace ut_workspace_;
+
+    std::shared_ptr<bfl::SquareRootCovariance> square_root_;
+
+    /**
+     * Noise covariance matrix of the measurement model and its square root.
+     */
+    Eigen::MatrixXd noise_covariance_;
+
+    Eigen::MatrixXd sqrt_noise_;
+
+    /**
+     * Predicted measurements, the square root of their covariance matrix,
+     * the cross covariance matrix and the Kalman gain, reused across steps.
+     */
+    Eigen::MatrixXd predicted_measurement_;
+
+    Eigen::MatrixXd sqrt_meas_covariance_;
+
+    Eigen::MatrixXd cross_covariance_;
+
+    Eigen::MatrixXd gain_;
+};
+
+#endif /* SRUKFCORRECTION_H */
@@ -0,0 +1,72 @@
+#ifndef SRUKFPREDICTION_H
+#define SRUKFPREDICTION_H
+
+#include <BayesFilters/AdditiveStateModel.h>
+#include <BayesFilters/ExogenousModel.h>
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/GaussianPrediction.h>
+#include <BayesFilters/sigma_point.h>
+#include <BayesFilters/SquareRootCovariance.h>
+
+#include <memory>
+
+namespace bfl {
+    class SRUKFPrediction;
+}
+
+/**
+ * Prediction step of the square-root unscented Kalman filter.
+ * The square roots of the covariance matrices are propagated using a QR decomposition
+ * of the weighted sigma points and rank-one downdates, instead of decomposing
+ * the covariance matrices at every step.
+ *
+ * R. Van der Merwe, E. A. Wan, "The square-root unscented Kalman filter for state and parameter-estimation",
+ * 2001 IEEE International Conference on Acoustics, Speech, and Signal Processing.
+ */
+class bfl::SRUKFPrediction : public bfl::GaussianPrediction
+{
+public:
+    SRUKFPrediction(std::unique_ptr<bfl::AdditiveStateModel> state_model, const size_t n, const double alpha, const double beta, const double kappa) noexcept;
+
+    SRUKFPrediction(std::unique_ptr<bfl::AdditiveStateModel> state_model, const bfl::sigma_point::UTWeight& ut_weight) noexcept;
+
+    /**
+     * Share `square_root` with a SRUKFCorrection, such that each step uses the
+     * square roots evaluated by the other one.
+     */
+    SRUKFPrediction(std::unique_ptr<bfl::AdditiveStateModel> state_model, const bfl::sigma_point::UTWeight& ut_weight, std::shared_ptr<bfl::SquareRootCovariance> square_root) noexcept;
+
+    SRUKFPrediction(SRUKFPrediction&& srukf_prediction) noexcept;
+
+    virtual ~SRUKFPrediction() noexcept;
+
+    void setExogenousModel(std::unique_ptr<bfl::ExogenousModel> exog_model);
+
+protected:
+    void predictStep(const bfl::GaussianMixture& prev_state, bfl::GaussianMixture& pred_state) override;
+
+    std::unique_ptr<bfl::AdditiveStateModel> state_model_;
+
+    std::unique_ptr<bfl::ExogenousModel> exog_model_;
+
+    /**
+     * Unscented transform weight.
+     */
+    bfl::sigma_point::UTWeight ut_weight_;
+
+    /**
+     * Unscented transform workspace, reused across steps.
+     */
+    bfl::sigma_point::UTWorkspace ut_workspace_;
+
+    std::shared_ptr<bfl::SquareRootCovariance> square_root_;
+
+    /**
+     * Noise covariance matrix of the state model and its square root.
+     */
+    Eigen::MatrixXd noise_covariance_;
+
+    Eigen::MatrixXd sqrt_noise_;
+};
+
+#endif /* SRUKFPREDICTION_H */
@@ -40,6 +40,13 @@ public:
      */
     SUKFCorrection(std::unique_ptr<AdditiveMeasurementModel> measurement_model, const std::size_t state_size, const double alpha, const double beta, const double kappa, const std::size_t measurement_sub_size, const bool use_reduced_noise_covariance_matrix) noexcept;
 
+    /**
+     * The contributions of the sub-vectors of the measurement are accumulated in partial sums over chunks
+     * of contiguous sub-vectors, split among num_threads threads, see utils::parallel_for().
+     * The partial sums are reduced in a fixed order, hence the correction does not depend on num_threads.
+     */
+    SUKFCorrection(std::unique_ptr<AdditiveMeasurementModel> measurement_model, const std::size_t state_size, const double alpha, const double beta, const double kappa, const std::size_t measurement_sub_size, const bool use_reduced_noise_covariance_matrix, const unsigned int num_threads) noexcept;
+
     SUKFCorrection(SUKFCorrection&& sukf_correction) noexcept;
 
     virtual ~SUKFCorrection() noexcept { };
@@ -53,6 +60,13 @@ protected:
 
     Eigen::MatrixXd getNoiseCovarianceMatrix(const std::size_t index);
 
+    /**
+     * Fetch the noise covariance matrix from the measurement model and evaluate the Cholesky factors
+     * of its diagonal blocks, unless it did not change since the last step.
+     * Return false if a block is not positive definite.
+     */
+    bool updateNoiseFactors(const std::size_t meas_size);
+
 private:
     std::unique_ptr<MeasurementModel> measurement_model_;
 
@@ -64,6 +78,30 @@ private:
     std::size_t measurement_sub_size_;
 
     bool use_reduced_noise_covariance_matrix_;
+
+    unsigned int num_threads_;
+
+    /**
+     * Noise covariance matrix of the last step, and lower Cholesky factors of its diagonal blocks,
+     * one per sub-vector of the measurement or a single one if use_reduced_noise_covariance_matrix_ is true,
+     * stored side by side.
+     */
+    Eigen::MatrixXd noise_covariance_;
+
+    Eigen::MatrixXd noise_factors_;
+
+    bool valid_noise_factors_ = false;
+
+    /**
+     * Matrix C^{-1} and vector d of the current component, and their partial sums, one per chunk of sub-vectors, stored side by side.
+     */
+    Eigen::MatrixXd C_inv_;
+
+    Eigen::VectorXd d_;
+
+    Eigen::MatrixXd partial_C_inv_;
+
+    Eigen::MatrixXd partial_d_;
 };
 
 #endif /* SUKFCORRECTION_H */
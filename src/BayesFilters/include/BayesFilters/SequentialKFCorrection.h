@@ -0,0 +1,75 @@
+#ifndef SEQUENTIALKFCORRECTION_H
+#define SEQUENTIALKFCORRECTION_H
+
+#include <BayesFilters/KFCorrection.h>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Dense>
+
+#include <vector>
+
+namespace bfl {
+    class SequentialKFCorrection;
+}
+
+/**
+ * Kalman correction step processing the measurement one block at a time.
+ *
+ * If the noise covariance matrix R is block diagonal, the Kalman correction can be applied sequentially to
+ * each block of the measurement, with its block of rows of the measurement matrix and its block of R.
+ * For a diagonal R, the measurement is processed one scalar at a time, avoiding the decomposition of the
+ * m x m covariance matrix of the predicted measurement in favour of m rank-one updates of the n x n
+ * covariance matrix of the state, i.e. O(m * n^2) operations instead of O(m^3 + m^2 * n + m * n^2).
+ * This pays off when the size m of the measurement is larger than the size n of the state.
+ *
+ * The blocks are either detected from the non-zero entries of R, whenever the model matrices are fetched,
+ * or given to the constructor. If R has a single block, KFCorrection is used.
+ */
+class bfl::SequentialKFCorrection : public bfl::KFCorrection
+{
+public:
+    SequentialKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model) noexcept;
+
+    /**
+     * Use the given sizes of the diagonal blocks of the noise covariance matrix instead of detecting them.
+     * The entries of the noise covariance matrix outside these blocks are neglected.
+     */
+    SequentialKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model, const std::vector<std::size_t>& block_sizes) noexcept;
+
+    SequentialKFCorrection(SequentialKFCorrection&& kf_correction) noexcept;
+
+    virtual ~SequentialKFCorrection() noexcept;
+
+protected:
+    void correctComponents(const GaussianMixture& pred_state, const Eigen::Ref<const Eigen::MatrixXd>& innovations, GaussianMixture& corr_state) override;
+
+    /**
+     * Detect the diagonal blocks of the noise covariance matrix R_, or check the ones given to the constructor.
+     */
+    void updateBlocks();
+
+    bool detect_blocks_;
+
+    /**
+     * First row and size of the diagonal blocks of the noise covariance matrix.
+     */
+    std::vector<std::pair<std::size_t, std::size_t>> blocks_;
+
+    bool valid_blocks_ = false;
+
+    std::size_t blocks_revision_ = 0;
+
+    /**
+     * Buffers reused across blocks: Px * H_b', the covariance matrix of the predicted measurement
+     * of the block with its Cholesky decomposition, and the innovation of the block.
+     */
+    Eigen::MatrixXd PxHt_b_;
+
+    Eigen::MatrixXd Py_b_;
+
+    Eigen::LLT<Eigen::MatrixXd> Py_b_llt_;
+
+    Eigen::VectorXd innovation_b_;
+};
+
+#endif /* SEQUENTIALKFCORRECTION_H */
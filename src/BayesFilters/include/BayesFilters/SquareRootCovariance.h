@@ -0,0 +1,79 @@
+#ifndef SQUAREROOTCOVARIANCE_H
+#define SQUAREROOTCOVARIANCE_H
+
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/sigma_point.h>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class SquareRootCovariance;
+}
+
+/**
+ * Lower triangular square roots of the covariance matrices of a GaussianMixture.
+ * A SRUKFPrediction and a SRUKFCorrection sharing the same instance hand over the
+ * square roots to each other, so that the covariance matrices of the state are not
+ * decomposed at every step.
+ */
+class bfl::SquareRootCovariance
+{
+public:
+    SquareRootCovariance() noexcept;
+
+    virtual ~SquareRootCovariance() noexcept;
+
+    /**
+     * Make factor(i) a lower triangular square root of state.covariance(i) for all the components.
+     * If `state` has the covariance matrices set by the last call to assign(), the stored
+     * square roots are used as they are and true is returned.
+     * Otherwise, the covariance matrices are decomposed and false is returned.
+     */
+    bool factorize(const GaussianMixture& state);
+
+    /**
+     * Resize the square roots for a mixture of `components` components of size `dim`.
+     * The content is preserved only if the sizes do not change.
+     */
+    void resize(const std::size_t components, const std::size_t dim);
+
+    /**
+     * Set the covariance matrices of `state` to factor(i) * factor(i)' and
+     * remember them for the next call to factorize().
+     */
+    void assign(GaussianMixture& state);
+
+    /**
+     * Forget the stored square roots.
+     */
+    void reset();
+
+    Eigen::Ref<Eigen::MatrixXd> factor();
+
+    Eigen::Ref<Eigen::MatrixXd> factor(const std::size_t i);
+
+    const Eigen::Ref<const Eigen::MatrixXd> factor() const;
+
+    const Eigen::Ref<const Eigen::MatrixXd> factor(const std::size_t i) const;
+
+protected:
+    std::size_t components_ = 0;
+
+    std::size_t dim_ = 0;
+
+    /**
+     * One dim x dim square root per component, side by side.
+     */
+    Eigen::MatrixXd factor_;
+
+    /**
+     * Covariance matrices set by assign().
+     */
+    Eigen::MatrixXd covariance_;
+
+    bool valid_ = false;
+
+    bfl::sigma_point::UTWorkspace workspace_;
+};
+
+#endif /* SQUAREROOTCOVARIANCE_H */
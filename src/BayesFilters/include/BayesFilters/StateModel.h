@@ -21,6 +21,13 @@ public:
 
     virtual Eigen::VectorXd getTransitionProbability(const Eigen::Ref<const Eigen::MatrixXd>& prev_states, Eigen::Ref<Eigen::MatrixXd> cur_states);
 
+    /**
+     * Evaluate the logarithm of the transition probability.
+     * The default implementation takes the logarithm of getTransitionProbability(). Models
+     * that can evaluate it directly should override this method to avoid underflows.
+     */
+    virtual Eigen::VectorXd getLogTransitionProbability(const Eigen::Ref<const Eigen::MatrixXd>& prev_states, Eigen::Ref<Eigen::MatrixXd> cur_states);
+
     virtual Eigen::MatrixXd getNoiseCovarianceMatrix();
 
     virtual Eigen::MatrixXd getNoiseSample(const std::size_t num);
@@ -19,6 +19,10 @@ public:
 
     bool setProperty(const std::string& property) override;
 
+    Eigen::VectorXd getTransitionProbability(const Eigen::Ref<const Eigen::MatrixXd>& prev_states, Eigen::Ref<Eigen::MatrixXd> cur_states) override;
+
+    Eigen::VectorXd getLogTransitionProbability(const Eigen::Ref<const Eigen::MatrixXd>& prev_states, Eigen::Ref<Eigen::MatrixXd> cur_states) override;
+
     Eigen::MatrixXd getNoiseCovarianceMatrix() override;
 
     Eigen::MatrixXd getNoiseSample(const std::size_t num) override;
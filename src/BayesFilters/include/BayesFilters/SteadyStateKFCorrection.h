@@ -0,0 +1,77 @@
+#ifndef STEADYSTATEKFCORRECTION_H
+#define STEADYSTATEKFCORRECTION_H
+
+#include <BayesFilters/KFCorrection.h>
+
+#include <Eigen/Dense>
+
+#include <vector>
+
+namespace bfl {
+    class SteadyStateKFCorrection;
+}
+
+/**
+ * Kalman correction step that stops updating the covariance matrices once they converge.
+ *
+ * This class runs the recursion of KFCorrection until the relative change of the corrected covariance
+ * matrices between two steps is below a tolerance. Then, the Kalman gains and the corrected covariance
+ * matrices are frozen and, as long as the covariance matrices of the predicted state stay within the
+ * tolerance from the converged ones, only the means are corrected, with O(n * m) operations per component,
+ * and the converged corrected covariance matrices are copied to the corrected state.
+ * The comparison and the copy still read O(n^2) entries per component, but the O(n^2 * m + m^3)
+ * evaluation of the Kalman gains and of the covariance update is skipped.
+ * The full recursion is resumed if the measurement model reports a new revision,
+ * see LinearMeasurementModel::getRevision(), or if the covariance matrices of the predicted state change.
+ * Use together with SteadyStateKFPrediction.
+ */
+class bfl::SteadyStateKFCorrection : public bfl::KFCorrection
+{
+public:
+    SteadyStateKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model) noexcept;
+
+    SteadyStateKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model, const double tolerance) noexcept;
+
+    SteadyStateKFCorrection(SteadyStateKFCorrection&& kf_correction) noexcept;
+
+    virtual ~SteadyStateKFCorrection() noexcept;
+
+    /**
+     * Return true if the last step used the converged Kalman gains and covariance matrices.
+     */
+    bool isSteadyState() const;
+
+protected:
+    void correctComponents(const GaussianMixture& pred_state, const Eigen::Ref<const Eigen::MatrixXd>& innovations, GaussianMixture& corr_state) override;
+
+    /**
+     * Relative tolerance on the change of the covariance matrices.
+     */
+    double tolerance_;
+
+    bool converged_ = false;
+
+    bool steady_state_ = false;
+
+    std::size_t frozen_revision_ = 0;
+
+    /**
+     * Covariance matrices of the predicted and of the corrected state at convergence,
+     * or of the last step of the full recursion.
+     */
+    Eigen::MatrixXd pred_covariance_;
+
+    Eigen::MatrixXd corr_covariance_;
+
+    /**
+     * Frobenius norm of pred_covariance_, evaluated once per step of the full recursion.
+     */
+    double pred_covariance_norm_ = 0.0;
+
+    /**
+     * Kalman gains of the components at convergence.
+     */
+    std::vector<Eigen::MatrixXd> gains_;
+};
+
+#endif /* STEADYSTATEKFCORRECTION_H */
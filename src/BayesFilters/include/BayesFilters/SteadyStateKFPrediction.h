@@ -0,0 +1,73 @@
+#ifndef STEADYSTATEKFPREDICTION_H
+#define STEADYSTATEKFPREDICTION_H
+
+#include <BayesFilters/KFPrediction.h>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class SteadyStateKFPrediction;
+}
+
+/**
+ * Kalman prediction step that stops propagating the covariance matrices once they converge.
+ *
+ * With a time invariant state model and a time invariant measurement model, the covariance
+ * recursion of the Kalman filter converges to the solution of the discrete algebraic Riccati equation.
+ * This class runs the recursion of KFPrediction until the relative change of the predicted covariance
+ * matrices between two steps is below a tolerance. Then, as long as the covariance matrices of the
+ * previous state stay within the tolerance from the converged ones, only the means are propagated
+ * and the converged predicted covariance matrices are copied to the predicted state.
+ * The comparison and the copy still read O(n^2) entries per component, but the O(n^3) products of the
+ * covariance propagation are skipped.
+ * The full recursion is resumed if the state model reports a new revision, see
+ * LinearStateModel::getRevision(), or if the covariance matrices of the previous state change.
+ * Use together with SteadyStateKFCorrection.
+ */
+class bfl::SteadyStateKFPrediction : public bfl::KFPrediction
+{
+public:
+    SteadyStateKFPrediction(std::unique_ptr<LinearStateModel> state_model) noexcept;
+
+    SteadyStateKFPrediction(std::unique_ptr<LinearStateModel> state_model, const double tolerance) noexcept;
+
+    SteadyStateKFPrediction(std::unique_ptr<LinearStateModel> state_model, std::unique_ptr<ExogenousModel> exogenous_model, const double tolerance) noexcept;
+
+    SteadyStateKFPrediction(SteadyStateKFPrediction&& kf_prediction) noexcept;
+
+    virtual ~SteadyStateKFPrediction() noexcept;
+
+    /**
+     * Return true if the last step used the converged covariance matrices.
+     */
+    bool isSteadyState() const;
+
+protected:
+    void predictStep(const GaussianMixture& prev_state, GaussianMixture& pred_state) override;
+
+    /**
+     * Relative tolerance on the change of the covariance matrices.
+     */
+    double tolerance_;
+
+    bool converged_ = false;
+
+    bool steady_state_ = false;
+
+    std::size_t model_revision_ = 0;
+
+    /**
+     * Covariance matrices of the previous and of the predicted state at convergence,
+     * or of the last step of the full recursion.
+     */
+    Eigen::MatrixXd prev_covariance_;
+
+    Eigen::MatrixXd pred_covariance_;
+
+    /**
+     * Frobenius norm of prev_covariance_, evaluated once per step of the full recursion.
+     */
+    double prev_covariance_norm_ = 0.0;
+};
+
+#endif /* STEADYSTATEKFPREDICTION_H */
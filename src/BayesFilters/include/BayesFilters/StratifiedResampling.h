@@ -0,0 +1,37 @@
+#ifndef STRATIFIEDRESAMPLING_H
+#define STRATIFIEDRESAMPLING_H
+
+#include <BayesFilters/ParticleSet.h>
+#include <BayesFilters/Resampling.h>
+
+#include <Eigen/Dense>
+
+namespace bfl {
+    class StratifiedResampling;
+}
+
+
+/**
+ * Stratified resampling.
+ *
+ * The interval [0, 1) is divided in N strata of size 1 / N and a uniform
+ * random number is drawn independently within each stratum,
+ * i.e. u_j = (j + U_j) / N with U_j ~ U[0, 1).
+ */
+class bfl::StratifiedResampling : public Resampling
+{
+public:
+    StratifiedResampling(const unsigned int seed) noexcept;
+
+    StratifiedResampling() noexcept;
+
+    StratifiedResampling(StratifiedResampling&& resampling) noexcept;
+
+    virtual ~StratifiedResampling() noexcept;
+
+    StratifiedResampling& operator=(StratifiedResampling&& resampling) noexcept;
+
+    void resample(const bfl::ParticleSet& cor_particles, bfl::ParticleSet& res_particles, Eigen::Ref<Eigen::VectorXi> res_parents) override;
+};
+
+#endif /* STRATIFIEDRESAMPLING_H */
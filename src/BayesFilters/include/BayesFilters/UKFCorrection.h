@@ -21,6 +21,13 @@ public:
 
     UKFCorrection(std::unique_ptr<bfl::AdditiveMeasurementModel> meas_model, const size_t n, const double alpha, const double beta, const double kappa) noexcept;
 
+    /**
+     * Use the sigma points and the weights in `ut_weight`, e.g. of a reduced set of sigma points.
+     */
+    UKFCorrection(std::unique_ptr<bfl::MeasurementModel> meas_model, const bfl::sigma_point::UTWeight& ut_weight) noexcept;
+
+    UKFCorrection(std::unique_ptr<bfl::AdditiveMeasurementModel> meas_model, const bfl::sigma_point::UTWeight& ut_weight) noexcept;
+
     UKFCorrection(UKFCorrection&& ukf_prediction) noexcept;
 
     virtual ~UKFCorrection() noexcept;
@@ -48,6 +55,29 @@ protected:
      * Unscented transform weight.
      */
     bfl::sigma_point::UTWeight ut_weight_;
+
+    /**
+     * Unscented transform workspace, reused across steps.
+     */
+    bfl::sigma_point::UTWorkspace ut_workspace_;
+
+    /**
+     * Buffers of the correction, reused across steps.
+     */
+    Eigen::MatrixXd noise_covariance_matrix_;
+
+    bfl::Data predicted_measurement_;
+
+    Eigen::LLT<Eigen::MatrixXd> Py_llt_;
+
+    Eigen::LDLT<Eigen::MatrixXd> Py_ldlt_;
+
+    /**
+     * L^{-1} * Pxy', or the transpose of the Kalman gain if Py is not positive definite.
+     */
+    Eigen::MatrixXd W_;
+
+    Eigen::VectorXd gain_innovation_;
 };
 
 #endif /* UKFCORRECTION_H */
@@ -22,6 +22,13 @@ public:
 
     UKFPrediction(std::unique_ptr<bfl::AdditiveStateModel> state_model, const size_t n, const double alpha, const double beta, const double kappa) noexcept;
 
+    /**
+     * Use the sigma points and the weights in `ut_weight`, e.g. of a reduced set of sigma points.
+     */
+    UKFPrediction(std::unique_ptr<bfl::StateModel> state_model, const bfl::sigma_point::UTWeight& ut_weight) noexcept;
+
+    UKFPrediction(std::unique_ptr<bfl::AdditiveStateModel> state_model, const bfl::sigma_point::UTWeight& ut_weight) noexcept;
+
     UKFPrediction(UKFPrediction&& ukf_prediction) noexcept;
 
     virtual ~UKFPrediction() noexcept;
@@ -49,6 +56,11 @@ protected:
      * Unscented transform weight.
      */
     bfl::sigma_point::UTWeight ut_weight_;
+
+    /**
+     * Unscented transform workspace, reused across steps.
+     */
+    bfl::sigma_point::UTWorkspace ut_workspace_;
 };
 
 #endif /* UKFPREDICTION_H */
@@ -36,7 +36,13 @@ public:
 
     Eigen::MatrixXd getStateTransitionMatrix() override;
 
-    Eigen::VectorXd getTransitionProbability(const Eigen::Ref<const Eigen::MatrixXd>& prev_states, Eigen::Ref<Eigen::MatrixXd> cur_states);
+    Eigen::VectorXd getTransitionProbability(const Eigen::Ref<const Eigen::MatrixXd>& prev_states, Eigen::Ref<Eigen::MatrixXd> cur_states) override;
+
+    /**
+     * Evaluate the logarithm of the transition probability of all the states at once,
+     * using the cached inverse of the noise covariance matrix.
+     */
+    Eigen::VectorXd getLogTransitionProbability(const Eigen::Ref<const Eigen::MatrixXd>& prev_states, Eigen::Ref<Eigen::MatrixXd> cur_states) override;
 
     bool setProperty(const std::string& property) override { return false; };
 
@@ -73,6 +79,19 @@ protected:
      */
     Eigen::Matrix4d sqrt_Q_;
 
+    /**
+     * Inverse of Q_ and logarithm of the normalization constant of the transition density,
+     * cached to evaluate the transition probability.
+     */
+    Eigen::Matrix4d inv_Q_;
+
+    double log_normalizer_;
+
+    /**
+     * Differences between the current and the previous states, reused across calls to getLogTransitionProbability().
+     */
+    Eigen::MatrixXd state_differences_;
+
     /**
      * Random number generator function from a Normal distribution.
      * A call to `gauss_rnd_sample_()` returns a double-precision floating point random number.
@@ -15,6 +15,19 @@ namespace directional_statistics
 
     Eigen::VectorXd directional_mean(const Eigen::Ref<const Eigen::MatrixXd>& a, const Eigen::Ref<const Eigen::VectorXd>& w);
 
+    /**
+     * As directional_add() and directional_sub(), storing the result in `result`,
+     * which may be the matrix `a` itself, without allocating memory.
+     */
+    void directional_add(const Eigen::Ref<const Eigen::MatrixXd>& a, const Eigen::Ref<const Eigen::VectorXd>& b, Eigen::Ref<Eigen::MatrixXd> result);
+
+    void directional_sub(const Eigen::Ref<const Eigen::MatrixXd>& a, const Eigen::Ref<const Eigen::VectorXd>& b, Eigen::Ref<Eigen::MatrixXd> result);
+
+    /**
+     * As directional_mean(), storing the result in `result` without allocating memory.
+     */
+    void directional_mean(const Eigen::Ref<const Eigen::MatrixXd>& a, const Eigen::Ref<const Eigen::VectorXd>& w, Eigen::Ref<Eigen::VectorXd> result);
+
 }
 }
 
@@ -10,8 +10,11 @@
 #include <BayesFilters/StateModel.h>
 
 #include <functional>
+#include <vector>
 
+#include <Eigen/Cholesky>
 #include <Eigen/Dense>
+#include <Eigen/QR>
 
 
 namespace bfl
@@ -27,22 +30,180 @@ namespace sigma_point
     using OutputSize = std::pair<std::size_t, std::size_t>;
     using FunctionEvaluation = std::function<std::tuple<bool, bfl::Data, OutputSize>(const Eigen::Ref<const Eigen::MatrixXd>&)>;
     
+    /**
+     * Sets of sigma points:
+     * - Symmetric, the 2n + 1 points of the scaled unscented transform;
+     * - SphericalSimplex, the n + 2 points of the spherical simplex unscented transform;
+     * - Cubature, the 2n points of the third-degree spherical-radial cubature rule.
+     *
+     * S. J. Julier, "The spherical simplex unscented transformation", Proceedings of the 2003 American Control Conference.
+     * I. Arasaratnam and S. Haykin, "Cubature Kalman Filters", IEEE Transactions on Automatic Control, 2009.
+     */
+    enum class SigmaPointSet { Symmetric, SphericalSimplex, Cubature };
+
     struct UTWeight
     {
         Eigen::VectorXd mean;
         Eigen::VectorXd covariance;
         /**
-         * c = sqrt(n + lambda) with lambda a ut parameter.
+         * c = n + lambda with lambda a ut parameter.
+         * The Symmetric and Cubature sets place the sigma points at mean +/- sqrt(c) times the columns
+         * of a square root of the covariance matrix.
          */
         double c; 
 
+        SigmaPointSet point_set;
+
+        /**
+         * Sigma points of a standard normal distribution, one per column.
+         * The sigma points of a Gaussian having mean m and covariance matrix A * A' are m + A * points.
+         */
+        Eigen::MatrixXd points;
+
         UTWeight(std::size_t n, const double alpha, const double beta, const double kappa);
+
+        /**
+         * Weights of the set `point_set` for a state of size n.
+         * The weight of the center point w0 is used by the Symmetric and SphericalSimplex sets,
+         * the Cubature set has no center point.
+         */
+        UTWeight(const SigmaPointSet point_set, const std::size_t n, const double w0);
     };
 
     void unscented_weights(const std::size_t n, const double alpha, const double beta, const double kappa, Eigen::Ref<Eigen::VectorXd> weight_mean, Eigen::Ref<Eigen::VectorXd> weight_covariance, double& c);
 
+    /**
+     * Weights and standard normal sigma points of the spherical simplex set having center weight w0 in [0, 1).
+     */
+    void spherical_simplex_weights(const std::size_t n, const double w0, Eigen::Ref<Eigen::VectorXd> weight_mean, Eigen::Ref<Eigen::VectorXd> weight_covariance, Eigen::Ref<Eigen::MatrixXd> points);
+
+    /**
+     * Weights of the third-degree cubature rule.
+     */
+    void cubature_weights(const std::size_t n, Eigen::Ref<Eigen::VectorXd> weight_mean, Eigen::Ref<Eigen::VectorXd> weight_covariance, double& c);
+
+    /**
+     * Decomposition used to evaluate the square root of a covariance matrix.
+     */
+    enum class SquareRootMethod { LLT, LDLT, SVD };
+
+    /**
+     * Evaluate a matrix A such that A * A' = covariance.
+     * The Cholesky decomposition is tried first. If the matrix is not numerically positive definite,
+     * the LDL' decomposition is used if the matrix is positive semidefinite, the SVD otherwise.
+     * Return the decomposition that has been used.
+     */
+    SquareRootMethod square_root(const Eigen::Ref<const Eigen::MatrixXd>& covariance, Eigen::Ref<Eigen::MatrixXd> sqrt_covariance);
+
     Eigen::MatrixXd sigma_point(const GaussianMixture& state, const double c);
 
+    /**
+     * As sigma_point(state, c), also storing in `methods` the decomposition used
+     * to evaluate the square root of the covariance matrix of each component.
+     */
+    Eigen::MatrixXd sigma_point(const GaussianMixture& state, const double c, std::vector<SquareRootMethod>& methods);
+
+    /**
+     * Sigma points of the set described by `weight`.
+     */
+    Eigen::MatrixXd sigma_point(const GaussianMixture& state, const UTWeight& weight);
+
+    /**
+     * Buffers used by the unscented transform. They are resized only if the size of
+     * the input or of the output changes, hence reusing the same workspace across calls
+     * avoids heap allocations within the transform. The models may still allocate.
+     */
+    struct UTWorkspace
+    {
+        /**
+         * The input augmented with noise by augment_with_noise().
+         */
+        GaussianMixture augmented_input;
+
+        Eigen::MatrixXd input_sigma_points;
+
+        Eigen::MatrixXd prop_sigma_points;
+
+        /**
+         * Sigma points propagated through a state model before an exogenous model.
+         */
+        Eigen::MatrixXd tmp_sigma_points;
+
+        /**
+         * Sigma points scaled by the covariance weights.
+         */
+        Eigen::MatrixXd weighted_sigma_points;
+
+        Eigen::MatrixXd sqrt_covariance;
+
+        Eigen::LLT<Eigen::MatrixXd> llt;
+
+        Eigen::LDLT<Eigen::MatrixXd> ldlt;
+
+        /**
+         * Matrix triangularized by triangular_square_root() and its QR decomposition.
+         */
+        Eigen::MatrixXd compound;
+
+        Eigen::HouseholderQR<Eigen::MatrixXd> qr;
+
+        /**
+         * Vector used by the rank-one downdates of triangular_square_root().
+         */
+        Eigen::VectorXd update_vector;
+
+        /**
+         * Decomposition used for the square root of the covariance matrix of each component.
+         */
+        std::vector<SquareRootMethod> methods;
+
+        /**
+         * Output of the transform.
+         */
+        GaussianMixture output;
+
+        /**
+         * Input-output cross covariance matrices of the transform.
+         */
+        Eigen::MatrixXd cross_covariance;
+    };
+
+    /**
+     * Evaluate in workspace.input_sigma_points the sigma points of the set described by `weight`
+     * using the given square roots of the covariance matrices of `state`, one per component side by side.
+     * No decomposition of the covariance matrices is evaluated.
+     */
+    void sigma_point(const GaussianMixture& state, const Eigen::Ref<const Eigen::MatrixXd>& sqrt_covariance, const UTWeight& weight, UTWorkspace& workspace);
+
+    /**
+     * Update the lower triangular matrix `sqrt_covariance`, having positive diagonal, such that
+     * sqrt_covariance * sqrt_covariance' is increased by sigma * vector * vector'.
+     * The content of `vector` is overwritten.
+     * Return false if the downdate, i.e. sigma < 0, results in a matrix that is not positive definite.
+     * In that case `sqrt_covariance` is left in an unspecified state.
+     */
+    bool cholesky_update(Eigen::Ref<Eigen::MatrixXd> sqrt_covariance, Eigen::Ref<Eigen::VectorXd> vector, const double sigma);
+
+    /**
+     * Evaluate a lower triangular matrix S, having non-negative diagonal, such that
+     * S * S' = deviations * diag(weights) * deviations' + sqrt_noise * sqrt_noise'.
+     * The deviations having non-negative weight and sqrt_noise are triangularized using a QR decomposition,
+     * the deviations having negative weight are then removed using rank-one downdates.
+     * If a downdate fails, S is evaluated from the whole matrix as in square_root().
+     * The matrix `sqrt_noise` may have no columns.
+     * Return false if the whole matrix has been used.
+     *
+     * R. Van der Merwe, E. A. Wan, "The square-root unscented Kalman filter for state and parameter-estimation",
+     * 2001 IEEE International Conference on Acoustics, Speech, and Signal Processing.
+     */
+    bool triangular_square_root(const Eigen::Ref<const Eigen::MatrixXd>& deviations, const Eigen::Ref<const Eigen::VectorXd>& weights, const Eigen::Ref<const Eigen::MatrixXd>& sqrt_noise, Eigen::Ref<Eigen::MatrixXd> sqrt_covariance, UTWorkspace& workspace);
+
+    /**
+     * Store in workspace.augmented_input the state augmented with a zero mean noise
+     * having covariance matrix `noise_covariance_matrix`, as in GaussianMixture::augmentWithNoise().
+     */
+    const GaussianMixture& augment_with_noise(const GaussianMixture& state, const Eigen::Ref<const Eigen::MatrixXd>& noise_covariance_matrix, UTWorkspace& workspace);
+
     std::tuple<bool, GaussianMixture, Eigen::MatrixXd> unscented_transform(const GaussianMixture& input, const UTWeight& weight, FunctionEvaluation function);
 
     std::pair<GaussianMixture, Eigen::MatrixXd> unscented_transform(const GaussianMixture& state, const UTWeight& weight, StateModel& state_model);
@@ -58,6 +219,24 @@ namespace sigma_point
     std::tuple<bool, GaussianMixture, Eigen::MatrixXd> unscented_transform(const GaussianMixture& state, const UTWeight& weight, MeasurementModel& meas_model);
 
     std::tuple<bool, GaussianMixture, Eigen::MatrixXd> unscented_transform(const GaussianMixture& state, const UTWeight& weight, AdditiveMeasurementModel& meas_model);
+
+    /**
+     * The following overloads store the output of the transform in workspace.output
+     * and the cross covariance matrix in workspace.cross_covariance.
+     */
+    void unscented_transform(const GaussianMixture& state, const UTWeight& weight, StateModel& state_model, UTWorkspace& workspace);
+
+    void unscented_transform(const GaussianMixture& state, const UTWeight& weight, StateModel& state_model, ExogenousModel& exogenous_model, UTWorkspace& workspace);
+
+    void unscented_transform(const GaussianMixture& state, const UTWeight& weight, AdditiveStateModel& state_model, UTWorkspace& workspace);
+
+    void unscented_transform(const GaussianMixture& state, const UTWeight& weight, AdditiveStateModel& state_model, ExogenousModel& exogenous_model, UTWorkspace& workspace);
+
+    void unscented_transform(const GaussianMixture& state, const UTWeight& weight, ExogenousModel& exogenous_model, UTWorkspace& workspace);
+
+    bool unscented_transform(const GaussianMixture& state, const UTWeight& weight, MeasurementModel& meas_model, UTWorkspace& workspace);
+
+    bool unscented_transform(const GaussianMixture& state, const UTWeight& weight, AdditiveMeasurementModel& meas_model, UTWorkspace& workspace);
 }
 }
 
@@ -14,7 +14,9 @@
 #define UTILS_H
 
 #include <Eigen/Dense>
+#include <Eigen/SparseCore>
 
+#include <functional>
 #include <memory>
 
 namespace bfl
@@ -54,6 +56,30 @@ std::unique_ptr<T> make_unique(Args&& ...args)
  */
 double log_sum_exp(const Eigen::Ref<const Eigen::VectorXd>& arguments);
 
+
+/**
+ * Split the range [0, size) in num_threads contiguous chunks and call
+ * body(begin, end) on each of them from a different thread.
+ * The chunks but the last one are queued to a pool of hardware_concurrency() - 1 threads,
+ * started once and shared by all the calls, such that no thread is created per call.
+ * The last chunk is processed by the calling thread, which returns once all
+ * the chunks have been processed. Calls from the threads of the pool process the chunks serially.
+ */
+void parallel_for(const std::size_t num_threads, const std::size_t size, const std::function<void(const std::size_t, const std::size_t)>& body);
+
+
+/**
+ * Default maximum fraction of non-zero entries of a model matrix to be used as a sparse matrix.
+ */
+constexpr double default_max_sparse_density = 0.1;
+
+
+/**
+ * Return true and a sparse copy of the matrix if the fraction of its non-zero entries
+ * does not exceed max_density, false and an empty sparse matrix otherwise.
+ */
+std::pair<bool, Eigen::SparseMatrix<double>> sparse_view(const Eigen::Ref<const Eigen::MatrixXd>& matrix, const double max_density);
+
 }
 }
 
@@ -0,0 +1,476 @@
+#include <BayesFilters/BatchKalmanFilter.h>
+#include <BayesFilters/utils.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+BatchKalmanFilter::BatchKalmanFilter
+(
+    std::unique_ptr<LinearStateModel> state_model,
+    std::unique_ptr<LinearMeasurementModel> measurement_model,
+    const std::size_t targets
+) noexcept :
+    BatchKalmanFilter(std::move(state_model), std::move(measurement_model), targets, 1)
+{ }
+
+
+BatchKalmanFilter::BatchKalmanFilter
+(
+    std::unique_ptr<LinearStateModel> state_model,
+    std::unique_ptr<LinearMeasurementModel> measurement_model,
+    const std::size_t targets,
+    const unsigned int num_threads
+) noexcept :
+    state_model_(std::move(state_model)),
+    measurement_model_(std::move(measurement_model)),
+    targets_(targets),
+    num_threads_(std::max(num_threads, 1u))
+{
+    std::size_t linear_size;
+    std::size_t circular_size;
+
+    std::tie(linear_size, circular_size) = state_model_->getOutputSize();
+    state_size_ = linear_size + circular_size;
+
+    std::tie(linear_size, circular_size) = measurement_model_->getOutputSize();
+    meas_size_ = linear_size + circular_size;
+
+    /* Zero means and identity covariance matrices. */
+    mean_ = MatrixXd::Zero(targets_, state_size_);
+    covariance_ = MatrixXd::Zero(targets_, state_size_ * state_size_);
+    for (std::size_t i = 0; i < state_size_; i++)
+        covariance_.col(i + state_size_ * i).setOnes();
+
+    mean_buffer_.resize(targets_, state_size_);
+    covariance_buffer_.resize(targets_, state_size_ * state_size_);
+    innovations_.resize(targets_, meas_size_);
+    HP_.resize(targets_, meas_size_ * state_size_);
+    S_.resize(targets_, meas_size_ * meas_size_);
+    pivots_.resize(targets_);
+    fallback_ = Array<bool, Dynamic, 1>::Constant(targets_, false);
+}
+
+
+BatchKalmanFilter::BatchKalmanFilter(BatchKalmanFilter&& batch_kf) noexcept :
+    state_model_(std::move(batch_kf.state_model_)),
+    measurement_model_(std::move(batch_kf.measurement_model_)),
+    targets_(batch_kf.targets_),
+    num_threads_(batch_kf.num_threads_),
+    state_size_(batch_kf.state_size_),
+    meas_size_(batch_kf.meas_size_),
+    skip_prediction_(batch_kf.skip_prediction_),
+    skip_correction_(batch_kf.skip_correction_),
+    mean_(std::move(batch_kf.mean_)),
+    covariance_(std::move(batch_kf.covariance_)),
+    Ft_(std::move(batch_kf.Ft_)),
+    FF_t_(std::move(batch_kf.FF_t_)),
+    Q_vec_(std::move(batch_kf.Q_vec_)),
+    valid_state_model_matrices_(batch_kf.valid_state_model_matrices_),
+    state_model_revision_(batch_kf.state_model_revision_),
+    Ht_(std::move(batch_kf.Ht_)),
+    IH_t_(std::move(batch_kf.IH_t_)),
+    HH_t_(std::move(batch_kf.HH_t_)),
+    R_vec_(std::move(batch_kf.R_vec_)),
+    valid_measurement_model_matrices_(batch_kf.valid_measurement_model_matrices_),
+    measurement_model_revision_(batch_kf.measurement_model_revision_),
+    model_innovations_(std::move(batch_kf.model_innovations_)),
+    mean_buffer_(std::move(batch_kf.mean_buffer_)),
+    covariance_buffer_(std::move(batch_kf.covariance_buffer_)),
+    innovations_(std::move(batch_kf.innovations_)),
+    HP_(std::move(batch_kf.HP_)),
+    S_(std::move(batch_kf.S_)),
+    pivots_(std::move(batch_kf.pivots_)),
+    fallback_(std::move(batch_kf.fallback_))
+{
+    batch_kf.targets_ = 0;
+    batch_kf.valid_state_model_matrices_ = false;
+    batch_kf.valid_measurement_model_matrices_ = false;
+}
+
+
+BatchKalmanFilter::~BatchKalmanFilter() noexcept
+{ }
+
+
+void BatchKalmanFilter::setState(const std::size_t target, const Ref<const VectorXd>& mean, const Ref<const MatrixXd>& covariance)
+{
+    if ((mean.size() != static_cast<Index>(state_size_)) || (covariance.rows() != static_cast<Index>(state_size_)) || (covariance.cols() != static_cast<Index>(state_size_)))
+        throw std::runtime_error("ERROR::BATCHKALMANFILTER::SETSTATE\nERROR:\n\tWrong size of the mean or of the covariance matrix.");
+
+    mean_.row(target) = mean.transpose();
+    covariance_.row(target) = Map<const RowVectorXd>(MatrixXd(covariance).data(), state_size_ * state_size_);
+}
+
+
+VectorXd BatchKalmanFilter::getMean(const std::size_t target) const
+{
+    return mean_.row(target).transpose();
+}
+
+
+MatrixXd BatchKalmanFilter::getCovariance(const std::size_t target) const
+{
+    MatrixXd covariance(state_size_, state_size_);
+    Map<RowVectorXd>(covariance.data(), state_size_ * state_size_) = covariance_.row(target);
+
+    return covariance;
+}
+
+
+const MatrixXd& BatchKalmanFilter::means() const
+{
+    return mean_;
+}
+
+
+const MatrixXd& BatchKalmanFilter::covariances() const
+{
+    return covariance_;
+}
+
+
+std::size_t BatchKalmanFilter::getNumberOfTargets() const
+{
+    return targets_;
+}
+
+
+unsigned int BatchKalmanFilter::getNumberOfThreads() const
+{
+    return num_threads_;
+}
+
+
+void BatchKalmanFilter::predict()
+{
+    updateStateModelMatrices();
+
+    utils::parallel_for(num_threads_, targets_,
+                        [this](const std::size_t begin, const std::size_t end) { predictRange(begin, end - begin); });
+
+    std::swap(mean_, mean_buffer_);
+    std::swap(covariance_, covariance_buffer_);
+}
+
+
+bool BatchKalmanFilter::correct(const Ref<const MatrixXd>& measurements)
+{
+    if ((measurements.rows() != static_cast<Index>(meas_size_)) || (measurements.cols() != static_cast<Index>(targets_)))
+        throw std::runtime_error("ERROR::BATCHKALMANFILTER::CORRECT\nERROR:\n\tThe measurements must be a matrix with one column per target.");
+
+    if (!updateMeasurementModelMatrices())
+        return false;
+
+    /* Evaluate the innovations of all the targets through the measurement model, e.g. to wrap angles. */
+    bool valid_innovation;
+    Data innovation;
+    std::tie(valid_innovation, innovation) = measurement_model_->innovation(MatrixXd(Ht_.transpose() * mean_.transpose()), MatrixXd(measurements));
+
+    if (!valid_innovation)
+        return false;
+
+    model_innovations_ = any::any_cast<MatrixXd&&>(std::move(innovation));
+
+    if ((model_innovations_.rows() != static_cast<Index>(meas_size_)) || (model_innovations_.cols() != static_cast<Index>(targets_)))
+        throw std::runtime_error("ERROR::BATCHKALMANFILTER::CORRECT\nERROR:\n\tThe innovations must be a matrix with one column per target.");
+
+    utils::parallel_for(num_threads_, targets_,
+                        [this](const std::size_t begin, const std::size_t end) { correctRange(begin, end - begin); });
+
+    /* Targets whose S is not positive definite have been left unchanged by correctRange(). */
+    bool corrected = true;
+    if (fallback_.any())
+    {
+        for (std::size_t j = 0; j < targets_; j++)
+        {
+            if (fallback_(j))
+                corrected &= correctTarget(j);
+        }
+    }
+
+    return corrected;
+}
+
+
+bool BatchKalmanFilter::correct()
+{
+    bool valid_measurement;
+    Data measurement;
+    std::tie(valid_measurement, measurement) = measurement_model_->measure();
+
+    if (!valid_measurement)
+        return false;
+
+    return correct(any::any_cast<MatrixXd&&>(std::move(measurement)));
+}
+
+
+bool BatchKalmanFilter::skip(const std::string& what_step, const bool status)
+{
+    if (what_step == "prediction")
+        skip_prediction_ = status;
+    else if (what_step == "correction")
+        skip_correction_ = status;
+    else if (what_step == "all")
+    {
+        skip_prediction_ = status;
+        skip_correction_ = status;
+    }
+    else
+        return false;
+
+    return true;
+}
+
+
+bool BatchKalmanFilter::initialization()
+{
+    return true;
+}
+
+
+void BatchKalmanFilter::filteringStep()
+{
+    if (!skip_prediction_)
+    {
+        BFL_STATISTICS_SCOPE(Prediction);
+        predict();
+    }
+
+    if (!skip_correction_ && measurement_model_->freezeMeasurements())
+    {
+        BFL_STATISTICS_SCOPE(Correction);
+        correct();
+    }
+
+    {
+        BFL_STATISTICS_SCOPE(Logging);
+        log();
+    }
+}
+
+
+bool BatchKalmanFilter::runCondition()
+{
+    return true;
+}
+
+
+void BatchKalmanFilter::updateStateModelMatrices()
+{
+    bool cacheable;
+    std::size_t revision;
+    std::tie(cacheable, revision) = state_model_->getRevision();
+
+    if (cacheable && valid_state_model_matrices_ && (revision == state_model_revision_))
+        return;
+
+    const MatrixXd F = state_model_->getStateTransitionMatrix();
+    const MatrixXd Q = state_model_->getNoiseCovarianceMatrix();
+
+    if ((F.rows() != static_cast<Index>(state_size_)) || (F.cols() != static_cast<Index>(state_size_)) || (Q.rows() != static_cast<Index>(state_size_)) || (Q.cols() != static_cast<Index>(state_size_)))
+        throw std::runtime_error("ERROR::BATCHKALMANFILTER::UPDATESTATEMODELMATRICES\nERROR:\n\tThe size of the model matrices does not match the output size of the state model.");
+
+    const std::size_t n = state_size_;
+
+    Ft_ = F.transpose();
+
+    /* vec(F * P * F')(a + n * b) = sum_{c, d} F(a, c) * F(b, d) * vec(P)(c + n * d) */
+    FF_t_.resize(n * n, n * n);
+    for (std::size_t b = 0; b < n; b++)
+        for (std::size_t a = 0; a < n; a++)
+            for (std::size_t d = 0; d < n; d++)
+                for (std::size_t c = 0; c < n; c++)
+                    FF_t_(c + n * d, a + n * b) = F(a, c) * F(b, d);
+
+    Q_vec_ = Map<const RowVectorXd>(Q.data(), n * n);
+
+    valid_state_model_matrices_ = cacheable;
+    state_model_revision_ = revision;
+}
+
+
+bool BatchKalmanFilter::updateMeasurementModelMatrices()
+{
+    bool cacheable;
+    std::size_t revision;
+    std::tie(cacheable, revision) = measurement_model_->getRevision();
+
+    if (cacheable && valid_measurement_model_matrices_ && (revision == measurement_model_revision_))
+        return true;
+
+    bool valid_covariance_matrix;
+    MatrixXd R;
+    std::tie(valid_covariance_matrix, R) = measurement_model_->getNoiseCovarianceMatrix();
+
+    if (!valid_covariance_matrix)
+    {
+        valid_measurement_model_matrices_ = false;
+        return false;
+    }
+
+    const MatrixXd H = measurement_model_->getMeasurementMatrix();
+
+    if ((H.rows() != static_cast<Index>(meas_size_)) || (H.cols() != static_cast<Index>(state_size_)) || (R.rows() != static_cast<Index>(meas_size_)) || (R.cols() != static_cast<Index>(meas_size_)))
+        throw std::runtime_error("ERROR::BATCHKALMANFILTER::UPDATEMEASUREMENTMODELMATRICES\nERROR:\n\tThe size of the model matrices does not match the output sizes of the models.");
+
+    const std::size_t n = state_size_;
+    const std::size_t m = meas_size_;
+
+    Ht_ = H.transpose();
+
+    /* vec(H * P)(i + m * a) = sum_{c} H(i, c) * vec(P)(c + n * a) */
+    IH_t_ = MatrixXd::Zero(n * n, m * n);
+    for (std::size_t a = 0; a < n; a++)
+        for (std::size_t i = 0; i < m; i++)
+            for (std::size_t c = 0; c < n; c++)
+                IH_t_(c + n * a, i + m * a) = H(i, c);
+
+    /* vec(H * P * H')(i + m * j) = sum_{c, d} H(i, c) * H(j, d) * vec(P)(c + n * d) */
+    HH_t_.resize(n * n, m * m);
+    for (std::size_t j = 0; j < m; j++)
+        for (std::size_t i = 0; i < m; i++)
+            for (std::size_t d = 0; d < n; d++)
+                for (std::size_t c = 0; c < n; c++)
+                    HH_t_(c + n * d, i + m * j) = H(i, c) * H(j, d);
+
+    R_vec_ = Map<const RowVectorXd>(R.data(), m * m);
+
+    valid_measurement_model_matrices_ = cacheable;
+    measurement_model_revision_ = revision;
+
+    return true;
+}
+
+
+void BatchKalmanFilter::predictRange(const std::size_t begin, const std::size_t size)
+{
+    /* x_{k+1} = F * x_{k} */
+    mean_buffer_.middleRows(begin, size).noalias() = mean_.middleRows(begin, size) * Ft_;
+
+    /* P_{k+1} = F * P_{k} * F' + Q */
+    covariance_buffer_.middleRows(begin, size).noalias() = covariance_.middleRows(begin, size) * FF_t_;
+    covariance_buffer_.middleRows(begin, size).rowwise() += Q_vec_;
+}
+
+
+void BatchKalmanFilter::correctRange(const std::size_t begin, const std::size_t size)
+{
+    const std::size_t n = state_size_;
+    const std::size_t m = meas_size_;
+
+    /* Entry of all the targets in the range. */
+    auto entry = [begin, size](MatrixXd& matrix, const std::size_t index) { return matrix.col(index).segment(begin, size).array(); };
+
+    /* Innovations, H * P and S = H * P * H' + R. */
+    innovations_.middleRows(begin, size) = model_innovations_.middleCols(begin, size).transpose();
+
+    HP_.middleRows(begin, size).noalias() = covariance_.middleRows(begin, size) * IH_t_;
+
+    S_.middleRows(begin, size).noalias() = covariance_.middleRows(begin, size) * HH_t_;
+    S_.middleRows(begin, size).rowwise() += R_vec_;
+
+    /* Cholesky decomposition S = L * L', in place in the lower triangle of S.
+       A pivot not larger than the diagonal entry of S times m * epsilon marks S as not positive definite,
+       the pivot is replaced by 1 to keep the factors finite and the target is left to correctTarget(). */
+    auto fallback = fallback_.segment(begin, size);
+    auto S_jj = pivots_.segment(begin, size);
+    fallback.setConstant(false);
+
+    for (std::size_t j = 0; j < m; j++)
+    {
+        auto L_jj = entry(S_, j + m * j);
+        S_jj = L_jj;
+        for (std::size_t k = 0; k < j; k++)
+            L_jj -= entry(S_, j + m * k).square();
+
+        fallback = fallback || (L_jj <= S_jj.abs() * (m * NumTraits<double>::epsilon())) || L_jj.isNaN();
+        L_jj = fallback.select(1.0, L_jj.max(0.0).sqrt());
+
+        for (std::size_t i = j + 1; i < m; i++)
+        {
+            auto L_ij = entry(S_, i + m * j);
+            for (std::size_t k = 0; k < j; k++)
+                L_ij -= entry(S_, i + m * k) * entry(S_, j + m * k);
+            L_ij /= L_jj;
+        }
+    }
+
+    /* Forward substitutions W = L^{-1} * H * P and w = L^{-1} * (y - H * x), in place. */
+    for (std::size_t i = 0; i < m; i++)
+    {
+        auto L_ii = entry(S_, i + m * i);
+
+        auto w_i = entry(innovations_, i);
+        for (std::size_t k = 0; k < i; k++)
+            w_i -= entry(S_, i + m * k) * entry(innovations_, k);
+        w_i /= L_ii;
+
+        for (std::size_t a = 0; a < n; a++)
+        {
+            auto W_ia = entry(HP_, i + m * a);
+            for (std::size_t k = 0; k < i; k++)
+                W_ia -= entry(S_, i + m * k) * entry(HP_, k + m * a);
+            W_ia /= L_ii;
+        }
+    }
+
+    /* Leave unchanged the targets to be corrected by correctTarget(). */
+    if (fallback.any())
+    {
+        for (std::size_t i = 0; i < m; i++)
+            entry(innovations_, i) = fallback.select(0.0, entry(innovations_, i));
+
+        for (std::size_t i = 0; i < m * n; i++)
+            entry(HP_, i) = fallback.select(0.0, entry(HP_, i));
+    }
+
+    /* x = x + K * (y - H * x) = x + W' * w
+       P = P - K * S * K' = P - W' * W, evaluated on the lower triangle and mirrored in the upper one. */
+    for (std::size_t a = 0; a < n; a++)
+    {
+        auto x_a = entry(mean_, a);
+        for (std::size_t i = 0; i < m; i++)
+            x_a += entry(HP_, i + m * a) * entry(innovations_, i);
+
+        for (std::size_t b = 0; b <= a; b++)
+        {
+            auto P_ab = entry(covariance_, a + n * b);
+            for (std::size_t i = 0; i < m; i++)
+                P_ab -= entry(HP_, i + m * a) * entry(HP_, i + m * b);
+
+            if (a != b)
+                entry(covariance_, b + n * a) = P_ab;
+        }
+    }
+}
+
+
+bool BatchKalmanFilter::correctTarget(const std::size_t target)
+{
+    const std::size_t n = state_size_;
+    const std::size_t m = meas_size_;
+
+    const MatrixXd P = getCovariance(target);
+    const MatrixXd HP = Ht_.transpose() * P;
+
+    MatrixXd S = HP * Ht_;
+    S += Map<const MatrixXd>(R_vec_.data(), m, m);
+
+    if (!S.allFinite())
+        return false;
+
+    /* The LDL' decomposition solves with the pseudo-inverse of a singular S. */
+    LDLT<MatrixXd> S_ldlt(S);
+
+    if ((S_ldlt.info() != Success) || !S_ldlt.isPositive())
+        return false;
+
+    mean_.row(target) += (HP.transpose() * S_ldlt.solve(model_innovations_.col(target))).transpose();
+
+    const MatrixXd corr_covariance = P - HP.transpose() * S_ldlt.solve(HP);
+    covariance_.row(target) = Map<const RowVectorXd>(corr_covariance.data(), n * n);
+
+    return true;
+}
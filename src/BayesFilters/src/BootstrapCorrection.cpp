@@ -15,18 +15,30 @@ BoostrapCorrection::~BoostrapCorrection() noexcept { }
 
 void BoostrapCorrection::correctStep(const ParticleSet& pred_particles, ParticleSet& cor_particles)
 {
-    std::tie(valid_likelihood_, likelihood_) = likelihood_model_->likelihood(*measurement_model_, pred_particles.state());
+    std::tie(valid_likelihood_, log_likelihood_) = evaluateLogLikelihood(pred_particles.state());
 
-    cor_particles = pred_particles;
+    /* The bootstrap correction only updates the weights. The Gaussian belief
+       associated to each particle is copied only if both sets store it. */
+    cor_particles.state() = pred_particles.state();
+    cor_particles.weight() = pred_particles.weight();
+
+    if (pred_particles.hasGaussianBelief() && cor_particles.hasGaussianBelief())
+    {
+        cor_particles.mean() = pred_particles.mean();
+        cor_particles.covariance() = pred_particles.covariance();
+    }
 
     if (valid_likelihood_)
-        cor_particles.weight() += (likelihood_.array() + std::numeric_limits<double>::min()).log().matrix();
+        cor_particles.weight() += log_likelihood_;
 }
 
 
 std::pair<bool, VectorXd> BoostrapCorrection::getLikelihood()
 {
-    return std::make_pair(valid_likelihood_, likelihood_);
+    if (!valid_likelihood_)
+        return std::make_pair(false, VectorXd::Zero(1));
+
+    return std::make_pair(true, log_likelihood_.array().exp().matrix());
 }
 
 
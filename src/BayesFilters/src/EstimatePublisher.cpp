@@ -0,0 +1,189 @@
+#include <BayesFilters/EstimatePublisher.h>
+
+#include <stdexcept>
+#include <string>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+namespace
+{
+    std::pair<std::size_t, std::size_t> sizes_of(const Ref<const MatrixXd>& matrix)
+    {
+        return std::make_pair(static_cast<std::size_t>(matrix.rows()), static_cast<std::size_t>(matrix.cols()));
+    }
+}
+
+
+EstimatePublisher::EstimatePublisher(const std::size_t estimate_size) noexcept :
+    EstimatePublisher({{{estimate_size, 1}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}})
+{ }
+
+
+EstimatePublisher::EstimatePublisher(const std::size_t estimate_size, const GaussianMixture& belief) noexcept :
+    EstimatePublisher({{{estimate_size, 1}, {0, 0}, sizes_of(belief.weight()), sizes_of(belief.mean()), sizes_of(belief.covariance())}})
+{ }
+
+
+EstimatePublisher::EstimatePublisher(const std::size_t estimate_size, const ParticleSet& belief) noexcept :
+    EstimatePublisher({{{estimate_size, 1}, sizes_of(belief.state()), sizes_of(belief.weight()), sizes_of(belief.mean()), sizes_of(belief.covariance())}})
+{ }
+
+
+EstimatePublisher::EstimatePublisher(const std::array<std::pair<std::size_t, std::size_t>, number_of_blocks>& sizes) noexcept :
+    sizes_(sizes)
+{
+    offsets_[0] = 0;
+    for (std::size_t i = 0; i < number_of_blocks; i++)
+        offsets_[i + 1] = offsets_[i] + sizes_[i].first * sizes_[i].second;
+
+    for (Slot& slot : slots_)
+    {
+        slot.data.reset(new std::atomic<double>[offsets_[number_of_blocks]]);
+
+        for (std::size_t i = 0; i < offsets_[number_of_blocks]; i++)
+            slot.data[i].store(0.0, std::memory_order_relaxed);
+    }
+}
+
+
+void EstimatePublisher::publish(const std::size_t step, const Ref<const VectorXd>& estimate)
+{
+    checkBlock(estimate_block, estimate);
+
+    Slot& slot = beginWrite(step);
+    writeBlock(slot, estimate_block, estimate);
+    endWrite(slot);
+}
+
+
+void EstimatePublisher::publish(const std::size_t step, const Ref<const VectorXd>& estimate, const GaussianMixture& belief)
+{
+    checkBlock(estimate_block, estimate);
+    checkBlock(weight_block, belief.weight());
+    checkBlock(mean_block, belief.mean());
+    checkBlock(covariance_block, belief.covariance());
+
+    Slot& slot = beginWrite(step);
+    writeBlock(slot, estimate_block, estimate);
+    writeBlock(slot, weight_block, belief.weight());
+    writeBlock(slot, mean_block, belief.mean());
+    writeBlock(slot, covariance_block, belief.covariance());
+    endWrite(slot);
+}
+
+
+void EstimatePublisher::publish(const std::size_t step, const Ref<const VectorXd>& estimate, const ParticleSet& belief)
+{
+    checkBlock(estimate_block, estimate);
+    checkBlock(state_block, belief.state());
+    checkBlock(weight_block, belief.weight());
+    checkBlock(mean_block, belief.mean());
+    checkBlock(covariance_block, belief.covariance());
+
+    Slot& slot = beginWrite(step);
+    writeBlock(slot, estimate_block, estimate);
+    writeBlock(slot, state_block, belief.state());
+    writeBlock(slot, weight_block, belief.weight());
+    writeBlock(slot, mean_block, belief.mean());
+    writeBlock(slot, covariance_block, belief.covariance());
+    endWrite(slot);
+}
+
+
+bool EstimatePublisher::read(Snapshot& snapshot) const
+{
+    snapshot.estimate.resize(sizes_[estimate_block].first);
+    snapshot.state.resize(sizes_[state_block].first, sizes_[state_block].second);
+    snapshot.weight.resize(sizes_[weight_block].first);
+    snapshot.mean.resize(sizes_[mean_block].first, sizes_[mean_block].second);
+    snapshot.covariance.resize(sizes_[covariance_block].first, sizes_[covariance_block].second);
+
+    double* const destinations[number_of_blocks] = {snapshot.estimate.data(), snapshot.state.data(), snapshot.weight.data(), snapshot.mean.data(), snapshot.covariance.data()};
+
+    while (true)
+    {
+        const std::size_t publications = publications_.load(std::memory_order_acquire);
+        if (publications == 0)
+            return false;
+
+        const Slot& slot = slots_[publications % 2];
+
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence % 2 == 1)
+            continue;
+
+        const std::size_t step = slot.step.load(std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < number_of_blocks; i++)
+        {
+            for (std::size_t j = offsets_[i]; j < offsets_[i + 1]; j++)
+                destinations[i][j - offsets_[i]] = slot.data[j].load(std::memory_order_relaxed);
+        }
+
+        /* The copy is consistent only if the slot has not been written in the meantime. */
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            snapshot.step = step;
+            return true;
+        }
+    }
+}
+
+
+std::pair<bool, EstimatePublisher::Snapshot> EstimatePublisher::read() const
+{
+    Snapshot snapshot;
+    const bool valid = read(snapshot);
+
+    return std::make_pair(valid, std::move(snapshot));
+}
+
+
+std::size_t EstimatePublisher::getPublications() const
+{
+    return publications_.load(std::memory_order_acquire);
+}
+
+
+void EstimatePublisher::checkBlock(const Block block, const Ref<const MatrixXd>& matrix) const
+{
+    if (sizes_of(matrix) != sizes_[block])
+        throw std::runtime_error("ERROR::ESTIMATEPUBLISHER::PUBLISH\nERROR:\n\tThe published data is " + std::to_string(matrix.rows()) + " x " + std::to_string(matrix.cols()) + " instead of " + std::to_string(sizes_[block].first) + " x " + std::to_string(sizes_[block].second) + ".");
+}
+
+
+EstimatePublisher::Slot& EstimatePublisher::beginWrite(const std::size_t step)
+{
+    /* Overwrite the older slot, the newer one being the one the readers are directed to. */
+    Slot& slot = slots_[(publications_.load(std::memory_order_relaxed) + 1) % 2];
+
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.step.store(step, std::memory_order_relaxed);
+
+    return slot;
+}
+
+
+void EstimatePublisher::writeBlock(Slot& slot, const Block block, const Ref<const MatrixXd>& matrix)
+{
+    std::size_t i = offsets_[block];
+
+    for (Index col = 0; col < matrix.cols(); col++)
+    {
+        for (Index row = 0; row < matrix.rows(); row++)
+            slot.data[i++].store(matrix(row, col), std::memory_order_relaxed);
+    }
+}
+
+
+void EstimatePublisher::endWrite(Slot& slot)
+{
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    publications_.store(publications_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
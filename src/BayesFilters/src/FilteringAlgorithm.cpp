@@ -1,5 +1,7 @@
 #include <BayesFilters/FilteringAlgorithm.h>
+#include <BayesFilters/FilteringExecutor.h>
 
+#include <exception>
 #include <iostream>
 
 using namespace bfl;
@@ -23,16 +25,58 @@ bool FilteringAlgorithm::boot()
 }
 
 
+bool FilteringAlgorithm::boot(FilteringExecutor& executor)
+{
+    std::lock_guard<std::mutex> lk(mtx_run_);
+
+    if (event_driven_ && event_timeout_enabled_)
+    {
+        std::cerr << "ERROR::FILTERINGALGORITHM::BOOT\n";
+        std::cerr << "ERROR::LOG:\n\tthe timeout of the event-driven run mode is not supported by filters booted on an executor." << std::endl;
+        return false;
+    }
+
+    executor_ = &executor;
+    reset_ = false;
+    filtering_step_ = 0;
+    initialized_ = false;
+    finished_ = false;
+
+    /* Wait for run() or teardown(), unless already called. */
+    parked_ = !(run_ || teardown_);
+    if (!parked_)
+        submitStep();
+
+    return true;
+}
+
+
 void FilteringAlgorithm::run()
 {
     std::lock_guard<std::mutex> lk(mtx_run_);
     run_ = true;
     cv_run_.notify_one();
+
+    if (executor_ && parked_)
+    {
+        parked_ = false;
+        submitStep();
+    }
 }
 
 
 bool FilteringAlgorithm::wait()
 {
+    if (executor_)
+    {
+        std::unique_lock<std::mutex> lk(mtx_run_);
+        cv_finished_.wait(lk, [this]{ return this->finished_; });
+
+        executor_ = nullptr;
+
+        return true;
+    }
+
     if (filtering_thread_.joinable())
     {
         try
@@ -60,6 +104,10 @@ bool FilteringAlgorithm::wait()
 void FilteringAlgorithm::reset()
 {
     reset_ = true;
+
+    std::lock_guard<std::mutex> lk(mtx_run_);
+    cv_measurement_.notify_all();
+    resumeWaitingStep();
 }
 
 
@@ -69,6 +117,8 @@ void FilteringAlgorithm::reboot()
     reset_ = true;
     run_   = false;
     cv_run_.notify_one();
+    cv_measurement_.notify_all();
+    resumeWaitingStep();
 }
 
 
@@ -76,6 +126,19 @@ bool FilteringAlgorithm::teardown()
 {
     teardown_ = true;
 
+    /* A filter waiting for run() is resumed to terminate, on its thread or on the executor. */
+    std::lock_guard<std::mutex> lk(mtx_run_);
+    cv_run_.notify_one();
+
+    if (executor_ && parked_)
+    {
+        parked_ = false;
+        submitStep();
+    }
+
+    cv_measurement_.notify_all();
+    resumeWaitingStep();
+
     return true;
 }
 
@@ -92,6 +155,57 @@ bool FilteringAlgorithm::isRunning()
 }
 
 
+void FilteringAlgorithm::enableEventDrivenRun()
+{
+    std::lock_guard<std::mutex> lk(mtx_run_);
+    event_driven_ = true;
+    event_timeout_enabled_ = false;
+    pending_measurements_ = 0;
+}
+
+
+void FilteringAlgorithm::enableEventDrivenRun(const std::chrono::microseconds& timeout)
+{
+    std::lock_guard<std::mutex> lk(mtx_run_);
+
+    if (executor_)
+        throw std::runtime_error("ERROR::FILTERINGALGORITHM::ENABLEEVENTDRIVENRUN\nERROR:\n\tThe timeout is not supported by filters booted on an executor.");
+
+    event_driven_ = true;
+    pending_measurements_ = 0;
+    event_timeout_enabled_ = true;
+    event_timeout_ = timeout;
+}
+
+
+void FilteringAlgorithm::disableEventDrivenRun()
+{
+    std::lock_guard<std::mutex> lk(mtx_run_);
+    event_driven_ = false;
+    cv_measurement_.notify_all();
+    resumeWaitingStep();
+}
+
+
+void FilteringAlgorithm::notifyMeasurement()
+{
+    std::lock_guard<std::mutex> lk(mtx_run_);
+    ++pending_measurements_;
+    cv_measurement_.notify_all();
+    resumeWaitingStep();
+}
+
+
+std::pair<bool, FilteringStatistics::Report> FilteringAlgorithm::getStatistics() const
+{
+#if defined(BFL_INSTRUMENTATION)
+    return std::make_pair(true, statistics_.getReport());
+#else
+    return std::make_pair(false, FilteringStatistics::Report());
+#endif
+}
+
+
 void FilteringAlgorithm::filteringRecursion()
 {
     do
@@ -117,7 +231,13 @@ void FilteringAlgorithm::filteringRecursion()
 
         while (runCondition() && !teardown_ && !reset_)
         {
-            filteringStep();
+            if (!waitMeasurement())
+                continue;
+
+            {
+                BFL_STATISTICS_SCOPE(Step);
+                filteringStep();
+            }
 
             ++filtering_step_;
         }
@@ -126,3 +246,107 @@ void FilteringAlgorithm::filteringRecursion()
 
     run_ = false;
 }
+
+
+void FilteringAlgorithm::scheduledStep()
+{
+    /* Same recursion of filteringRecursion(), one filtering step per task. */
+    if (!initialized_)
+    {
+        {
+            std::lock_guard<std::mutex> lk(mtx_run_);
+            if (!(run_ || teardown_))
+            {
+                /* Wait for run() or teardown(), that submit the next step. */
+                parked_ = true;
+                return;
+            }
+        }
+
+        initialization();
+        initialized_ = true;
+    }
+
+    if (runCondition() && !teardown_ && !reset_)
+    {
+        if (event_driven_)
+        {
+            /* In the event-driven run mode, wait for notifyMeasurement(), that submits the next step. */
+            std::lock_guard<std::mutex> lk(mtx_run_);
+            if (event_driven_ && (pending_measurements_ == 0))
+            {
+                waiting_measurement_ = true;
+                return;
+            }
+
+            pending_measurements_ = 0;
+        }
+
+        {
+            BFL_STATISTICS_SCOPE(Step);
+            filteringStep();
+        }
+
+        ++filtering_step_;
+
+        submitStep();
+        return;
+    }
+
+    initialized_ = false;
+
+    if (runCondition() && (run_ || reset_) && !teardown_)
+    {
+        reset_ = false;
+        filtering_step_ = 0;
+
+        submitStep();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lk(mtx_run_);
+    run_ = false;
+    finished_ = true;
+    cv_finished_.notify_all();
+}
+
+
+void FilteringAlgorithm::submitStep()
+{
+    executor_->submit([this]{ this->scheduledStep(); });
+}
+
+
+bool FilteringAlgorithm::waitMeasurement()
+{
+    /* Steps run back to back, without locking, unless in the event-driven run mode. */
+    if (!event_driven_)
+        return true;
+
+    std::unique_lock<std::mutex> lk(mtx_run_);
+
+    auto ready = [this]{ return (this->pending_measurements_ > 0) || !this->event_driven_ || this->teardown_ || this->reset_; };
+
+    if (event_timeout_enabled_)
+        cv_measurement_.wait_for(lk, event_timeout_, ready);
+    else
+        cv_measurement_.wait(lk, ready);
+
+    if (teardown_ || reset_)
+        return false;
+
+    /* A notification, a timeout or the event-driven run mode being disabled. */
+    pending_measurements_ = 0;
+
+    return true;
+}
+
+
+void FilteringAlgorithm::resumeWaitingStep()
+{
+    if (executor_ && waiting_measurement_)
+    {
+        waiting_measurement_ = false;
+        submitStep();
+    }
+}
@@ -0,0 +1,182 @@
+#include <BayesFilters/FilteringExecutor.h>
+
+#include <iostream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace bfl;
+
+
+namespace
+{
+    /**
+     * Index of the worker running on the calling thread, or -1 on the other threads.
+     */
+    thread_local int current_worker = -1;
+
+    thread_local const FilteringExecutor* current_executor = nullptr;
+}
+
+
+FilteringExecutor::FilteringExecutor(const unsigned int num_workers) noexcept :
+    FilteringExecutor(num_workers, false)
+{ }
+
+
+FilteringExecutor::FilteringExecutor(const unsigned int num_workers, const bool pin_workers) noexcept
+{
+    const unsigned int workers = std::max(num_workers, 1u);
+
+    for (unsigned int i = 0; i < workers; i++)
+        workers_.emplace_back(new Worker());
+
+    pinned_ = pin_workers;
+    for (unsigned int i = 0; i < workers; i++)
+    {
+        workers_[i]->thread = std::thread(&FilteringExecutor::workerLoop, this, i);
+
+        if (pin_workers)
+            pinned_ &= pinWorker(i);
+    }
+}
+
+
+FilteringExecutor::~FilteringExecutor() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_tasks_.notify_all();
+
+    for (auto& worker : workers_)
+    {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+}
+
+
+void FilteringExecutor::submit(std::function<void()> task)
+{
+    /* Tasks submitted by a worker stay on its queue. */
+    unsigned int index;
+    if ((current_executor == this) && (current_worker >= 0))
+        index = current_worker;
+    else
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index = next_worker_;
+        next_worker_ = (next_worker_ + 1) % workers_.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queued_tasks_;
+    }
+    cv_tasks_.notify_one();
+}
+
+
+unsigned int FilteringExecutor::getNumberOfWorkers() const
+{
+    return workers_.size();
+}
+
+
+bool FilteringExecutor::isPinned() const
+{
+    return pinned_;
+}
+
+
+void FilteringExecutor::workerLoop(const unsigned int index)
+{
+    current_worker = index;
+    current_executor = this;
+
+    std::function<void()> task;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_tasks_.wait(lock, [this]{ return (queued_tasks_ > 0) || stop_; });
+
+            if (stop_)
+                return;
+
+            --queued_tasks_;
+        }
+
+        /* A task has been reserved for this worker, hence one of the queues is not empty. */
+        while (!pop(index, task))
+            std::this_thread::yield();
+
+        task();
+    }
+}
+
+
+bool FilteringExecutor::pop(const unsigned int index, std::function<void()>& task)
+{
+    /* Oldest task of the own queue. */
+    {
+        Worker& worker = *workers_[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+
+        if (!worker.tasks.empty())
+        {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+            return true;
+        }
+    }
+
+    /* Most recent task of the other queues. */
+    for (unsigned int i = 1; i < workers_.size(); i++)
+    {
+        Worker& victim = *workers_[(index + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool FilteringExecutor::pinWorker(const unsigned int index)
+{
+#if defined(__linux__)
+    const unsigned int cores = std::max(std::thread::hardware_concurrency(), 1u);
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(index % cores, &cpu_set);
+
+    const int error = pthread_setaffinity_np(workers_[index]->thread.native_handle(), sizeof(cpu_set_t), &cpu_set);
+    if (error != 0)
+    {
+        std::cerr << "WARNING::FILTERINGEXECUTOR::PINWORKER\n";
+        std::cerr << "WARNING::LOG:\n\tCannot pin worker " << index << " to core " << index % cores << ", error " << error << "." << std::endl;
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
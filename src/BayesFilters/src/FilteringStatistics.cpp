@@ -0,0 +1,190 @@
+#include <BayesFilters/FilteringStatistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace bfl;
+
+
+const FilteringStatistics::Summary& FilteringStatistics::Report::phase(const Phase phase) const
+{
+    return phases[static_cast<std::size_t>(phase)];
+}
+
+
+FilteringStatistics::ScopedTimer::ScopedTimer(FilteringStatistics& statistics, const Phase phase) noexcept :
+    statistics_(statistics),
+    phase_(phase),
+    start_(std::chrono::steady_clock::now())
+{ }
+
+
+FilteringStatistics::ScopedTimer::~ScopedTimer() noexcept
+{
+    statistics_.recordDuration(phase_, std::chrono::steady_clock::now() - start_);
+}
+
+
+FilteringStatistics::FilteringStatistics() noexcept :
+    FilteringStatistics(1024)
+{ }
+
+
+FilteringStatistics::FilteringStatistics(const std::size_t window_size) noexcept :
+    window_size_(std::max<std::size_t>(window_size, 1))
+{
+    /* Allocate the windows once, so that recording a sample never allocates memory. */
+    auto allocate = [this](Window& window)
+    {
+        window.samples.reset(new std::atomic<double>[window_size_]);
+
+        for (std::size_t i = 0; i < window_size_; i++)
+            window.samples[i].store(0.0, std::memory_order_relaxed);
+    };
+
+    for (Window& window : phases_)
+        allocate(window);
+
+    allocate(effective_sample_size_);
+}
+
+
+void FilteringStatistics::recordDuration(const Phase phase, const std::chrono::steady_clock::duration& duration)
+{
+    push(phases_[static_cast<std::size_t>(phase)], std::chrono::duration<double, std::micro>(duration).count());
+
+    if (phase == Phase::Step)
+        increment(steps_);
+}
+
+
+void FilteringStatistics::recordEffectiveSampleSize(const double effective_sample_size)
+{
+    push(effective_sample_size_, effective_sample_size);
+}
+
+
+void FilteringStatistics::recordResampling()
+{
+    increment(resamplings_);
+}
+
+
+FilteringStatistics::Report FilteringStatistics::getReport() const
+{
+    Report report;
+
+    /* The samples are copied and sorted in a buffer of the reader, without blocking the filtering steps. */
+    std::vector<double> samples(window_size_);
+
+    for (std::size_t i = 0; i < number_of_phases; i++)
+        report.phases[i] = summarize(phases_[i], samples);
+
+    report.effective_sample_size = summarize(effective_sample_size_, samples);
+
+    report.steps = steps_.load(std::memory_order_acquire);
+    report.resamplings = resamplings_.load(std::memory_order_acquire);
+
+    if (report.steps > 0)
+        report.resampling_frequency = static_cast<double>(report.resamplings) / report.steps;
+
+    return report;
+}
+
+
+void FilteringStatistics::reset()
+{
+    auto clear = [](Window& window)
+    {
+        const std::size_t sequence = window.sequence.load(std::memory_order_relaxed);
+        window.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        window.next = 0;
+        window.count.store(0, std::memory_order_relaxed);
+
+        window.sequence.store(sequence + 2, std::memory_order_release);
+    };
+
+    for (Window& window : phases_)
+        clear(window);
+
+    clear(effective_sample_size_);
+
+    steps_.store(0, std::memory_order_release);
+    resamplings_.store(0, std::memory_order_release);
+}
+
+
+void FilteringStatistics::push(Window& window, const double sample)
+{
+    /* Only the filtering thread writes, hence the sequence can be incremented without a read-modify-write. */
+    const std::size_t sequence = window.sequence.load(std::memory_order_relaxed);
+    window.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    window.samples[window.next].store(sample, std::memory_order_relaxed);
+
+    window.next = (window.next + 1) % window_size_;
+    window.count.store(std::min(window.count.load(std::memory_order_relaxed) + 1, window_size_), std::memory_order_relaxed);
+
+    window.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+
+FilteringStatistics::Summary FilteringStatistics::summarize(const Window& window, std::vector<double>& samples) const
+{
+    /* The samples are in the first count elements until the window is full, then in all of them. */
+    std::size_t count;
+    while (true)
+    {
+        const std::size_t sequence = window.sequence.load(std::memory_order_acquire);
+        if (sequence % 2 == 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        count = window.count.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; i++)
+            samples[i] = window.samples[i].load(std::memory_order_relaxed);
+
+        /* The copy is consistent only if the window has not been written in the meantime. */
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (window.sequence.load(std::memory_order_relaxed) == sequence)
+            break;
+    }
+
+    Summary summary;
+    summary.samples = count;
+
+    if (count == 0)
+        return summary;
+
+    const auto begin = samples.begin();
+    const auto end = samples.begin() + count;
+
+    /* Nearest-rank percentiles. */
+    auto percentile = [begin, end, count](const double p)
+    {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(p * count));
+        const std::size_t index = std::max<std::size_t>(rank, 1) - 1;
+
+        std::nth_element(begin, begin + index, end);
+
+        return *(begin + index);
+    };
+
+    summary.p50 = percentile(0.50);
+    summary.p99 = percentile(0.99);
+    summary.max = *std::max_element(begin, end);
+
+    return summary;
+}
+
+
+void FilteringStatistics::increment(std::atomic<std::size_t>& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
@@ -1,13 +1,24 @@
 #include <BayesFilters/GPFCorrection.h>
+#include <BayesFilters/utils.h>
 
 #include <Eigen/Cholesky>
 
+#include <cmath>
 #include <exception>
+#include <limits>
 
 using namespace bfl;
 using namespace Eigen;
 
 
+namespace
+{
+    /* Floor of the pivots of the LDL' decomposition in the log-determinant of the proposal, so that degenerate
+       directions of a positive semidefinite covariance matrix do not turn the logarithm into -inf. */
+    const double min_pivot = std::numeric_limits<double>::min();
+}
+
+
 GPFCorrection::GPFCorrection
 (
     std::unique_ptr<GaussianCorrection> gauss_corr,
@@ -29,8 +40,7 @@ GPFCorrection::GPFCorrection
     likelihood_model_(std::move(lik_model)),
     state_model_(std::move(state_model)),
     generator_(std::mt19937_64(seed)),
-    distribution_(std::normal_distribution<double>(0.0, 1.0)),
-    gaussian_random_sample_([&] { return (distribution_)(generator_); })
+    distribution_(std::normal_distribution<double>(0.0, 1.0))
 { }
 
 
@@ -41,7 +51,7 @@ GPFCorrection::GPFCorrection(GPFCorrection&& gpf_correction) noexcept :
     state_model_(std::move(gpf_correction.state_model_)),
     generator_(std::move(gpf_correction.generator_)),
     distribution_(std::move(gpf_correction.distribution_)),
-    gaussian_random_sample_(std::move(gpf_correction.gaussian_random_sample_)) { }
+    rand_vectors_(std::move(gpf_correction.rand_vectors_)) { }
 
 
 void GPFCorrection::setLikelihoodModel(std::unique_ptr<LikelihoodModel> likelihood_model)
@@ -80,15 +90,12 @@ void GPFCorrection::correctStep(const bfl::ParticleSet& pred_particles, bfl::Par
     gaussian_correction_->correctStep(pred_particles, corr_particles);
 
     /* Sample from the proposal distribution. */
-    for (std::size_t i = 0; i < pred_particles.components; i++)
-    {
-        corr_particles.state(i) = sampleFromProposal(corr_particles.mean(i), corr_particles.covariance(i));
-    }
+    VectorXd log_proposal = sampleFromProposal(corr_particles);
 
-    /* Evaluate the likelihood. */
+    /* Evaluate the logarithm of the likelihood. */
     bool valid_likelihood;
-    VectorXd likelihood;
-    std::tie(valid_likelihood, likelihood) = likelihood_model_->likelihood(getMeasurementModel(), corr_particles.state());
+    VectorXd log_likelihood;
+    std::tie(valid_likelihood, log_likelihood) = evaluateLogLikelihood(corr_particles.state());
 
     if (!valid_likelihood)
     {
@@ -97,48 +104,77 @@ void GPFCorrection::correctStep(const bfl::ParticleSet& pred_particles, bfl::Par
         return;
     }
 
-    /* Evaluate the transition probability. */
-    VectorXd transition_probability = state_model_->getTransitionProbability(pred_particles.state(), corr_particles.state());
+    /* Evaluate the logarithm of the transition probability. */
+    VectorXd log_transition_probability = state_model_->getLogTransitionProbability(pred_particles.state(), corr_particles.state());
 
     /* Update weights in the log space.
      w_{k} = w_{k-1} + log(likelihood) + log(transition_probability) - log(proposal_distribution) */
-    double eps = std::numeric_limits<double>::min();
-    for (std::size_t i = 0; i < pred_particles.components; i++)
-    {
-        corr_particles.weight(i) = pred_particles.weight(i) + log(likelihood(i) + eps) + log(transition_probability(i) + eps) - log(evaluateProposal(corr_particles.state(i), corr_particles.mean(i), corr_particles.covariance(i)) + eps);
-    }
+    corr_particles.weight() = pred_particles.weight() + log_likelihood + log_transition_probability - log_proposal;
 }
 
 
-Eigen::VectorXd GPFCorrection::sampleFromProposal(const Eigen::VectorXd& mean, const Eigen::MatrixXd& covariance)
+VectorXd GPFCorrection::sampleFromProposal(ParticleSet& particles)
 {
-    /* Evaluate the square root of the state covariance matrix using the LDL' decomposition
-       (it can be used even if the covariance matrix is positive semidefinite). */
-    LDLT<MatrixXd> chol_ldlt(covariance);
-    MatrixXd sqrt_P = (chol_ldlt.transpositionsP() * MatrixXd::Identity(mean.size(), mean.size())).transpose() *
-                       chol_ldlt.matrixL() *
-                       chol_ldlt.vectorD().real().cwiseSqrt().asDiagonal();
+    const std::size_t state_size = particles.state().rows();
+    const std::size_t num_particles = particles.components;
+
+    /* Sample i.i.d standard normal univariates for all the particles at once. */
+    rand_vectors_.resize(state_size, num_particles);
+    for (int i = 0; i < rand_vectors_.size(); i++)
+        *(rand_vectors_.data() + i) = distribution_(generator_);
+
+    VectorXd log_proposal(num_particles);
+
+    /* Particles are independent, hence they can be processed in parallel. */
+    utils::parallel_for(getNumberOfThreads(), num_particles,
+                        [&](const std::size_t begin, const std::size_t end)
+                        {
+                            LDLT<MatrixXd> chol_ldlt(state_size);
+                            VectorXd sqrt_d(state_size);
+
+                            for (std::size_t i = begin; i < end; i++)
+                            {
+                                /* Factorize the covariance matrix as P' * L * D * L' * P using the LDL' decomposition
+                                   (it can be used even if the covariance matrix is positive semidefinite). */
+                                chol_ldlt.compute(particles.covariance(i));
+                                sqrt_d = chol_ldlt.vectorD().cwiseMax(0.0).cwiseSqrt();
+
+                                /* A sample from a normal multivariate having mean 'mean' and covariance 'covariance'
+                                   is mean + P' * L * sqrt(D) * z, with z a standard normal sample. */
+                                particles.state(i) = particles.mean(i) + chol_ldlt.transpositionsP().transpose() * (chol_ldlt.matrixL() * sqrt_d.cwiseProduct(rand_vectors_.col(i)));
+
+                                /* The squared Mahalanobis distance of the sample from the mean is z' * z. */
+                                log_proposal(i) = -0.5 * static_cast<double>(state_size) * log(2.0 * M_PI) - 0.5 * chol_ldlt.vectorD().cwiseMax(min_pivot).array().log().sum() - 0.5 * rand_vectors_.col(i).squaredNorm();
+                            }
+                        });
+
+    return log_proposal;
+}
 
-    /* Sample i.i.d standard normal univariates. */
-    VectorXd rand_vectors(mean.size());
-    for (int i = 0; i < rand_vectors.size(); i++)
-        rand_vectors(i) = gaussian_random_sample_();
 
-    /* Return a sample from a normal multivariate having mean `mean` and covariance 'covariance'. */
-    return mean + sqrt_P * rand_vectors;
+double GPFCorrection::evaluateProposal
+(
+    const Eigen::VectorXd& state,
+    const Eigen::VectorXd& mean,
+    const Eigen::MatrixXd& covariance
+)
+{
+    return std::exp(logEvaluateProposal(state, mean, covariance));
 }
 
 
-double GPFCorrection::evaluateProposal
+double GPFCorrection::logEvaluateProposal
 (
     const Eigen::VectorXd& state,
     const Eigen::VectorXd& mean,
     const Eigen::MatrixXd& covariance
 )
 {
-    /* Evaluate the proposal distribution, a Gaussian centered in 'mean' and having
-       covariance 'covariance', in the state 'state'. */
+    /* Evaluate the logarithm of the proposal distribution, a Gaussian centered in 'mean'
+       and having covariance 'covariance', in the state 'state'. */
     VectorXd difference = state - mean;
 
-    return (-0.5 * static_cast<double>(difference.size()) * log(2.0 * M_PI) -0.5 * log(covariance.determinant()) -0.5 * (difference.transpose() * covariance.inverse() * difference).array()).exp().coeff(0);
+    LDLT<MatrixXd> chol_ldlt(covariance);
+
+    return -0.5 * static_cast<double>(difference.size()) * log(2.0 * M_PI) -0.5 * chol_ldlt.vectorD().cwiseMax(min_pivot).array().log().sum() -0.5 * difference.dot(chol_ldlt.solve(difference));
 }
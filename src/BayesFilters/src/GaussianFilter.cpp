@@ -1,4 +1,7 @@
 #include <BayesFilters/GaussianFilter.h>
+#include <BayesFilters/utils.h>
+
+#include <stdexcept>
 
 using namespace bfl;
 
@@ -20,7 +23,9 @@ GaussianFilter::GaussianFilter(GaussianFilter&& gf) noexcept :
     prediction_(std::move(gf.prediction_)),
     correction_(std::move(gf.correction_)),
     predicted_state_(std::move(gf.predicted_state_)),
-    corrected_state_(std::move(gf.corrected_state_))
+    corrected_state_(std::move(gf.corrected_state_)),
+    publisher_(std::move(gf.publisher_)),
+    publish_belief_(gf.publish_belief_)
 { }
 
 
@@ -36,10 +41,28 @@ bool GaussianFilter::initialization()
 
 void GaussianFilter::filteringStep()
 {
-    prediction_->predict(corrected_state_, predicted_state_);
-    correction_->correct(predicted_state_, corrected_state_);
+    {
+        BFL_STATISTICS_SCOPE(Prediction);
+        prediction_->predict(corrected_state_, predicted_state_);
+    }
+
+    {
+        BFL_STATISTICS_SCOPE(Correction);
+        correction_->correct(predicted_state_, corrected_state_);
+    }
 
-    log();
+    {
+        BFL_STATISTICS_SCOPE(Logging);
+        log();
+    }
+
+    if (publisher_)
+    {
+        if (publish_belief_)
+            publisher_->publish(getFilteringStep(), corrected_state_.mean(), corrected_state_);
+        else
+            publisher_->publish(getFilteringStep(), corrected_state_.mean());
+    }
 }
 
 
@@ -74,3 +97,23 @@ bool GaussianFilter::skip(const std::string& what_step, const bool status)
 
     return false;
 }
+
+
+void GaussianFilter::enablePublication(const bool full_belief)
+{
+    if (full_belief)
+        publisher_ = utils::make_unique<EstimatePublisher>(corrected_state_.dim, corrected_state_);
+    else
+        publisher_ = utils::make_unique<EstimatePublisher>(corrected_state_.dim);
+
+    publish_belief_ = full_belief;
+}
+
+
+const EstimatePublisher& GaussianFilter::getPublisher() const
+{
+    if (!publisher_)
+        throw std::runtime_error("ERROR::GAUSSIANFILTER::GETPUBLISHER\nERROR:\n\tPublication not enabled. Call GaussianFilter::enablePublication() first.");
+
+    return *publisher_;
+}
@@ -18,6 +18,56 @@ std::pair<bool, VectorXd> GaussianLikelihood::likelihood
     const Ref<const MatrixXd>& pred_states
 )
 {
+    bool valid_log_likelihood;
+    VectorXd log_likelihood;
+    std::tie(valid_log_likelihood, log_likelihood) = logLikelihood(measurement_model, pred_states);
+
+    if (!valid_log_likelihood)
+        return std::make_pair(false, VectorXd::Zero(1));
+
+    return std::make_pair(true, log_likelihood.array().exp().matrix());
+}
+
+
+std::pair<bool, VectorXd> GaussianLikelihood::logLikelihood
+(
+    const MeasurementModel& measurement_model,
+    const Ref<const MatrixXd>& pred_states
+)
+{
+    if (!prepareLogLikelihood(measurement_model))
+        return std::make_pair(false, VectorXd::Zero(1));
+
+    return preparedLogLikelihood(measurement_model, pred_states);
+}
+
+
+bool GaussianLikelihood::hasPreparedLogLikelihood() const
+{
+    return true;
+}
+
+
+bool GaussianLikelihood::prepareLogLikelihood(const MeasurementModel& measurement_model)
+{
+    bool valid_covariance_matrix;
+    MatrixXd covariance_matrix;
+    std::tie(valid_covariance_matrix, covariance_matrix) = measurement_model.getNoiseCovarianceMatrix();
+
+    return valid_covariance_matrix && updateFactorization(covariance_matrix);
+}
+
+
+std::pair<bool, VectorXd> GaussianLikelihood::preparedLogLikelihood
+(
+    const MeasurementModel& measurement_model,
+    const Ref<const MatrixXd>& pred_states
+) const
+{
+    if (!valid_factorization_)
+        return std::make_pair(false, VectorXd::Zero(1));
+
+
     bool valid_measurements;
     Data data_measurements;
     std::tie(valid_measurements, data_measurements) = measurement_model.measure();
@@ -51,17 +101,31 @@ std::pair<bool, VectorXd> GaussianLikelihood::likelihood
         return std::make_pair(false, VectorXd::Zero(1));
 
 
-    VectorXd likelihood(innovations.cols());
-    bool valid_covariance_matrix;
-    MatrixXd covariance_matrix;
-    std::tie(valid_covariance_matrix, covariance_matrix) = measurement_model.getNoiseCovarianceMatrix();
+    /* Evaluate all the squared Mahalanobis distances at once, as the squared norms
+       of the columns of L^{-1} * innovations, where R = L * L'. */
+    covariance_llt_.matrixL().solveInPlace(innovations);
 
-    if (!valid_covariance_matrix)
-        return std::make_pair(false, VectorXd::Zero(1));
+    VectorXd log_likelihood = (log(scale_factor_) - 0.5 * static_cast<double>(innovations.rows()) * log(2.0*M_PI) - 0.5 * log_determinant_ - 0.5 * innovations.colwise().squaredNorm().transpose().array()).matrix();
+
+    return std::make_pair(true, log_likelihood);
+}
+
+
+bool GaussianLikelihood::updateFactorization(const Ref<const MatrixXd>& covariance_matrix)
+{
+    if (valid_factorization_ &&
+        (covariance_matrix.rows() == covariance_matrix_.rows()) &&
+        (covariance_matrix.cols() == covariance_matrix_.cols()) &&
+        (covariance_matrix == covariance_matrix_))
+        return true;
+
+    covariance_matrix_ = covariance_matrix;
+    covariance_llt_.compute(covariance_matrix_);
 
+    valid_factorization_ = (covariance_llt_.info() == Success);
 
-    for (unsigned int i = 0; i < innovations.cols(); ++i)
-        likelihood(i) = scale_factor_ * (-0.5 * static_cast<double>(innovations.rows()) * log(2.0*M_PI) - 0.5 * log(covariance_matrix.determinant()) - 0.5 * (innovations.col(i).transpose() * covariance_matrix.inverse() * innovations.col(i)).array()).exp().coeff(0);
+    if (valid_factorization_)
+        log_determinant_ = 2.0 * covariance_llt_.matrixLLT().diagonal().array().log().sum();
 
-    return std::make_pair(true, likelihood);
+    return valid_factorization_;
 }
@@ -19,14 +19,25 @@ GaussianMixture::GaussianMixture
     const std::size_t components,
     const std::size_t dim_linear,
     const std::size_t dim_circular
+) :
+    GaussianMixture(components, dim_linear, dim_circular, true)
+{ }
+
+
+GaussianMixture::GaussianMixture
+(
+    const std::size_t components,
+    const std::size_t dim_linear,
+    const std::size_t dim_circular,
+    const bool allocate_mean_covariance
 ) :
     components(components),
     dim(dim_linear + dim_circular),
     dim_linear(dim_linear),
     dim_circular(dim_circular),
     dim_noise(0),
-    mean_(dim, components),
-    covariance_(dim, dim * components),
+    mean_(dim, allocate_mean_covariance ? components : 0),
+    covariance_(dim, allocate_mean_covariance ? dim * components : 0),
     weight_(components)
 {
     for (int i = 0; i < this->components; ++i)
@@ -10,8 +10,20 @@ KFCorrection::KFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_m
 
 
 KFCorrection::KFCorrection(KFCorrection&& kf_correction) noexcept :
-    measurement_model_(std::move(kf_correction.measurement_model_))
-{ }
+    measurement_model_(std::move(kf_correction.measurement_model_)),
+    H_(std::move(kf_correction.H_)),
+    R_(std::move(kf_correction.R_)),
+    sparse_H_(kf_correction.sparse_H_),
+    H_sparse_(std::move(kf_correction.H_sparse_)),
+    valid_model_matrices_(kf_correction.valid_model_matrices_),
+    model_revision_(kf_correction.model_revision_),
+    PxHt_(std::move(kf_correction.PxHt_)),
+    Py_(std::move(kf_correction.Py_)),
+    Py_ldlt_(std::move(kf_correction.Py_ldlt_)),
+    W_(std::move(kf_correction.W_))
+{
+    kf_correction.valid_model_matrices_ = false;
+}
 
 
 KFCorrection::~KFCorrection() noexcept
@@ -59,40 +71,104 @@ void KFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixtur
         return;
     }
 
-    bool valid_covariance_matrix;
-    MatrixXd R;
-    std::tie(valid_covariance_matrix, R) = measurement_model_->getNoiseCovarianceMatrix();
-
-    if (!valid_covariance_matrix)
+    if (!updateModelMatrices())
     {
         corr_state = pred_state;
         return;
     }
 
-    MatrixXd H = measurement_model_->getMeasurementMatrix();
-
     /* Cast innovations once for all. */
     MatrixXd innovations = any::any_cast<MatrixXd&&>(std::move(innovation));
 
+    correctComponents(pred_state, innovations, corr_state);
+}
+
+
+void KFCorrection::correctComponents(const GaussianMixture& pred_state, const Ref<const MatrixXd>& innovations, GaussianMixture& corr_state)
+{
     /* Process all the components in the mixture. */
     for (size_t i=0; i < pred_state.components; i++)
     {
         /* Evaluate the measurement covariance matrix
            Py = H * Px * H' + R */
-        MatrixXd Py = H * pred_state.covariance(i) * H.transpose() + R;
+        if (sparse_H_)
+        {
+            PxHt_.noalias() = pred_state.covariance(i) * H_sparse_.transpose();
+            Py_ = R_;
+            Py_.noalias() += H_sparse_ * PxHt_;
+        }
+        else
+        {
+            PxHt_.noalias() = pred_state.covariance(i) * H_.transpose();
+            Py_ = R_;
+            Py_.noalias() += H_ * PxHt_;
+        }
+
+        /* Decompose Py = P' * L * D * L' * P. */
+        Py_ldlt_.compute(Py_);
+
+        if ((Py_ldlt_.info() == Success) && (Py_ldlt_.vectorD().array() > 0.0).all())
+        {
+            /* Evaluate W = D^{-1/2} * L^{-1} * P * (Px * H')', such that
+               K * Py * K' = Px * H' * (Py)^{-1} * H * Px = W' * W. */
+            W_ = Py_ldlt_.transpositionsP() * PxHt_.transpose();
+            Py_ldlt_.matrixL().solveInPlace(W_);
+            W_ = Py_ldlt_.vectorD().cwiseSqrt().cwiseInverse().asDiagonal() * W_;
+
+            /* Evaluate the filtered mean
+               x_{k}+ = x{k}- + K * (y - y_predicted)
+               using the Kalman gain K = Px * H' * (Py)^{-1} through a solve. */
+            VectorXd gain_innovation = Py_ldlt_.solve(innovations.col(i));
+            corr_state.mean(i) = pred_state.mean(i) + PxHt_ * gain_innovation;
+
+            /* Evaluate the filtered covariance
+               P_{k}+ = P_{k}- - K * Py * K' = P_{k}- - W' * W
+               as a symmetric rank-k update of the lower triangle, then mirrored in the upper one. */
+            corr_state.covariance(i) = pred_state.covariance(i);
+            corr_state.covariance(i).selfadjointView<Lower>().rankUpdate(W_.transpose(), -1.0);
+            corr_state.covariance(i).triangularView<StrictlyUpper>() = corr_state.covariance(i).transpose();
+        }
+        else
+        {
+            /* Py is not numerically positive definite, use the solve of the LDL' decomposition as it is.
+               K = Px * H' * (Py)^{-1} */
+            MatrixXd K = Py_ldlt_.solve(PxHt_.transpose()).transpose();
+
+            corr_state.mean(i) = pred_state.mean(i) + K * innovations.col(i);
+
+            /* P_{k}+ = P_{k}- - K * Py * K' = P_{k}- - K * (Px * H')' */
+            corr_state.covariance(i) = pred_state.covariance(i);
+            corr_state.covariance(i).noalias() -= K * PxHt_.transpose();
+        }
+    }
+}
+
 
-        /* Evaluate the Kalman Gain
-           K = Px * H' * (Py)^{-1} */
-        MatrixXd K = pred_state.covariance(i) * H.transpose() * Py.inverse();
+bool KFCorrection::updateModelMatrices()
+{
+    bool cacheable;
+    std::size_t revision;
+    std::tie(cacheable, revision) = measurement_model_->getRevision();
+
+    if (cacheable && valid_model_matrices_ && (revision == model_revision_))
+        return true;
 
-        /* Evaluate the filtered mean
-           x_{k}+ = x{k}- + K * (y - y_predicted) */
-        corr_state.mean(i) = pred_state.mean(i) + K * innovations.col(i);
+    bool valid_covariance_matrix;
+    std::tie(valid_covariance_matrix, R_) = measurement_model_->getNoiseCovarianceMatrix();
 
-        /* Evaluate the filtered covariance
-           P_{k}+ = P_{k}- - K * Py * K' */
-        corr_state.covariance(i).noalias() = pred_state.covariance(i) - K * Py * K.transpose();
+    if (!valid_covariance_matrix)
+    {
+        valid_model_matrices_ = false;
+        return false;
     }
+
+    H_ = measurement_model_->getMeasurementMatrix();
+    std::tie(sparse_H_, H_sparse_) = measurement_model_->getSparseMeasurementMatrix();
+
+    valid_model_matrices_ = cacheable;
+    model_revision_ = revision;
+
+    return true;
 }
 
 
@@ -17,8 +17,17 @@ KFPrediction::KFPrediction(std::unique_ptr<LinearStateModel> state_model, std::u
 
 KFPrediction::KFPrediction(KFPrediction&& kf_prediction) noexcept:
     state_model_(std::move(kf_prediction.state_model_)),
-    exogenous_model_(std::move(kf_prediction.exogenous_model_))
-{ }
+    exogenous_model_(std::move(kf_prediction.exogenous_model_)),
+    F_(std::move(kf_prediction.F_)),
+    Q_(std::move(kf_prediction.Q_)),
+    sparse_F_(kf_prediction.sparse_F_),
+    F_sparse_(std::move(kf_prediction.F_sparse_)),
+    valid_model_matrices_(kf_prediction.valid_model_matrices_),
+    model_revision_(kf_prediction.model_revision_),
+    FP_(std::move(kf_prediction.FP_))
+{
+    kf_prediction.valid_model_matrices_ = false;
+}
 
 
 KFPrediction::~KFPrediction() noexcept
@@ -39,15 +48,38 @@ void KFPrediction::predictStep(const GaussianMixture& prev_state, GaussianMixtur
 
     if (!getSkipState())
     {
-        /* Evaluate predicted mean
-           x_{k+1} = F_{k} x_{k}   */
-        MatrixXd F = state_model_->getStateTransitionMatrix();
-        pred_state.mean().noalias() = F * prev_state.mean();
-
-        /* Evaluate predicted covariance.
-           P_{k+1} = F_{k} * P_{k} * F_{k}' + Q */
-        for (size_t i=0; i < prev_state.components; i++)
-            pred_state.covariance(i).noalias() = F * prev_state.covariance(i) * F.transpose() + state_model_->getNoiseCovarianceMatrix();
+        updateModelMatrices();
+
+        if (sparse_F_)
+        {
+            /* Evaluate predicted mean
+               x_{k+1} = F_{k} x_{k}   */
+            pred_state.mean().noalias() = F_sparse_ * prev_state.mean();
+
+            /* Evaluate predicted covariance.
+               P_{k+1} = F_{k} * P_{k} * F_{k}' + Q */
+            for (size_t i=0; i < prev_state.components; i++)
+            {
+                FP_.noalias() = F_sparse_ * prev_state.covariance(i);
+                pred_state.covariance(i) = Q_;
+                pred_state.covariance(i).noalias() += FP_ * F_sparse_.transpose();
+            }
+        }
+        else
+        {
+            /* Evaluate predicted mean
+               x_{k+1} = F_{k} x_{k}   */
+            pred_state.mean().noalias() = F_ * prev_state.mean();
+
+            /* Evaluate predicted covariance.
+               P_{k+1} = F_{k} * P_{k} * F_{k}' + Q */
+            for (size_t i=0; i < prev_state.components; i++)
+            {
+                FP_.noalias() = F_ * prev_state.covariance(i);
+                pred_state.covariance(i) = Q_;
+                pred_state.covariance(i).noalias() += FP_ * F_.transpose();
+            }
+        }
     }
     else
     {
@@ -73,3 +105,21 @@ void KFPrediction::predictStep(const GaussianMixture& prev_state, GaussianMixtur
         }
     }
 }
+
+
+void KFPrediction::updateModelMatrices()
+{
+    bool cacheable;
+    std::size_t revision;
+    std::tie(cacheable, revision) = state_model_->getRevision();
+
+    if (cacheable && valid_model_matrices_ && (revision == model_revision_))
+        return;
+
+    F_ = state_model_->getStateTransitionMatrix();
+    Q_ = state_model_->getNoiseCovarianceMatrix();
+    std::tie(sparse_F_, F_sparse_) = state_model_->getSparseStateTransitionMatrix();
+
+    valid_model_matrices_ = cacheable;
+    model_revision_ = revision;
+}
@@ -1,4 +1,5 @@
 #include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/utils.h>
 
 #include <Eigen/Dense>
 
@@ -7,7 +8,12 @@ using namespace Eigen;
 
 
 LTIMeasurementModel::LTIMeasurementModel(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix)
-    : H_(measurement_matrix), R_(noise_covariance_matrix)
+    : LTIMeasurementModel(measurement_matrix, noise_covariance_matrix, utils::default_max_sparse_density)
+{ }
+
+
+LTIMeasurementModel::LTIMeasurementModel(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const double max_sparse_density)
+    : H_(measurement_matrix), R_(noise_covariance_matrix), max_sparse_density_(max_sparse_density)
 {
     if ((H_.rows() == 0) || (H_.cols() == 0))
         throw std::runtime_error("ERROR::LTIMEASUREMENTMODEL::CTOR\nERROR:\n\tMeasurement matrix dimensions cannot be 0.");
@@ -30,3 +36,41 @@ Eigen::MatrixXd LTIMeasurementModel::getMeasurementMatrix() const
 {
     return H_;
 }
+
+
+std::pair<bool, Eigen::SparseMatrix<double>> LTIMeasurementModel::getSparseMeasurementMatrix() const
+{
+    if (!valid_sparse_H_ || (sparse_revision_ != revision_))
+    {
+        sparse_H_ = utils::sparse_view(H_, max_sparse_density_);
+        sparse_revision_ = revision_;
+        valid_sparse_H_ = true;
+    }
+
+    return sparse_H_;
+}
+
+
+std::pair<bool, bfl::Data> LTIMeasurementModel::predictedMeasure(const Eigen::Ref<const Eigen::MatrixXd>& cur_states) const
+{
+    MatrixXd prediction = H_ * cur_states;
+    return std::make_pair(true, std::move(prediction));
+}
+
+
+void LTIMeasurementModel::enableRevisionTracking()
+{
+    revision_tracking_ = true;
+}
+
+
+void LTIMeasurementModel::disableRevisionTracking()
+{
+    revision_tracking_ = false;
+}
+
+
+std::pair<bool, std::size_t> LTIMeasurementModel::getRevision() const
+{
+    return std::make_pair(revision_tracking_, revision_);
+}
@@ -1,4 +1,5 @@
 #include <BayesFilters/LTIStateModel.h>
+#include <BayesFilters/utils.h>
 
 #include <Eigen/Dense>
 
@@ -7,7 +8,12 @@ using namespace Eigen;
 
 
 LTIStateModel::LTIStateModel(const Ref<const MatrixXd>& transition_matrix, const Ref<const MatrixXd>& noise_covariance_matrix) :
-    F_(transition_matrix), Q_(noise_covariance_matrix)
+    LTIStateModel(transition_matrix, noise_covariance_matrix, utils::default_max_sparse_density)
+{ }
+
+
+LTIStateModel::LTIStateModel(const Ref<const MatrixXd>& transition_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const double max_sparse_density) :
+    F_(transition_matrix), Q_(noise_covariance_matrix), max_sparse_density_(max_sparse_density)
 {
     if ((F_.rows() == 0) || (F_.cols() == 0))
         throw std::runtime_error("ERROR::LTISTATEMODEL::CTOR\nERROR:\n\tState transition matrix dimensions cannot be 0.");
@@ -40,6 +46,19 @@ Eigen::MatrixXd LTIStateModel::getStateTransitionMatrix()
 }
 
 
+std::pair<bool, Eigen::SparseMatrix<double>> LTIStateModel::getSparseStateTransitionMatrix()
+{
+    if (!valid_sparse_F_ || (sparse_revision_ != revision_))
+    {
+        sparse_F_ = utils::sparse_view(F_, max_sparse_density_);
+        sparse_revision_ = revision_;
+        valid_sparse_F_ = true;
+    }
+
+    return sparse_F_;
+}
+
+
 bool LTIStateModel::setProperty(const std::string& property)
 {
     return false;
@@ -50,3 +69,21 @@ Eigen::MatrixXd LTIStateModel::getJacobian()
 {
     return F_;
 }
+
+
+void LTIStateModel::enableRevisionTracking()
+{
+    revision_tracking_ = true;
+}
+
+
+void LTIStateModel::disableRevisionTracking()
+{
+    revision_tracking_ = false;
+}
+
+
+std::pair<bool, std::size_t> LTIStateModel::getRevision() const
+{
+    return std::make_pair(revision_tracking_, revision_);
+}
@@ -0,0 +1,48 @@
+#include <BayesFilters/LikelihoodModel.h>
+
+#include <limits>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+std::pair<bool, VectorXd> LikelihoodModel::logLikelihood
+(
+    const MeasurementModel& measurement_model,
+    const Ref<const MatrixXd>& pred_states
+)
+{
+    bool valid_likelihood;
+    VectorXd likelihood;
+    std::tie(valid_likelihood, likelihood) = this->likelihood(measurement_model, pred_states);
+
+    if (!valid_likelihood)
+        return std::make_pair(false, VectorXd::Zero(1));
+
+    return std::make_pair(true, (likelihood.array() + std::numeric_limits<double>::min()).log().matrix());
+}
+
+
+bool LikelihoodModel::hasPreparedLogLikelihood() const
+{
+    return false;
+}
+
+
+bool LikelihoodModel::prepareLogLikelihood(const MeasurementModel& measurement_model)
+{
+    static_cast<void>(measurement_model);
+    return true;
+}
+
+
+std::pair<bool, VectorXd> LikelihoodModel::preparedLogLikelihood
+(
+    const MeasurementModel& measurement_model,
+    const Ref<const MatrixXd>& pred_states
+) const
+{
+    static_cast<void>(measurement_model);
+    static_cast<void>(pred_states);
+    return std::make_pair(false, VectorXd::Zero(1));
+}
@@ -15,7 +15,26 @@ std::pair<bool, bfl::Data> LinearMeasurementModel::predictedMeasure(const Eigen:
 
 std::pair<bool, bfl::Data> LinearMeasurementModel::innovation(const bfl::Data& predicted_measurements, const bfl::Data& measurements) const
 {
-    MatrixXd innovation = -(any::any_cast<MatrixXd>(predicted_measurements).colwise() - any::any_cast<MatrixXd>(measurements).col(0));
+    MatrixXd innovation = any::any_cast<MatrixXd>(predicted_measurements);
+    const MatrixXd measurement = any::any_cast<MatrixXd>(measurements);
+
+    /* Compare all the predicted measurements with one measurement, or each predicted measurement with its own one. */
+    if (measurement.cols() == 1)
+        innovation = -(innovation.colwise() - measurement.col(0));
+    else
+        innovation = measurement - innovation;
 
     return std::make_pair(true, std::move(innovation));
 }
+
+
+std::pair<bool, Eigen::SparseMatrix<double>> LinearMeasurementModel::getSparseMeasurementMatrix() const
+{
+    return std::make_pair(false, SparseMatrix<double>());
+}
+
+
+std::pair<bool, std::size_t> LinearMeasurementModel::getRevision() const
+{
+    return std::make_pair(false, 0);
+}
@@ -10,3 +10,15 @@ void LinearStateModel::propagate(const Eigen::Ref<const Eigen::MatrixXd>& cur_st
 {
     pred_states = getStateTransitionMatrix() * cur_states;
 }
+
+
+std::pair<bool, Eigen::SparseMatrix<double>> LinearStateModel::getSparseStateTransitionMatrix()
+{
+    return std::make_pair(false, Eigen::SparseMatrix<double>());
+}
+
+
+std::pair<bool, std::size_t> LinearStateModel::getRevision() const
+{
+    return std::make_pair(false, 0);
+}
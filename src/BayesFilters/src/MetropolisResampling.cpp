@@ -0,0 +1,92 @@
+#include <BayesFilters/MetropolisResampling.h>
+#include <BayesFilters/utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+MetropolisResampling::MetropolisResampling(const unsigned int num_iterations, const unsigned int num_threads, const unsigned int seed) noexcept :
+    Resampling(seed),
+    num_iterations_(num_iterations),
+    num_threads_(std::max(1u, num_threads)) { }
+
+
+MetropolisResampling::MetropolisResampling(const unsigned int num_iterations, const unsigned int num_threads) noexcept :
+    MetropolisResampling(num_iterations, num_threads, 1) { }
+
+
+MetropolisResampling::MetropolisResampling(const unsigned int num_iterations) noexcept :
+    MetropolisResampling(num_iterations, std::thread::hardware_concurrency(), 1) { }
+
+
+MetropolisResampling::MetropolisResampling(MetropolisResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)),
+    num_iterations_(resampling.num_iterations_),
+    num_threads_(resampling.num_threads_) { }
+
+
+MetropolisResampling::~MetropolisResampling() noexcept { }
+
+
+MetropolisResampling& MetropolisResampling::operator=(MetropolisResampling&& resampling) noexcept
+{
+    if (this != &resampling)
+    {
+        Resampling::operator=(std::move(resampling));
+
+        num_iterations_ = resampling.num_iterations_;
+        num_threads_    = resampling.num_threads_;
+    }
+
+    return *this;
+}
+
+
+void MetropolisResampling::resample(const ParticleSet& cor_particles, ParticleSet& res_particles, Ref<VectorXi> res_parents)
+{
+    int num_particles = static_cast<int>(cor_particles.weight().rows());
+    std::size_t num_blocks = numberOfBlocks(num_particles);
+
+    /* Each block of particles uses its own generator, so that the result
+       does not depend on the number of threads. */
+    std::vector<std::mt19937_64::result_type> block_seed(num_blocks);
+    for (std::size_t b = 0; b < num_blocks; ++b)
+        block_seed[b] = generator_();
+
+    utils::parallel_for(num_threads_, num_blocks,
+                        [&](const std::size_t begin, const std::size_t end)
+                        {
+                            std::uniform_int_distribution<int> distribution_particle(0, num_particles - 1);
+                            std::uniform_real_distribution<double> distribution_acceptance(0.0, 1.0);
+
+                            for (std::size_t b = begin; b < end; ++b)
+                            {
+                                std::mt19937_64 block_generator(block_seed[b]);
+
+                                std::size_t first = b * cumsum_block_size_;
+                                std::size_t last  = std::min<std::size_t>(first + cumsum_block_size_, num_particles);
+
+                                for (std::size_t i = first; i < last; ++i)
+                                {
+                                    int k = static_cast<int>(i);
+
+                                    for (unsigned int t = 0; t < num_iterations_; ++t)
+                                    {
+                                        int j = distribution_particle(block_generator);
+
+                                        /* Accept with probability w_j / w_k, evaluated in log space. */
+                                        if (std::log(distribution_acceptance(block_generator)) <= cor_particles.weight(j) - cor_particles.weight(k))
+                                            k = j;
+                                    }
+
+                                    assignParent(cor_particles, res_particles, res_parents, i, k);
+                                }
+                            }
+                        });
+}
@@ -1,4 +1,8 @@
 #include <BayesFilters/PFCorrection.h>
+#include <BayesFilters/utils.h>
+
+#include <algorithm>
+#include <vector>
 
 using namespace bfl;
 using namespace Eigen;
@@ -23,3 +27,94 @@ bool PFCorrection::skip(const bool status)
 
     return true;
 }
+
+
+void PFCorrection::setNumberOfThreads(const std::size_t num_threads)
+{
+    num_threads_ = std::max<std::size_t>(1, num_threads);
+}
+
+
+void PFCorrection::setBlockSize(const std::size_t block_size)
+{
+    block_size_ = block_size;
+}
+
+
+std::size_t PFCorrection::getNumberOfThreads() const
+{
+    return num_threads_;
+}
+
+
+std::size_t PFCorrection::getBlockSize() const
+{
+    return block_size_;
+}
+
+
+std::pair<bool, VectorXd> PFCorrection::evaluateLogLikelihood(const Ref<const MatrixXd>& states)
+{
+    const std::size_t num_states = states.cols();
+
+    std::size_t block_size = block_size_;
+    if (block_size == 0)
+        block_size = (num_states + num_threads_ - 1) / num_threads_;
+
+    if (block_size >= num_states)
+        return getLikelihoodModel().logLikelihood(getMeasurementModel(), states);
+
+    /* Models without a const evaluation are called from all the threads, as they are. */
+    if (!getLikelihoodModel().hasPreparedLogLikelihood())
+        return evaluateBlocks(states, block_size, [this](const Ref<const MatrixXd>& block) { return getLikelihoodModel().logLikelihood(getMeasurementModel(), block); });
+
+    /* Otherwise, evaluate the quantities shared by all the blocks once, then hand the threads a const model. */
+    if (!getLikelihoodModel().prepareLogLikelihood(getMeasurementModel()))
+        return std::make_pair(false, VectorXd::Zero(1));
+
+    const LikelihoodModel& likelihood_model = getLikelihoodModel();
+    const MeasurementModel& measurement_model = getMeasurementModel();
+
+    return evaluateBlocks(states, block_size, [&likelihood_model, &measurement_model](const Ref<const MatrixXd>& block) { return likelihood_model.preparedLogLikelihood(measurement_model, block); });
+}
+
+
+std::pair<bool, VectorXd> PFCorrection::evaluateBlocks
+(
+    const Ref<const MatrixXd>& states,
+    const std::size_t block_size,
+    const std::function<std::pair<bool, VectorXd>(const Ref<const MatrixXd>&)>& block_log_likelihood
+)
+{
+    const std::size_t num_states = states.cols();
+    const std::size_t num_blocks = (num_states + block_size - 1) / block_size;
+
+    VectorXd log_likelihood(num_states);
+    std::vector<char> valid_blocks(num_blocks, false);
+
+    /* Each thread processes a contiguous range of blocks and writes
+       the log-likelihood of each block in a disjoint segment. */
+    utils::parallel_for(num_threads_, num_blocks,
+                        [&](const std::size_t begin, const std::size_t end)
+                        {
+                            for (std::size_t b = begin; b < end; ++b)
+                            {
+                                const std::size_t offset = b * block_size;
+                                const std::size_t size = std::min(block_size, num_states - offset);
+
+                                bool valid_block;
+                                VectorXd log_likelihood_block;
+                                std::tie(valid_block, log_likelihood_block) = block_log_likelihood(states.middleCols(offset, size));
+
+                                valid_blocks[b] = valid_block && (static_cast<std::size_t>(log_likelihood_block.size()) == size);
+
+                                if (valid_blocks[b])
+                                    log_likelihood.segment(offset, size) = log_likelihood_block;
+                            }
+                        });
+
+    if (std::find(valid_blocks.begin(), valid_blocks.end(), false) != valid_blocks.end())
+        return std::make_pair(false, VectorXd::Zero(1));
+
+    return std::make_pair(true, log_likelihood);
+}
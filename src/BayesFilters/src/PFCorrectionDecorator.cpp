@@ -41,6 +41,30 @@ std::pair<bool, VectorXd> PFCorrectionDecorator::getLikelihood()
 }
 
 
+void PFCorrectionDecorator::setNumberOfThreads(const std::size_t num_threads)
+{
+    correction_->setNumberOfThreads(num_threads);
+}
+
+
+void PFCorrectionDecorator::setBlockSize(const std::size_t block_size)
+{
+    correction_->setBlockSize(block_size);
+}
+
+
+std::size_t PFCorrectionDecorator::getNumberOfThreads() const
+{
+    return correction_->getNumberOfThreads();
+}
+
+
+std::size_t PFCorrectionDecorator::getBlockSize() const
+{
+    return correction_->getBlockSize();
+}
+
+
 LikelihoodModel& PFCorrectionDecorator::getLikelihoodModel()
 {
     return correction_->getLikelihoodModel();
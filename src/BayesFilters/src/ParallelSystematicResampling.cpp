@@ -0,0 +1,94 @@
+#include <BayesFilters/ParallelSystematicResampling.h>
+#include <BayesFilters/utils.h>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+ParallelSystematicResampling::ParallelSystematicResampling(const unsigned int num_threads, const unsigned int seed) noexcept :
+    Resampling(seed),
+    num_threads_(std::max(1u, num_threads)) { }
+
+
+ParallelSystematicResampling::ParallelSystematicResampling(const unsigned int num_threads) noexcept :
+    ParallelSystematicResampling(num_threads, 1) { }
+
+
+ParallelSystematicResampling::ParallelSystematicResampling() noexcept :
+    ParallelSystematicResampling(std::thread::hardware_concurrency(), 1) { }
+
+
+ParallelSystematicResampling::ParallelSystematicResampling(ParallelSystematicResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)),
+    num_threads_(resampling.num_threads_) { }
+
+
+ParallelSystematicResampling::~ParallelSystematicResampling() noexcept { }
+
+
+ParallelSystematicResampling& ParallelSystematicResampling::operator=(ParallelSystematicResampling&& resampling) noexcept
+{
+    if (this != &resampling)
+    {
+        Resampling::operator=(std::move(resampling));
+
+        num_threads_ = resampling.num_threads_;
+    }
+
+    return *this;
+}
+
+
+void ParallelSystematicResampling::resample(const ParticleSet& cor_particles, ParticleSet& res_particles, Ref<VectorXi> res_parents)
+{
+    int num_particles = static_cast<int>(cor_particles.weight().rows());
+    std::size_t num_blocks = numberOfBlocks(num_particles);
+
+    csw_.resize(num_particles);
+    block_sum_.resize(num_blocks);
+    block_offset_.resize(num_blocks);
+
+    /* Scan each block independently. */
+    utils::parallel_for(num_threads_, num_blocks,
+                        [&](const std::size_t begin, const std::size_t end)
+                        {
+                            for (std::size_t b = begin; b < end; ++b)
+                                block_sum_(b) = blockCumulativeSum(cor_particles.weight(), csw_, b);
+                        });
+
+    /* Evaluate the offset of each block, i.e. the total of the preceding blocks,
+       in the same order of the serial implementation. */
+    double offset = 0.0;
+    for (std::size_t b = 0; b < num_blocks; ++b)
+    {
+        block_offset_(b) = offset;
+        offset += block_sum_(b);
+    }
+
+    utils::parallel_for(num_threads_, num_blocks,
+                        [&](const std::size_t begin, const std::size_t end)
+                        {
+                            for (std::size_t b = begin; b < end; ++b)
+                                blockOffset(csw_, b, block_offset_(b));
+                        });
+
+    std::uniform_real_distribution<double> distribution_res(0.0, 1.0/num_particles);
+    double u_1 = distribution_res(generator_);
+
+    /* Partitioned search of the parents. */
+    utils::parallel_for(num_threads_, num_particles,
+                        [&](const std::size_t begin, const std::size_t end)
+                        {
+                            systematicSelection(cor_particles, res_particles, res_parents, csw_, u_1, begin, end);
+                        });
+}
+
+
+unsigned int ParallelSystematicResampling::getNumberOfThreads() const
+{
+    return num_threads_;
+}
@@ -1,5 +1,7 @@
 #include <BayesFilters/ParticleSet.h>
 
+#include <utility>
+
 using namespace bfl;
 using namespace Eigen;
 
@@ -14,8 +16,19 @@ ParticleSet::ParticleSet
     const std::size_t dim_linear,
     const std::size_t dim_circular
 ) noexcept :
-    GaussianMixture(components, dim_linear, dim_circular),
-    state_(dim, components) { }
+    ParticleSet(components, dim_linear, dim_circular, true) { }
+
+
+ParticleSet::ParticleSet
+(
+    const std::size_t components,
+    const std::size_t dim_linear,
+    const std::size_t dim_circular,
+    const bool gaussian_belief
+) noexcept :
+    GaussianMixture(components, dim_linear, dim_circular, gaussian_belief),
+    state_(dim, components),
+    gaussian_belief_(gaussian_belief) { }
 
 
 ParticleSet::~ParticleSet() noexcept { }
@@ -24,17 +37,21 @@ ParticleSet::~ParticleSet() noexcept { }
 ParticleSet& ParticleSet::operator+=(const ParticleSet& rhs)
 {
     /* Should check whether (this->dim_linear == rhs.dim_linear) &&
-       (this->dim_circular == rhs.dim_circular). */
+       (this->dim_circular == rhs.dim_circular) &&
+       (this->gaussian_belief_ == rhs.gaussian_belief_). */
     std::size_t new_components = components + rhs.components;
 
     state_.conservativeResize(NoChange,  new_components);
     state_.rightCols(rhs.components) = rhs.state_;
 
-    mean_.conservativeResize(NoChange,  new_components);
-    mean_.rightCols(rhs.components) = rhs.mean_;
+    if (gaussian_belief_)
+    {
+        mean_.conservativeResize(NoChange,  new_components);
+        mean_.rightCols(rhs.components) = rhs.mean_;
 
-    covariance_.conservativeResize(NoChange, dim * new_components);
-    covariance_.rightCols(dim * rhs.components) = rhs.covariance_;
+        covariance_.conservativeResize(NoChange, dim * new_components);
+        covariance_.rightCols(dim * rhs.components) = rhs.covariance_;
+    }
 
     weight_.conservativeResize(new_components);
     weight_.tail(rhs.components) = rhs.weight_;
@@ -43,6 +60,23 @@ ParticleSet& ParticleSet::operator+=(const ParticleSet& rhs)
 }
 
 
+void ParticleSet::swap(ParticleSet& other) noexcept
+{
+    std::swap(components, other.components);
+    std::swap(dim, other.dim);
+    std::swap(dim_linear, other.dim_linear);
+    std::swap(dim_circular, other.dim_circular);
+    std::swap(dim_noise, other.dim_noise);
+
+    state_.swap(other.state_);
+    mean_.swap(other.mean_);
+    covariance_.swap(other.covariance_);
+    weight_.swap(other.weight_);
+
+    std::swap(gaussian_belief_, other.gaussian_belief_);
+}
+
+
 ParticleSet operator+(ParticleSet lhs, const ParticleSet& rhs)
 {
     lhs += rhs;
@@ -84,3 +118,9 @@ const double& ParticleSet::state(const std::size_t i, const std::size_t j) const
 {
     return state_(j, i);
 }
+
+
+bool ParticleSet::hasGaussianBelief() const
+{
+    return gaussian_belief_;
+}
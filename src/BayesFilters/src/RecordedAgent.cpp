@@ -0,0 +1,60 @@
+#include <BayesFilters/RecordedAgent.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+RecordedAgent::RecordedAgent(std::vector<Data> recording) noexcept :
+    recording_(std::move(recording))
+{ }
+
+
+RecordedAgent::RecordedAgent(const Ref<const MatrixXd>& recording) noexcept
+{
+    recording_.reserve(recording.cols());
+
+    for (Index i = 0; i < recording.cols(); i++)
+        recording_.emplace_back(MatrixXd(recording.col(i)));
+}
+
+
+RecordedAgent::~RecordedAgent() noexcept
+{ }
+
+
+bool RecordedAgent::bufferData()
+{
+    if (buffered_ == recording_.size())
+        return false;
+
+    ++buffered_;
+
+    return true;
+}
+
+
+Data RecordedAgent::getData() const
+{
+    if (buffered_ == 0)
+        return Data();
+
+    return recording_[buffered_ - 1];
+}
+
+
+bool RecordedAgent::setProperty(const std::string& property)
+{
+    if (property == "reset")
+    {
+        buffered_ = 0;
+        return true;
+    }
+
+    return false;
+}
+
+
+std::size_t RecordedAgent::getLength() const
+{
+    return recording_.size();
+}
@@ -0,0 +1,66 @@
+#include <BayesFilters/ReplayRunner.h>
+
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+using namespace bfl;
+
+
+ReplayRunner::ReplayRunner(FilteringAlgorithm& filter) noexcept :
+    filter_(filter)
+{ }
+
+
+ReplayRunner::Report ReplayRunner::run()
+{
+    return run(std::numeric_limits<std::size_t>::max());
+}
+
+
+ReplayRunner::Report ReplayRunner::run(const std::size_t max_steps)
+{
+    {
+        std::lock_guard<std::mutex> lk(filter_.mtx_run_);
+        if (filter_.filtering_thread_.joinable() || filter_.executor_ || filter_.run_)
+            throw std::runtime_error("ERROR::REPLAYRUNNER::RUN\nERROR:\n\tThe filter has been booted. Wait for it before replaying.");
+    }
+
+    Report report;
+
+    auto start = std::chrono::steady_clock::now();
+
+    /* As in the threaded recursion, a pending reset() is superseded by the initialization,
+       while a filter torn down before the replay initializes but runs no step. */
+    filter_.reset_ = false;
+    filter_.filtering_step_ = 0;
+    filter_.initialization();
+
+    while ((report.steps < max_steps) && filter_.runCondition() && !filter_.teardown_)
+    {
+        {
+#if defined(BFL_INSTRUMENTATION)
+            FilteringStatistics::ScopedTimer timer(filter_.statistics_, FilteringStatistics::Phase::Step);
+#endif
+            filter_.filteringStep();
+        }
+
+        ++filter_.filtering_step_;
+        ++report.steps;
+
+        if (filter_.reset_)
+        {
+            filter_.reset_ = false;
+            filter_.filtering_step_ = 0;
+            filter_.initialization();
+        }
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+
+    report.seconds = std::chrono::duration<double>(stop - start).count();
+    if (report.seconds > 0.0)
+        report.steps_per_second = report.steps / report.seconds;
+
+    return report;
+}
@@ -1,5 +1,6 @@
 #include <BayesFilters/Resampling.h>
 
+#include <algorithm>
 #include <utility>
 
 using namespace bfl;
@@ -54,33 +55,143 @@ void Resampling::resample(const ParticleSet& cor_particles, ParticleSet& res_par
                           Ref<VectorXi> res_parents)
 {
     int num_particles = static_cast<int>(cor_particles.weight().rows());
-    VectorXd csw(num_particles);
-
-    csw(0) = exp(cor_particles.weight(0));
-    for (int i = 1; i < num_particles; ++i)
-        csw(i) = csw(i-1) + exp(cor_particles.weight(i));
+    csw_.resize(num_particles);
+    cumulativeSum(cor_particles.weight(), csw_);
 
     std::uniform_real_distribution<double> distribution_res(0.0, 1.0/num_particles);
     double u_1 = distribution_res(generator_);
 
-    int idx_csw = 0;
-    for (int j = 0; j < num_particles; ++j)
+    systematicSelection(cor_particles, res_particles, res_parents, csw_, u_1, 0, num_particles);
+}
+
+
+double Resampling::neff(const Ref<const VectorXd>& cor_weights)
+{
+    return 1.0/cor_weights.array().exp().square().sum();
+}
+
+
+const std::size_t Resampling::cumsum_block_size_;
+
+
+std::size_t Resampling::numberOfBlocks(const std::size_t num_particles) const
+{
+    return (num_particles + cumsum_block_size_ - 1) / cumsum_block_size_;
+}
+
+
+void Resampling::cumulativeSum(const Ref<const VectorXd>& cor_weights, Ref<VectorXd> csw) const
+{
+    cumulativeSum(cor_weights, csw, true);
+}
+
+
+void Resampling::cumulativeSum(const Ref<const VectorXd>& cor_weights, Ref<VectorXd> csw, const bool log_weights) const
+{
+    double offset = 0.0;
+    for (std::size_t b = 0; b < numberOfBlocks(cor_weights.size()); ++b)
+    {
+        double block_sum = blockCumulativeSum(cor_weights, csw, b, log_weights);
+
+        blockOffset(csw, b, offset);
+
+        offset += block_sum;
+    }
+}
+
+
+double Resampling::blockCumulativeSum(const Ref<const VectorXd>& cor_weights, Ref<VectorXd> csw, const std::size_t block) const
+{
+    return blockCumulativeSum(cor_weights, csw, block, true);
+}
+
+
+double Resampling::blockCumulativeSum(const Ref<const VectorXd>& cor_weights, Ref<VectorXd> csw, const std::size_t block, const bool log_weights) const
+{
+    std::size_t begin = block * cumsum_block_size_;
+    std::size_t end   = std::min<std::size_t>(begin + cumsum_block_size_, cor_weights.size());
+
+    if (log_weights)
+    {
+        csw(begin) = exp(cor_weights(begin));
+        for (std::size_t i = begin + 1; i < end; ++i)
+            csw(i) = csw(i-1) + exp(cor_weights(i));
+    }
+    else
+    {
+        csw(begin) = cor_weights(begin);
+        for (std::size_t i = begin + 1; i < end; ++i)
+            csw(i) = csw(i-1) + cor_weights(i);
+    }
+
+    return csw(end - 1);
+}
+
+
+void Resampling::blockOffset(Ref<VectorXd> csw, const std::size_t block, const double offset) const
+{
+    /* The first block has no preceding blocks. */
+    if (block == 0)
+        return;
+
+    std::size_t begin = block * cumsum_block_size_;
+    std::size_t size  = std::min<std::size_t>(cumsum_block_size_, csw.size() - begin);
+
+    csw.segment(begin, size).array() += offset;
+}
+
+
+void Resampling::systematicSelection
+(
+    const ParticleSet& cor_particles,
+    ParticleSet& res_particles,
+    Ref<VectorXi> res_parents,
+    const Ref<const VectorXd>& csw,
+    const double u_1,
+    const std::size_t begin,
+    const std::size_t end
+) const
+{
+    if (begin >= end)
+        return;
+
+    int num_particles = static_cast<int>(csw.size());
+
+    /* Locate the parent of the first particle of the range with a binary search,
+       i.e. the first index such that u_begin <= csw(idx_csw).
+       The result is the same index the serial scan would reach. */
+    double u_begin = u_1 + static_cast<double>(begin)/num_particles;
+    int idx_csw = static_cast<int>(std::lower_bound(csw.data(), csw.data() + num_particles - 1, u_begin) - csw.data());
+
+    for (std::size_t j = begin; j < end; ++j)
     {
         double u_j = u_1 + static_cast<double>(j)/num_particles;
 
         while (u_j > csw(idx_csw) && idx_csw < (num_particles - 1))
             idx_csw += 1;
 
-        res_particles.state(j) = cor_particles.state(idx_csw);
-        res_particles.mean(j) = cor_particles.mean(idx_csw);
-        res_particles.covariance(j) = cor_particles.covariance(idx_csw);
-        res_particles.weight(j) = -log(num_particles);
-        res_parents(j) = idx_csw;
+        assignParent(cor_particles, res_particles, res_parents, j, idx_csw);
     }
 }
 
 
-double Resampling::neff(const Ref<const VectorXd>& cor_weights)
+void Resampling::assignParent
+(
+    const ParticleSet& cor_particles,
+    ParticleSet& res_particles,
+    Ref<VectorXi> res_parents,
+    const std::size_t j,
+    const int parent
+) const
 {
-    return 1.0/cor_weights.array().exp().square().sum();
+    res_particles.state(j) = cor_particles.state(parent);
+
+    if (cor_particles.hasGaussianBelief() && res_particles.hasGaussianBelief())
+    {
+        res_particles.mean(j) = cor_particles.mean(parent);
+        res_particles.covariance(j) = cor_particles.covariance(parent);
+    }
+
+    res_particles.weight(j) = -log(static_cast<double>(cor_particles.weight().size()));
+    res_parents(j) = parent;
 }
@@ -57,21 +57,25 @@ void ResamplingWithPrior::resample(const ParticleSet& cor_particles, ParticleSet
     int num_resample_particles = cor_particles.state().cols() - num_prior_particles;
 
     /* Consider two subsets of particles. */
-    ParticleSet res_particles_left(num_prior_particles, cor_particles.dim_linear, cor_particles.dim_circular);
-    ParticleSet res_particles_right(num_resample_particles, cor_particles.dim_linear, cor_particles.dim_circular);
+    ParticleSet res_particles_left(num_prior_particles, cor_particles.dim_linear, cor_particles.dim_circular, cor_particles.hasGaussianBelief());
+    ParticleSet res_particles_right(num_resample_particles, cor_particles.dim_linear, cor_particles.dim_circular, cor_particles.hasGaussianBelief());
     Ref<VectorXi> res_parents_right(res_parents.tail(num_resample_particles));
 
     /* Copy particles to be resampled in a temporary. */
-    ParticleSet tmp_particles(num_resample_particles, cor_particles.dim_linear, cor_particles.dim_circular);
+    ParticleSet tmp_particles(num_resample_particles, cor_particles.dim_linear, cor_particles.dim_circular, cor_particles.hasGaussianBelief());
     int j = 0;
     for (std::size_t i : sort_indices(cor_particles.weight().array().exp()))
     {
         if (j >= num_prior_particles)
         {
             tmp_particles.state(j - num_prior_particles) = cor_particles.state(i);
-            tmp_particles.mean(j - num_prior_particles) = cor_particles.mean(i);
-            tmp_particles.covariance(j - num_prior_particles) = cor_particles.covariance(i);
             tmp_particles.weight(j - num_prior_particles) = cor_particles.weight(i);
+
+            if (cor_particles.hasGaussianBelief())
+            {
+                tmp_particles.mean(j - num_prior_particles) = cor_particles.mean(i);
+                tmp_particles.covariance(j - num_prior_particles) = cor_particles.covariance(i);
+            }
         }
         j++;
     }
@@ -0,0 +1,75 @@
+#include <BayesFilters/ResidualResampling.h>
+
+#include <cmath>
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+ResidualResampling::ResidualResampling(const unsigned int seed) noexcept :
+    Resampling(seed) { }
+
+
+ResidualResampling::ResidualResampling() noexcept :
+    ResidualResampling(1) { }
+
+
+ResidualResampling::ResidualResampling(ResidualResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)) { }
+
+
+ResidualResampling::~ResidualResampling() noexcept { }
+
+
+ResidualResampling& ResidualResampling::operator=(ResidualResampling&& resampling) noexcept
+{
+    Resampling::operator=(std::move(resampling));
+
+    return *this;
+}
+
+
+void ResidualResampling::resample(const ParticleSet& cor_particles, ParticleSet& res_particles, Ref<VectorXi> res_parents)
+{
+    int num_particles = static_cast<int>(cor_particles.weight().rows());
+    residual_weights_.resize(num_particles);
+    csw_.resize(num_particles);
+
+    /* Deterministic replication of floor(N * w_i) copies. */
+    residual_weights_ = cor_particles.weight().array().exp() * num_particles;
+
+    int j = 0;
+    for (int i = 0; i < num_particles; ++i)
+    {
+        const double copies = std::floor(residual_weights_(i));
+
+        for (int c = 0; c < static_cast<int>(copies) && j < num_particles; ++c, ++j)
+            assignParent(cor_particles, res_particles, res_parents, j, i);
+
+        residual_weights_(i) -= copies;
+    }
+
+    int num_residuals = num_particles - j;
+    if (num_residuals == 0)
+        return;
+
+    /* Systematic resampling of the residuals, whose cumulative sum is normalized afterwards.
+       The residuals are in the linear domain. */
+    cumulativeSum(residual_weights_, csw_, false);
+    csw_ /= csw_(num_particles - 1);
+
+    std::uniform_real_distribution<double> distribution_res(0.0, 1.0/num_residuals);
+    double u_1 = distribution_res(generator_);
+
+    int idx_csw = 0;
+    for (int r = 0; r < num_residuals; ++r, ++j)
+    {
+        double u_r = u_1 + static_cast<double>(r)/num_residuals;
+
+        while (u_r > csw_(idx_csw) && idx_csw < (num_particles - 1))
+            idx_csw += 1;
+
+        assignParent(cor_particles, res_particles, res_parents, j, idx_csw);
+    }
+}
@@ -1,8 +1,10 @@
 #include <BayesFilters/SIS.h>
+#include <BayesFilters/directional_statistics.h>
 #include <BayesFilters/utils.h>
 
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 
 #include <Eigen/Dense>
@@ -19,13 +21,30 @@ SIS::SIS
     std::unique_ptr<ParticleSetInitialization> initialization,
     std::unique_ptr<PFPrediction> prediction,
     std::unique_ptr<PFCorrection> correction,
-    std::unique_ptr<Resampling> resampling
+    std::unique_ptr<Resampling> resampling,
+    const bool gaussian_belief
 ) noexcept :
     ParticleFilter(std::move(initialization), std::move(prediction), std::move(correction), std::move(resampling)),
     num_particle_(num_particle),
     state_size_(state_size_linear + state_size_circular),
-    pred_particle_(num_particle_, state_size_linear, state_size_circular),
-    cor_particle_(num_particle_, state_size_linear, state_size_circular)
+    pred_particle_(num_particle_, state_size_linear, state_size_circular, gaussian_belief),
+    cor_particle_(num_particle_, state_size_linear, state_size_circular, gaussian_belief),
+    res_particle_(num_particle_, state_size_linear, state_size_circular, gaussian_belief),
+    res_parent_(num_particle_)
+{ }
+
+
+SIS::SIS
+(
+    unsigned int num_particle,
+    std::size_t state_size_linear,
+    std::size_t state_size_circular,
+    std::unique_ptr<ParticleSetInitialization> initialization,
+    std::unique_ptr<PFPrediction> prediction,
+    std::unique_ptr<PFCorrection> correction,
+    std::unique_ptr<Resampling> resampling
+) noexcept :
+    SIS(num_particle, state_size_linear, state_size_circular, std::move(initialization), std::move(prediction), std::move(correction), std::move(resampling), true)
 { }
 
 
@@ -48,10 +67,16 @@ SIS::~SIS() noexcept
 
 SIS::SIS(SIS&& sir_pf) noexcept :
     ParticleFilter(std::move(sir_pf)),
+    num_particle_(sir_pf.num_particle_),
+    state_size_(sir_pf.state_size_),
     pred_particle_(std::move(sir_pf.pred_particle_)),
     cor_particle_(std::move(sir_pf.cor_particle_)),
-    num_particle_(sir_pf.num_particle_),
-    state_size_(sir_pf.state_size_)
+    res_particle_(std::move(sir_pf.res_particle_)),
+    res_parent_(std::move(sir_pf.res_parent_)),
+    publisher_(std::move(sir_pf.publisher_)),
+    publish_belief_(sir_pf.publish_belief_),
+    publication_weight_(std::move(sir_pf.publication_weight_)),
+    publication_estimate_(std::move(sir_pf.publication_estimate_))
 { }
 
 
@@ -67,6 +92,18 @@ SIS& SIS::operator=(SIS&& sir_pf) noexcept
 
     cor_particle_ = std::move(sir_pf.cor_particle_);
 
+    res_particle_ = std::move(sir_pf.res_particle_);
+
+    res_parent_ = std::move(sir_pf.res_parent_);
+
+    publisher_ = std::move(sir_pf.publisher_);
+
+    publish_belief_ = sir_pf.publish_belief_;
+
+    publication_weight_ = std::move(sir_pf.publication_weight_);
+
+    publication_estimate_ = std::move(sir_pf.publication_estimate_);
+
     return *this;
 }
 
@@ -80,24 +117,87 @@ bool SIS::initialization()
 void SIS::filteringStep()
 {
     if (getFilteringStep() != 0)
+    {
+        BFL_STATISTICS_SCOPE(Prediction);
         prediction_->predict(cor_particle_, pred_particle_);
+    }
+
+    {
+        BFL_STATISTICS_SCOPE(Correction);
+        correction_->correct(pred_particle_, cor_particle_);
+    }
 
-    correction_->correct(pred_particle_, cor_particle_);
+    {
+        BFL_STATISTICS_SCOPE(Normalization);
 
-    /* Normalize weights using LogSumExp. */
-    cor_particle_.weight().array() -= utils::log_sum_exp(cor_particle_.weight());
+        /* Normalize weights using LogSumExp. */
+        cor_particle_.weight().array() -= utils::log_sum_exp(cor_particle_.weight());
+    }
 
-    log();
+    {
+        BFL_STATISTICS_SCOPE(Logging);
+        log();
+    }
+
+    const double neff = resampling_->neff(cor_particle_.weight());
+    BFL_STATISTICS(statistics_.recordEffectiveSampleSize(neff));
 
-    if (resampling_->neff(cor_particle_.weight()) < static_cast<double>(num_particle_)/3.0)
+    if (neff < static_cast<double>(num_particle_)/3.0)
     {
-        ParticleSet res_particle(num_particle_, state_size_);
-        VectorXi res_parent(num_particle_, 1);
+        BFL_STATISTICS_SCOPE(Resampling);
+        BFL_STATISTICS(statistics_.recordResampling());
 
-        resampling_->resample(cor_particle_, res_particle, res_parent);
+        resampling_->resample(cor_particle_, res_particle_, res_parent_);
 
-        cor_particle_ = res_particle;
+        /* Exchange buffers instead of copying the resampled particles. */
+        cor_particle_.swap(res_particle_);
     }
+
+    if (publisher_)
+        publish();
+}
+
+
+void SIS::enablePublication(const bool full_belief)
+{
+    if (full_belief)
+        publisher_ = utils::make_unique<EstimatePublisher>(state_size_, cor_particle_);
+    else
+        publisher_ = utils::make_unique<EstimatePublisher>(state_size_);
+
+    publish_belief_ = full_belief;
+
+    publication_weight_.resize(num_particle_);
+    publication_estimate_.resize(state_size_);
+}
+
+
+const EstimatePublisher& SIS::getPublisher() const
+{
+    if (!publisher_)
+        throw std::runtime_error("ERROR::SIS::GETPUBLISHER\nERROR:\n\tPublication not enabled. Call SIS::enablePublication() first.");
+
+    return *publisher_;
+}
+
+
+void SIS::publish()
+{
+    /* Weighted mean of the particles, using the directional mean for the circular components. */
+    publication_weight_ = cor_particle_.weight().array().exp();
+
+    const std::size_t dim_linear = cor_particle_.dim_linear;
+    const std::size_t dim_circular = cor_particle_.dim_circular;
+
+    publication_estimate_.head(dim_linear).noalias() = cor_particle_.state().topRows(dim_linear) * publication_weight_;
+
+    if (dim_circular > 0)
+        directional_statistics::directional_mean(cor_particle_.state().bottomRows(dim_circular), publication_weight_, publication_estimate_.tail(dim_circular));
+
+    if (publish_belief_)
+        publisher_->publish(getFilteringStep(), publication_estimate_, cor_particle_);
+    else
+        publisher_->publish(getFilteringStep(), publication_estimate_);
 }
 
 
@@ -0,0 +1,202 @@
+#include <BayesFilters/SRUKFCorrection.h>
+#include <BayesFilters/directional_statistics.h>
+
+using namespace bfl;
+using namespace bfl::directional_statistics;
+using namespace bfl::sigma_point;
+using namespace Eigen;
+
+
+SRUKFCorrection::SRUKFCorrection
+(
+    std::unique_ptr<AdditiveMeasurementModel> measurement_model,
+    const size_t n,
+    const double alpha,
+    const double beta,
+    const double kappa
+) noexcept :
+    SRUKFCorrection(std::move(measurement_model), UTWeight(n, alpha, beta, kappa))
+{ }
+
+
+SRUKFCorrection::SRUKFCorrection
+(
+    std::unique_ptr<AdditiveMeasurementModel> measurement_model,
+    const UTWeight& ut_weight
+) noexcept :
+    SRUKFCorrection(std::move(measurement_model), ut_weight, std::make_shared<SquareRootCovariance>())
+{ }
+
+
+SRUKFCorrection::SRUKFCorrection
+(
+    std::unique_ptr<AdditiveMeasurementModel> measurement_model,
+    const UTWeight& ut_weight,
+    std::shared_ptr<SquareRootCovariance> square_root
+) noexcept :
+    measurement_model_(std::move(measurement_model)),
+    ut_weight_(ut_weight),
+    square_root_(square_root)
+{ }
+
+
+SRUKFCorrection::SRUKFCorrection(SRUKFCorrection&& srukf_correction) noexcept :
+    measurement_model_(std::move(srukf_correction.measurement_model_)),
+    ut_weight_(srukf_correction.ut_weight_),
+    ut_workspace_(std::move(srukf_correction.ut_workspace_)),
+    square_root_(std::move(srukf_correction.square_root_)),
+    noise_covariance_(std::move(srukf_correction.noise_covariance_)),
+    sqrt_noise_(std::move(srukf_correction.sqrt_noise_)),
+    predicted_measurement_(std::move(srukf_correction.predicted_measurement_)),
+    sqrt_meas_covariance_(std::move(srukf_correction.sqrt_meas_covariance_)),
+    cross_covariance_(std::move(srukf_correction.cross_covariance_)),
+    gain_(std::move(srukf_correction.gain_))
+{ }
+
+
+SRUKFCorrection::~SRUKFCorrection() noexcept
+{ }
+
+
+MeasurementModel& SRUKFCorrection::getMeasurementModel()
+{
+    return *measurement_model_;
+}
+
+
+void SRUKFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixture& corr_state)
+{
+    /* Get the current measurement if available. */
+    bool valid_measurement;
+    Data measurement;
+    std::tie(valid_measurement, measurement) = measurement_model_->measure();
+
+    if (!valid_measurement)
+    {
+        corr_state = pred_state;
+        return;
+    }
+
+    /* Sample the sigma points using the square roots of the covariance matrices of the predicted state. */
+    square_root_->factorize(pred_state);
+    sigma_point::sigma_point(pred_state, square_root_->factor(), ut_weight_, ut_workspace_);
+
+    /* Propagate the sigma points through the measurement model. */
+    bool valid_prediction;
+    Data prediction;
+    std::tie(valid_prediction, prediction) = measurement_model_->predictedMeasure(ut_workspace_.input_sigma_points);
+
+    if (!valid_prediction)
+    {
+        corr_state = pred_state;
+        return;
+    }
+
+    /* The measurement model returns its own matrix, which replaces the buffer of the workspace. */
+    ut_workspace_.prop_sigma_points = any::any_cast<MatrixXd&&>(std::move(prediction));
+
+    /* The square root of the noise covariance matrix is evaluated only if the matrix changes. */
+    MatrixXd noise_covariance;
+    std::tie(std::ignore, noise_covariance) = measurement_model_->getNoiseCovarianceMatrix();
+    if ((noise_covariance.rows() != noise_covariance_.rows()) || (noise_covariance.cols() != noise_covariance_.cols()) || (noise_covariance != noise_covariance_))
+    {
+        noise_covariance_ = std::move(noise_covariance);
+        sqrt_noise_.resize(noise_covariance_.rows(), noise_covariance_.cols());
+        square_root(noise_covariance_, sqrt_noise_);
+    }
+
+    /* Evaluate the mean of the predicted measurements. */
+    std::pair<std::size_t, std::size_t> meas_sizes = measurement_model_->getOutputSize();
+    std::size_t meas_size = meas_sizes.first + meas_sizes.second;
+    const std::size_t base = ut_weight_.mean.size();
+
+    predicted_measurement_.resize(meas_size, pred_state.components);
+    for (std::size_t i = 0; i < pred_state.components; i++)
+    {
+        Ref<MatrixXd> prop_sigma_points_i = ut_workspace_.prop_sigma_points.middleCols(base * i, base);
+
+        predicted_measurement_.col(i).topRows(meas_sizes.first).noalias() = prop_sigma_points_i.topRows(meas_sizes.first) * ut_weight_.mean;
+        if (meas_sizes.second > 0)
+            predicted_measurement_.col(i).bottomRows(meas_sizes.second) = directional_mean(prop_sigma_points_i.bottomRows(meas_sizes.second), ut_weight_.mean);
+    }
+
+    /* Evaluate the innovation if possible. */
+    bool valid_innovation;
+    Data innovation;
+    std::tie(valid_innovation, innovation) = measurement_model_->innovation(predicted_measurement_, measurement);
+
+    if (!valid_innovation)
+    {
+        corr_state = pred_state;
+        return;
+    }
+
+    /* Cast innovations once for all. */
+    MatrixXd innovations = any::any_cast<MatrixXd&&>(std::move(innovation));
+
+    /* Process all the components of the mixture. */
+    sqrt_meas_covariance_.resize(meas_size, meas_size);
+    cross_covariance_.resize(pred_state.dim, meas_size);
+    for (std::size_t i = 0; i < pred_state.components; i++)
+    {
+        Ref<MatrixXd> input_sigma_points_i = ut_workspace_.input_sigma_points.middleCols(base * i, base);
+        Ref<MatrixXd> prop_sigma_points_i = ut_workspace_.prop_sigma_points.middleCols(base * i, base);
+
+        /* Evaluate the deviations from the means. */
+        prop_sigma_points_i.topRows(meas_sizes.first).colwise() -= predicted_measurement_.col(i).topRows(meas_sizes.first);
+        if (meas_sizes.second > 0)
+            directional_sub(prop_sigma_points_i.bottomRows(meas_sizes.second), predicted_measurement_.col(i).bottomRows(meas_sizes.second), prop_sigma_points_i.bottomRows(meas_sizes.second));
+
+        input_sigma_points_i.topRows(pred_state.dim_linear).colwise() -= pred_state.mean(i).topRows(pred_state.dim_linear);
+        if (pred_state.dim_circular > 0)
+            directional_sub(input_sigma_points_i.bottomRows(pred_state.dim_circular), pred_state.mean(i).bottomRows(pred_state.dim_circular), input_sigma_points_i.bottomRows(pred_state.dim_circular));
+
+        /* Evaluate the square root Sy of the covariance matrix of the predicted measurement
+           and the cross covariance matrix Pxy. */
+        triangular_square_root(prop_sigma_points_i, ut_weight_.covariance, sqrt_noise_, sqrt_meas_covariance_, ut_workspace_);
+
+        ut_workspace_.weighted_sigma_points.noalias() = input_sigma_points_i * ut_weight_.covariance.asDiagonal();
+        cross_covariance_.noalias() = ut_workspace_.weighted_sigma_points * prop_sigma_points_i.transpose();
+
+        /* Evaluate U' = Sy^{-1} * Pxy' and the Kalman gain
+           K = Pxy * (Sy * Sy')^{-1} = U * Sy^{-1}, as K' = Sy'^{-1} * U'. */
+        gain_ = sqrt_meas_covariance_.triangularView<Lower>().solve(cross_covariance_.transpose());
+        cross_covariance_.transpose() = gain_;
+        sqrt_meas_covariance_.transpose().triangularView<Upper>().solveInPlace(gain_);
+
+        /* Evaluate the filtered mean.
+           x_{k}+ = x{k}- + K * innovation */
+        corr_state.mean(i) = pred_state.mean(i) + gain_.transpose() * innovations.col(i);
+
+        /* Evaluate the square root of the filtered covariance
+           P_{k}+ = P_{k}- - U * U'
+           using one rank-one downdate per column of U, now stored in cross_covariance_. */
+        Ref<MatrixXd> sqrt_covariance = square_root_->factor(i);
+        bool valid_downdate = true;
+        for (std::size_t j = 0; (j < meas_size) && valid_downdate; j++)
+        {
+            ut_workspace_.update_vector = cross_covariance_.col(j);
+            valid_downdate = cholesky_update(sqrt_covariance, ut_workspace_.update_vector, -1.0);
+        }
+
+        if (!valid_downdate)
+        {
+            /* Fall back to the square root of the whole matrix. */
+            MatrixXd covariance = pred_state.covariance(i);
+            covariance.noalias() -= cross_covariance_ * cross_covariance_.transpose();
+
+            MatrixXd sqrt_whole_covariance(pred_state.dim, pred_state.dim);
+            square_root(covariance, sqrt_whole_covariance);
+            triangular_square_root(sqrt_whole_covariance, VectorXd::Ones(pred_state.dim), MatrixXd(pred_state.dim, 0), sqrt_covariance, ut_workspace_);
+        }
+    }
+
+    corr_state.weight() = pred_state.weight();
+    square_root_->assign(corr_state);
+}
+
+
+std::pair<bool, Eigen::VectorXd> SRUKFCorrection::likelihood(const Eigen::Ref<const Eigen::MatrixXd>& innovations)
+{
+    throw std::runtime_error("ERROR::SRUKFCORRECTION::LIKELIHOOD\nERROR:\n\tMethod not implemented.");
+}
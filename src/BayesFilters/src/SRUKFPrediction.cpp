@@ -0,0 +1,143 @@
+#include <BayesFilters/SRUKFPrediction.h>
+#include <BayesFilters/directional_statistics.h>
+
+using namespace bfl;
+using namespace bfl::directional_statistics;
+using namespace bfl::sigma_point;
+using namespace Eigen;
+
+
+SRUKFPrediction::SRUKFPrediction
+(
+    std::unique_ptr<AdditiveStateModel> state_model,
+    const size_t n,
+    const double alpha,
+    const double beta,
+    const double kappa
+) noexcept :
+    SRUKFPrediction(std::move(state_model), UTWeight(n, alpha, beta, kappa))
+{ }
+
+
+SRUKFPrediction::SRUKFPrediction
+(
+    std::unique_ptr<AdditiveStateModel> state_model,
+    const UTWeight& ut_weight
+) noexcept :
+    SRUKFPrediction(std::move(state_model), ut_weight, std::make_shared<SquareRootCovariance>())
+{ }
+
+
+SRUKFPrediction::SRUKFPrediction
+(
+    std::unique_ptr<AdditiveStateModel> state_model,
+    const UTWeight& ut_weight,
+    std::shared_ptr<SquareRootCovariance> square_root
+) noexcept :
+    state_model_(std::move(state_model)),
+    ut_weight_(ut_weight),
+    square_root_(square_root)
+{ }
+
+
+SRUKFPrediction::SRUKFPrediction(SRUKFPrediction&& srukf_prediction) noexcept :
+    state_model_(std::move(srukf_prediction.state_model_)),
+    exog_model_(std::move(srukf_prediction.exog_model_)),
+    ut_weight_(srukf_prediction.ut_weight_),
+    ut_workspace_(std::move(srukf_prediction.ut_workspace_)),
+    square_root_(std::move(srukf_prediction.square_root_)),
+    noise_covariance_(std::move(srukf_prediction.noise_covariance_)),
+    sqrt_noise_(std::move(srukf_prediction.sqrt_noise_))
+{ }
+
+
+SRUKFPrediction::~SRUKFPrediction() noexcept
+{ }
+
+
+void SRUKFPrediction::setExogenousModel(std::unique_ptr<ExogenousModel> exog_model)
+{
+    exog_model_ = std::move(exog_model);
+}
+
+
+void SRUKFPrediction::predictStep(const GaussianMixture& prev_state, GaussianMixture& pred_state)
+{
+    bool skip_state = getSkipState();
+    bool skip_exogenous = getSkipExogenous() || (exog_model_ == nullptr);
+    if (skip_state && skip_exogenous)
+    {
+        /* Skip prediction step entirely. */
+        pred_state = prev_state;
+        return;
+    }
+
+    /* Sample the sigma points using the square roots of the covariance matrices of the previous state. */
+    square_root_->factorize(prev_state);
+    sigma_point::sigma_point(prev_state, square_root_->factor(), ut_weight_, ut_workspace_);
+
+    /* Propagate the sigma points. */
+    MatrixXd& input_sigma_points = ut_workspace_.input_sigma_points;
+    MatrixXd& prop_sigma_points = ut_workspace_.prop_sigma_points;
+    prop_sigma_points.resize(input_sigma_points.rows(), input_sigma_points.cols());
+
+    std::pair<std::size_t, std::size_t> output_size;
+    if (!skip_state && !skip_exogenous)
+    {
+        ut_workspace_.tmp_sigma_points.resize(input_sigma_points.rows(), input_sigma_points.cols());
+        state_model_->propagate(input_sigma_points, ut_workspace_.tmp_sigma_points);
+        exog_model_->propagate(ut_workspace_.tmp_sigma_points, prop_sigma_points);
+
+        /* Making the assumption that
+           state_model.getOutputSize() == exogenous_model.getOutputSize(). */
+        output_size = state_model_->getOutputSize();
+    }
+    else if (!skip_state)
+    {
+        state_model_->propagate(input_sigma_points, prop_sigma_points);
+        output_size = state_model_->getOutputSize();
+    }
+    else
+    {
+        exog_model_->propagate(input_sigma_points, prop_sigma_points);
+        output_size = exog_model_->getOutputSize();
+    }
+
+    /* The square root of the noise covariance matrix is evaluated only if the matrix changes. */
+    std::size_t noise_size = 0;
+    if (!skip_state)
+    {
+        MatrixXd noise_covariance = state_model_->getNoiseCovarianceMatrix();
+        if ((noise_covariance.rows() != noise_covariance_.rows()) || (noise_covariance.cols() != noise_covariance_.cols()) || (noise_covariance != noise_covariance_))
+        {
+            noise_covariance_ = std::move(noise_covariance);
+            sqrt_noise_.resize(noise_covariance_.rows(), noise_covariance_.cols());
+            square_root(noise_covariance_, sqrt_noise_);
+        }
+
+        noise_size = sqrt_noise_.cols();
+    }
+
+    /* Process all the components of the mixture. */
+    const std::size_t base = ut_weight_.mean.size();
+    for (std::size_t i = 0; i < prev_state.components; i++)
+    {
+        Ref<MatrixXd> prop_sigma_points_i = prop_sigma_points.middleCols(base * i, base);
+
+        /* Evaluate the mean. */
+        pred_state.mean(i).topRows(output_size.first).noalias() = prop_sigma_points_i.topRows(output_size.first) * ut_weight_.mean;
+        if (output_size.second > 0)
+            pred_state.mean(i).bottomRows(output_size.second) = directional_mean(prop_sigma_points_i.bottomRows(output_size.second), ut_weight_.mean);
+
+        /* Evaluate the deviations from the mean. */
+        prop_sigma_points_i.topRows(output_size.first).colwise() -= pred_state.mean(i).topRows(output_size.first);
+        if (output_size.second > 0)
+            directional_sub(prop_sigma_points_i.bottomRows(output_size.second), pred_state.mean(i).bottomRows(output_size.second), prop_sigma_points_i.bottomRows(output_size.second));
+
+        /* Evaluate the square root of the covariance matrix. The input square root is no longer required. */
+        triangular_square_root(prop_sigma_points_i, ut_weight_.covariance, sqrt_noise_.leftCols(noise_size), square_root_->factor(i), ut_workspace_);
+    }
+
+    pred_state.weight() = prev_state.weight();
+    square_root_->assign(pred_state);
+}
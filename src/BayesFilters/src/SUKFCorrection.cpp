@@ -1,5 +1,6 @@
 #include <BayesFilters/SUKFCorrection.h>
 #include <BayesFilters/directional_statistics.h>
+#include <BayesFilters/utils.h>
 
 using namespace bfl;
 using namespace bfl::directional_statistics;
@@ -7,6 +8,13 @@ using namespace bfl::sigma_point;
 using namespace Eigen;
 
 
+namespace
+{
+    /* Number of sub-vectors of the measurement accumulated in each partial sum, independent of the number of threads. */
+    const std::size_t sub_vectors_per_chunk = 64;
+}
+
+
 SUKFCorrection::SUKFCorrection
 (
     std::unique_ptr<AdditiveMeasurementModel> measurement_model,
@@ -29,11 +37,27 @@ SUKFCorrection::SUKFCorrection
     const double kappa,
     const size_t measurement_sub_size,
     const bool use_reduced_noise_covariance_matrix
+) noexcept :
+    SUKFCorrection(std::move(measurement_model), n, alpha, beta, kappa, measurement_sub_size, use_reduced_noise_covariance_matrix, 1)
+{ }
+
+
+SUKFCorrection::SUKFCorrection
+(
+    std::unique_ptr<AdditiveMeasurementModel> measurement_model,
+    const size_t n,
+    const double alpha,
+    const double beta,
+    const double kappa,
+    const size_t measurement_sub_size,
+    const bool use_reduced_noise_covariance_matrix,
+    const unsigned int num_threads
 ) noexcept :
     measurement_model_(std::move(measurement_model)),
     ut_weight_(n, alpha, beta, kappa),
     measurement_sub_size_(measurement_sub_size),
-    use_reduced_noise_covariance_matrix_(use_reduced_noise_covariance_matrix)
+    use_reduced_noise_covariance_matrix_(use_reduced_noise_covariance_matrix),
+    num_threads_(std::max(num_threads, 1u))
 { }
 
 
@@ -41,8 +65,18 @@ SUKFCorrection::SUKFCorrection(SUKFCorrection&& sukf_correction) noexcept :
     measurement_model_(std::move(sukf_correction.measurement_model_)),
     ut_weight_(sukf_correction.ut_weight_),
     measurement_sub_size_(sukf_correction.measurement_sub_size_),
-    use_reduced_noise_covariance_matrix_(sukf_correction.use_reduced_noise_covariance_matrix_)
-{ }
+    use_reduced_noise_covariance_matrix_(sukf_correction.use_reduced_noise_covariance_matrix_),
+    num_threads_(sukf_correction.num_threads_),
+    noise_covariance_(std::move(sukf_correction.noise_covariance_)),
+    noise_factors_(std::move(sukf_correction.noise_factors_)),
+    valid_noise_factors_(sukf_correction.valid_noise_factors_),
+    C_inv_(std::move(sukf_correction.C_inv_)),
+    d_(std::move(sukf_correction.d_)),
+    partial_C_inv_(std::move(sukf_correction.partial_C_inv_)),
+    partial_d_(std::move(sukf_correction.partial_d_))
+{
+    sukf_correction.valid_noise_factors_ = false;
+}
 
 
 MeasurementModel& SUKFCorrection::getMeasurementModel()
@@ -70,7 +104,7 @@ void SUKFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixt
     }
 
     /* Sample sigma points. */
-    MatrixXd input_sigma_points = sigma_point::sigma_point(pred_state, ut_weight_.c);
+    MatrixXd input_sigma_points = sigma_point::sigma_point(pred_state, ut_weight_);
 
     /* Propagate sigma points. */
     Data pred;
@@ -87,7 +121,7 @@ void SUKFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixt
     MatrixXd prop_sigma_points = bfl::any::any_cast<MatrixXd&&>(std::move(pred));
 
     /* Evaluate the predicted mean. */
-    std::size_t size_sigmas = (pred_state.dim * 2) + 1;
+    std::size_t size_sigmas = ut_weight_.mean.size();
     MatrixXd pred_mean(meas_size, pred_state.components);
     for (size_t i = 0; i < pred_state.components; i++)
     {
@@ -117,6 +151,21 @@ void SUKFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixt
        Science and Systems VII,
        MIT Press */
 
+    /* Factorize the diagonal blocks of the noise covariance matrix once for all the components. */
+    if (!updateNoiseFactors(meas_size))
+    {
+        corr_state = pred_state;
+        return;
+    }
+
+    const std::size_t sub_size = measurement_sub_size_;
+    const std::size_t sub_vectors = meas_size / sub_size;
+    const std::size_t chunks = (sub_vectors + sub_vectors_per_chunk - 1) / sub_vectors_per_chunk;
+
+    /* One partial sum per chunk, stored side by side. */
+    partial_C_inv_.resize(size_sigmas, size_sigmas * chunks);
+    partial_d_.resize(size_sigmas, chunks);
+
     /* Process all the components in the mixture. */
     MatrixXd sqrt_ut_weight = ut_weight_.covariance.array().sqrt().matrix().asDiagonal();
     for (size_t i = 0; i < pred_state.components; i++)
@@ -132,36 +181,69 @@ void SUKFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixt
         Y *= sqrt_ut_weight;
 
         /* Compose matrix C and vector d by cycling over all the sub-vector of the measurement
-           IV.C.2.c */
-        MatrixXd C_inv = MatrixXd::Identity(size_sigmas, size_sigmas);
-        VectorXd d = VectorXd::Zero(size_sigmas);
-
-        for (size_t j = 0; j < (meas_size) / measurement_sub_size_; j++)
+           IV.C.2.c
+           Using the Cholesky factor R_j = L_j * L_j' of each block, the sub-vectors of Y and of the innovation are whitened in place,
+           Z_j = L_j^{-1} * Y_j and e_j = L_j^{-1} * innovation_j, such that
+           C_inv = I + sum_j Z_j' * Z_j and d = sum_j Z_j' * e_j.
+           The sub-vectors are split in chunks of fixed size, whose partial sums are evaluated by the threads
+           and then reduced in the order of the chunks, so that the result does not depend on the number of threads. */
+        Ref<VectorXd> innovation = innovations.col(i);
+
+        utils::parallel_for(num_threads_, chunks,
+                            [&](const std::size_t chunk_begin, const std::size_t chunk_end)
+                            {
+                                for (std::size_t c = chunk_begin; c < chunk_end; c++)
+                                {
+                                    const std::size_t begin = sub_vectors_per_chunk * c;
+                                    const std::size_t end = std::min(begin + sub_vectors_per_chunk, sub_vectors);
+
+                                    for (std::size_t j = begin; j < end; j++)
+                                    {
+                                        const auto L_j = noise_factors_.middleCols(use_reduced_noise_covariance_matrix_ ? 0 : sub_size * j, sub_size).triangularView<Lower>();
+
+                                        L_j.solveInPlace(Y.middleRows(sub_size * j, sub_size));
+                                        L_j.solveInPlace(innovation.segment(sub_size * j, sub_size));
+                                    }
+
+                                    const auto Z = Y.middleRows(sub_size * begin, sub_size * (end - begin));
+
+                                    auto partial_C_inv = partial_C_inv_.middleCols(size_sigmas * c, size_sigmas);
+                                    partial_C_inv.setZero();
+                                    partial_C_inv.selfadjointView<Lower>().rankUpdate(Z.transpose());
+                                    partial_d_.col(c).noalias() = Z.transpose() * innovation.segment(sub_size * begin, sub_size * (end - begin));
+                                }
+                            });
+
+        C_inv_.setIdentity(size_sigmas, size_sigmas);
+        d_.setZero(size_sigmas);
+        for (std::size_t c = 0; c < chunks; c++)
         {
-            MatrixXd tmp(size_sigmas, measurement_sub_size_);
-            tmp.noalias() = Y.middleRows(measurement_sub_size_ *j, measurement_sub_size_).transpose() * getNoiseCovarianceMatrix(j).inverse();
-
-            C_inv += tmp * Y.middleRows(measurement_sub_size_ *j, measurement_sub_size_);
-
-            d += tmp * innovations.col(i).middleRows(measurement_sub_size_ *j, measurement_sub_size_);
+            C_inv_ += partial_C_inv_.middleCols(size_sigmas * c, size_sigmas);
+            d_ += partial_d_.col(c);
         }
 
         /* Process input sigma points.
            IV.C.3 */
         Ref<MatrixXd> X = input_sigma_points.middleCols(size_sigmas * i, size_sigmas);
         X.topRows(pred_state.dim_linear).colwise() -= pred_state.mean(i).topRows(pred_state.dim_linear);
-        X.bottomRows(pred_state.dim_circular) = directional_sub(X.bottomRows(pred_state.dim_circular), pred_state.mean(i).bottomRows(pred_state.dim_circular));
+        directional_sub(X.bottomRows(pred_state.dim_circular), pred_state.mean(i).bottomRows(pred_state.dim_circular), X.bottomRows(pred_state.dim_circular));
         X *= sqrt_ut_weight;
 
-        C_inv = C_inv.inverse();
+        /* Decompose C_inv = L * L' instead of inverting it. */
+        LLT<MatrixXd> C_inv_llt(C_inv_);
 
         /* Evaluate the filtered mean.
            IV.C.4 */
-        corr_state.mean(i) = pred_state.mean(i) + X * C_inv * d;
+        corr_state.mean(i) = pred_state.mean(i);
+        corr_state.mean(i).noalias() += X * C_inv_llt.solve(d_);
 
         /* Evaluate the filtered covariance.
-           IV.C.4 */
-        corr_state.covariance(i) = X * C_inv * X.transpose();
+           IV.C.4
+           X * C * X' = (X * L^{-T}) * (X * L^{-T})', as a symmetric rank-k update of the lower triangle, then mirrored in the upper one. */
+        C_inv_llt.matrixU().solveInPlace<OnTheRight>(X);
+        corr_state.covariance(i).setZero();
+        corr_state.covariance(i).selfadjointView<Lower>().rankUpdate(X);
+        corr_state.covariance(i).triangularView<StrictlyUpper>() = corr_state.covariance(i).transpose();
     }
 }
 
@@ -179,6 +261,38 @@ MatrixXd SUKFCorrection::getNoiseCovarianceMatrix(const std::size_t index)
 }
 
 
+bool SUKFCorrection::updateNoiseFactors(const std::size_t meas_size)
+{
+    MatrixXd R;
+    std::tie(std::ignore, R) = measurement_model_->getNoiseCovarianceMatrix();
+
+    if (valid_noise_factors_ && (R.rows() == noise_covariance_.rows()) && (R.cols() == noise_covariance_.cols()) && (R == noise_covariance_))
+        return true;
+
+    const std::size_t sub_size = measurement_sub_size_;
+    const std::size_t blocks = use_reduced_noise_covariance_matrix_ ? 1 : meas_size / sub_size;
+
+    if ((R.rows() != static_cast<Index>(sub_size * blocks)) || (R.cols() != static_cast<Index>(sub_size * blocks)))
+        throw std::runtime_error("ERROR::SUKFCORRECTION::UPDATENOISEFACTORS\nERROR:\n\tWrong size of the noise covariance matrix.");
+
+    noise_factors_.resize(sub_size, sub_size * blocks);
+    valid_noise_factors_ = true;
+
+    LLT<MatrixXd> llt(sub_size);
+    for (std::size_t j = 0; (j < blocks) && valid_noise_factors_; j++)
+    {
+        llt.compute(R.block(sub_size * j, sub_size * j, sub_size, sub_size));
+
+        valid_noise_factors_ = (llt.info() == Success);
+        noise_factors_.middleCols(sub_size * j, sub_size) = llt.matrixL();
+    }
+
+    noise_covariance_ = std::move(R);
+
+    return valid_noise_factors_;
+}
+
+
 std::pair<bool, Eigen::VectorXd> SUKFCorrection::likelihood(const Eigen::Ref<const Eigen::MatrixXd>& innovations)
 {
     throw std::runtime_error("ERROR::SUKFCORRECTION::LIKELIHOOD\nERROR:\n\tMethod not implemented.");
@@ -0,0 +1,172 @@
+#include <BayesFilters/SequentialKFCorrection.h>
+
+#include <algorithm>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+SequentialKFCorrection::SequentialKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model) noexcept :
+    KFCorrection(std::move(measurement_model)),
+    detect_blocks_(true)
+{ }
+
+
+SequentialKFCorrection::SequentialKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model, const std::vector<std::size_t>& block_sizes) noexcept :
+    KFCorrection(std::move(measurement_model)),
+    detect_blocks_(false)
+{
+    std::size_t row = 0;
+    for (const std::size_t size : block_sizes)
+    {
+        blocks_.emplace_back(row, size);
+        row += size;
+    }
+}
+
+
+SequentialKFCorrection::SequentialKFCorrection(SequentialKFCorrection&& kf_correction) noexcept :
+    KFCorrection(std::move(kf_correction)),
+    detect_blocks_(kf_correction.detect_blocks_),
+    blocks_(std::move(kf_correction.blocks_)),
+    valid_blocks_(kf_correction.valid_blocks_),
+    blocks_revision_(kf_correction.blocks_revision_),
+    PxHt_b_(std::move(kf_correction.PxHt_b_)),
+    Py_b_(std::move(kf_correction.Py_b_)),
+    Py_b_llt_(std::move(kf_correction.Py_b_llt_)),
+    innovation_b_(std::move(kf_correction.innovation_b_))
+{
+    kf_correction.valid_blocks_ = false;
+}
+
+
+SequentialKFCorrection::~SequentialKFCorrection() noexcept
+{ }
+
+
+void SequentialKFCorrection::correctComponents(const GaussianMixture& pred_state, const Ref<const MatrixXd>& innovations, GaussianMixture& corr_state)
+{
+    /* The blocks are detected again whenever the model matrices may have changed. */
+    if (!(valid_blocks_ && valid_model_matrices_ && (model_revision_ == blocks_revision_)))
+        updateBlocks();
+
+    if (blocks_.size() <= 1)
+    {
+        KFCorrection::correctComponents(pred_state, innovations, corr_state);
+        return;
+    }
+
+    bool positive_definite = true;
+
+    /* Process all the components in the mixture. */
+    for (std::size_t i = 0; (i < pred_state.components) && positive_definite; i++)
+    {
+        Ref<VectorXd> x = corr_state.mean(i);
+        Ref<MatrixXd> P = corr_state.covariance(i);
+
+        x = pred_state.mean(i);
+        P = pred_state.covariance(i);
+
+        /* Only the lower triangle of P is updated, then it is mirrored in the upper one. */
+        for (const auto& block : blocks_)
+        {
+            const std::size_t row = block.first;
+            const std::size_t size = block.second;
+            const auto H_b = H_.middleRows(row, size);
+
+            /* Evaluate the innovation of the block with respect to the current mean
+               y_b - H_b * x = (y_b - H_b * x_{k}-) - H_b * (x - x_{k}-) */
+            innovation_b_ = innovations.col(i).segment(row, size);
+            innovation_b_.noalias() -= H_b * (x - pred_state.mean(i));
+
+            /* Evaluate the covariance matrix of the predicted measurement of the block
+               Py_b = H_b * P * H_b' + R_b */
+            PxHt_b_.noalias() = P.selfadjointView<Lower>() * H_b.transpose();
+            Py_b_ = R_.block(row, row, size, size);
+            Py_b_.noalias() += H_b * PxHt_b_;
+
+            if (size == 1)
+            {
+                /* Scalar update
+                   x = x + P * h' * (y_b - h * x) / py
+                   P = P - (P * h') * (P * h')' / py */
+                const double py = Py_b_(0, 0);
+                if (!(py > 0.0))
+                {
+                    positive_definite = false;
+                    break;
+                }
+
+                x.noalias() += PxHt_b_ * (innovation_b_(0) / py);
+                P.selfadjointView<Lower>().rankUpdate(PxHt_b_.col(0), -1.0 / py);
+            }
+            else
+            {
+                /* Block update through the Cholesky decomposition Py_b = L * L'
+                   x = x + P * H_b' * (Py_b)^{-1} * (y_b - H_b * x)
+                   P = P - (P * H_b' * L^{-T}) * (P * H_b' * L^{-T})' */
+                Py_b_llt_.compute(Py_b_);
+                if (Py_b_llt_.info() != Success)
+                {
+                    positive_definite = false;
+                    break;
+                }
+
+                x.noalias() += PxHt_b_ * Py_b_llt_.solve(innovation_b_);
+
+                Py_b_llt_.matrixU().solveInPlace<OnTheRight>(PxHt_b_);
+                P.selfadjointView<Lower>().rankUpdate(PxHt_b_, -1.0);
+            }
+        }
+
+        P.triangularView<StrictlyUpper>() = P.transpose();
+    }
+
+    /* If the covariance matrix of the predicted measurement of a block is not numerically positive definite,
+       correct the whole measurement at once. */
+    if (!positive_definite)
+        KFCorrection::correctComponents(pred_state, innovations, corr_state);
+}
+
+
+void SequentialKFCorrection::updateBlocks()
+{
+    const std::size_t size = R_.rows();
+
+    if (detect_blocks_)
+    {
+        /* A block ends at the row r if no entry of R_ couples the rows up to r with the following ones. */
+        blocks_.clear();
+
+        std::size_t first_row = 0;
+        std::size_t last_coupled_row = 0;
+        for (std::size_t r = 0; r < size; r++)
+        {
+            last_coupled_row = std::max(last_coupled_row, r);
+            for (std::size_t c = size - 1; c > last_coupled_row; c--)
+            {
+                if ((R_(r, c) != 0.0) || (R_(c, r) != 0.0))
+                {
+                    last_coupled_row = c;
+                    break;
+                }
+            }
+
+            if (last_coupled_row == r)
+            {
+                blocks_.emplace_back(first_row, r - first_row + 1);
+                first_row = r + 1;
+            }
+        }
+    }
+    else
+    {
+        const std::size_t blocks_size = blocks_.empty() ? 0 : blocks_.back().first + blocks_.back().second;
+
+        if (blocks_size != size)
+            throw std::runtime_error("ERROR::SEQUENTIALKFCORRECTION::UPDATEBLOCKS\nERROR:\n\tThe sizes of the blocks do not sum up to the size of the measurement.");
+    }
+
+    valid_blocks_ = true;
+    blocks_revision_ = model_revision_;
+}
@@ -0,0 +1,97 @@
+#include <BayesFilters/SquareRootCovariance.h>
+
+using namespace bfl;
+using namespace bfl::sigma_point;
+using namespace Eigen;
+
+
+SquareRootCovariance::SquareRootCovariance() noexcept
+{ }
+
+
+SquareRootCovariance::~SquareRootCovariance() noexcept
+{ }
+
+
+bool SquareRootCovariance::factorize(const GaussianMixture& state)
+{
+    if (valid_ && (components_ == state.components) && (dim_ == state.dim) && (covariance_ == state.covariance()))
+        return true;
+
+    resize(state.components, state.dim);
+
+    for (std::size_t i = 0; i < components_; i++)
+    {
+        workspace_.llt.compute(state.covariance(i));
+        if (workspace_.llt.info() == Success)
+        {
+            factor(i) = workspace_.llt.matrixL();
+        }
+        else
+        {
+            /* Make the square root of a semidefinite matrix triangular. */
+            MatrixXd sqrt_covariance(dim_, dim_);
+            square_root(state.covariance(i), sqrt_covariance);
+
+            triangular_square_root(sqrt_covariance, VectorXd::Ones(dim_), MatrixXd(dim_, 0), factor(i), workspace_);
+        }
+    }
+
+    covariance_ = state.covariance();
+    valid_ = true;
+
+    return false;
+}
+
+
+void SquareRootCovariance::resize(const std::size_t components, const std::size_t dim)
+{
+    if ((components_ == components) && (dim_ == dim))
+        return;
+
+    components_ = components;
+    dim_ = dim;
+
+    factor_.resize(dim_, dim_ * components_);
+    valid_ = false;
+}
+
+
+void SquareRootCovariance::assign(GaussianMixture& state)
+{
+    for (std::size_t i = 0; i < components_; i++)
+        state.covariance(i).noalias() = factor(i).triangularView<Lower>() * factor(i).transpose();
+
+    covariance_ = state.covariance();
+    valid_ = true;
+}
+
+
+void SquareRootCovariance::reset()
+{
+    valid_ = false;
+}
+
+
+Ref<MatrixXd> SquareRootCovariance::factor()
+{
+    return factor_;
+}
+
+
+Ref<MatrixXd> SquareRootCovariance::factor(const std::size_t i)
+{
+    return factor_.middleCols(dim_ * i, dim_);
+}
+
+
+const Ref<const MatrixXd> SquareRootCovariance::factor() const
+{
+    return factor_;
+}
+
+
+const Ref<const MatrixXd> SquareRootCovariance::factor(const std::size_t i) const
+{
+    return factor_.middleCols(dim_ * i, dim_);
+}
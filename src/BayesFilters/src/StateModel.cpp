@@ -1,5 +1,7 @@
 #include <BayesFilters/StateModel.h>
 
+#include <limits>
+
 using namespace bfl;
 using namespace Eigen;
 
@@ -16,6 +18,12 @@ Eigen::VectorXd StateModel::getTransitionProbability(const Eigen::Ref<const Eige
 }
 
 
+Eigen::VectorXd StateModel::getLogTransitionProbability(const Eigen::Ref<const Eigen::MatrixXd>& prev_states, Eigen::Ref<Eigen::MatrixXd> cur_states)
+{
+    return (getTransitionProbability(prev_states, cur_states).array() + std::numeric_limits<double>::min()).log().matrix();
+}
+
+
 Eigen::MatrixXd StateModel::getNoiseCovarianceMatrix()
 {
     throw std::runtime_error("ERROR::STATEMODEL::GETNOISECOVARIANCEMATRIX\nERROR:\n\tMethod not implemented.");
@@ -41,6 +41,18 @@ bool StateModelDecorator::setProperty(const std::string& property)
 }
 
 
+VectorXd StateModelDecorator::getTransitionProbability(const Ref<const MatrixXd>& prev_states, Ref<MatrixXd> cur_states)
+{
+    return state_model_->getTransitionProbability(prev_states, cur_states);
+}
+
+
+VectorXd StateModelDecorator::getLogTransitionProbability(const Ref<const MatrixXd>& prev_states, Ref<MatrixXd> cur_states)
+{
+    return state_model_->getLogTransitionProbability(prev_states, cur_states);
+}
+
+
 MatrixXd StateModelDecorator::getNoiseCovarianceMatrix()
 {
     return state_model_->getNoiseCovarianceMatrix();
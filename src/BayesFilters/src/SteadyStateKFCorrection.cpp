@@ -0,0 +1,93 @@
+#include <BayesFilters/SteadyStateKFCorrection.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+SteadyStateKFCorrection::SteadyStateKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model) noexcept :
+    SteadyStateKFCorrection(std::move(measurement_model), 1e-10)
+{ }
+
+
+SteadyStateKFCorrection::SteadyStateKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model, const double tolerance) noexcept :
+    KFCorrection(std::move(measurement_model)),
+    tolerance_(tolerance)
+{ }
+
+
+SteadyStateKFCorrection::SteadyStateKFCorrection(SteadyStateKFCorrection&& kf_correction) noexcept :
+    KFCorrection(std::move(kf_correction)),
+    tolerance_(kf_correction.tolerance_),
+    converged_(kf_correction.converged_),
+    steady_state_(kf_correction.steady_state_),
+    frozen_revision_(kf_correction.frozen_revision_),
+    pred_covariance_(std::move(kf_correction.pred_covariance_)),
+    corr_covariance_(std::move(kf_correction.corr_covariance_)),
+    pred_covariance_norm_(kf_correction.pred_covariance_norm_),
+    gains_(std::move(kf_correction.gains_))
+{
+    kf_correction.converged_ = false;
+    kf_correction.steady_state_ = false;
+}
+
+
+SteadyStateKFCorrection::~SteadyStateKFCorrection() noexcept
+{ }
+
+
+bool SteadyStateKFCorrection::isSteadyState() const
+{
+    return steady_state_;
+}
+
+
+void SteadyStateKFCorrection::correctComponents(const GaussianMixture& pred_state, const Ref<const MatrixXd>& innovations, GaussianMixture& corr_state)
+{
+    /* The cached model matrices are valid across steps only for a model reporting a revision,
+       see KFCorrection::updateModelMatrices(). */
+    const bool same_model = valid_model_matrices_ && (model_revision_ == frozen_revision_);
+
+    steady_state_ = converged_ && same_model &&
+                    (pred_state.covariance().cols() == pred_covariance_.cols()) &&
+                    ((pred_state.covariance() - pred_covariance_).norm() <= tolerance_ * pred_covariance_norm_);
+
+    if (steady_state_)
+    {
+        /* x_{k}+ = x{k}- + K * (y - y_predicted) */
+        for (std::size_t i = 0; i < pred_state.components; i++)
+        {
+            corr_state.mean(i) = pred_state.mean(i);
+            corr_state.mean(i).noalias() += gains_[i] * innovations.col(i);
+        }
+        corr_state.covariance() = corr_covariance_;
+
+        return;
+    }
+
+    KFCorrection::correctComponents(pred_state, innovations, corr_state);
+
+    /* Check the convergence of the full recursion. */
+    converged_ = same_model &&
+                 (corr_state.covariance().cols() == corr_covariance_.cols()) &&
+                 ((corr_state.covariance() - corr_covariance_).norm() <= tolerance_ * corr_covariance_.norm());
+
+    frozen_revision_ = model_revision_;
+    pred_covariance_ = pred_state.covariance();
+    corr_covariance_ = corr_state.covariance();
+    pred_covariance_norm_ = pred_covariance_.norm();
+
+    if (converged_)
+    {
+        /* Evaluate the Kalman gains once for all
+           K = Px * H' * (H * Px * H' + R)^{-1} */
+        gains_.resize(pred_state.components);
+        for (std::size_t i = 0; i < pred_state.components; i++)
+        {
+            PxHt_.noalias() = pred_state.covariance(i) * H_.transpose();
+            Py_ = R_;
+            Py_.noalias() += H_ * PxHt_;
+
+            gains_[i] = Py_.ldlt().solve(PxHt_.transpose()).transpose();
+        }
+    }
+}
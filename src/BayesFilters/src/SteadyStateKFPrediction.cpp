@@ -0,0 +1,95 @@
+#include <BayesFilters/SteadyStateKFPrediction.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+SteadyStateKFPrediction::SteadyStateKFPrediction(std::unique_ptr<LinearStateModel> state_model) noexcept :
+    SteadyStateKFPrediction(std::move(state_model), 1e-10)
+{ }
+
+
+SteadyStateKFPrediction::SteadyStateKFPrediction(std::unique_ptr<LinearStateModel> state_model, const double tolerance) noexcept :
+    KFPrediction(std::move(state_model)),
+    tolerance_(tolerance)
+{ }
+
+
+SteadyStateKFPrediction::SteadyStateKFPrediction
+(
+    std::unique_ptr<LinearStateModel> state_model,
+    std::unique_ptr<ExogenousModel> exogenous_model,
+    const double tolerance
+) noexcept :
+    KFPrediction(std::move(state_model), std::move(exogenous_model)),
+    tolerance_(tolerance)
+{ }
+
+
+SteadyStateKFPrediction::SteadyStateKFPrediction(SteadyStateKFPrediction&& kf_prediction) noexcept :
+    KFPrediction(std::move(kf_prediction)),
+    tolerance_(kf_prediction.tolerance_),
+    converged_(kf_prediction.converged_),
+    steady_state_(kf_prediction.steady_state_),
+    model_revision_(kf_prediction.model_revision_),
+    prev_covariance_(std::move(kf_prediction.prev_covariance_)),
+    pred_covariance_(std::move(kf_prediction.pred_covariance_)),
+    prev_covariance_norm_(kf_prediction.prev_covariance_norm_)
+{
+    kf_prediction.converged_ = false;
+    kf_prediction.steady_state_ = false;
+}
+
+
+SteadyStateKFPrediction::~SteadyStateKFPrediction() noexcept
+{ }
+
+
+bool SteadyStateKFPrediction::isSteadyState() const
+{
+    return steady_state_;
+}
+
+
+void SteadyStateKFPrediction::predictStep(const GaussianMixture& prev_state, GaussianMixture& pred_state)
+{
+    bool cacheable;
+    std::size_t revision;
+    std::tie(cacheable, revision) = state_model_->getRevision();
+
+    /* The steady state is used only if the state is propagated by a time invariant model
+       whose revision did not change, starting from the converged covariance matrices. */
+    steady_state_ = converged_ && cacheable && (revision == model_revision_) && !getSkipState() &&
+                    (prev_state.covariance().cols() == prev_covariance_.cols()) &&
+                    ((prev_state.covariance() - prev_covariance_).norm() <= tolerance_ * prev_covariance_norm_);
+
+    if (steady_state_)
+    {
+        /* x_{k+1} = F_{k} x_{k} */
+        state_model_->propagate(prev_state.mean(), pred_state.mean());
+        pred_state.covariance() = pred_covariance_;
+
+        if (!(getSkipExogenous() || (exogenous_model_ == nullptr)))
+        {
+            MatrixXd tmp(pred_state.mean().rows(), pred_state.mean().cols());
+
+            exogenous_model_->propagate(pred_state.mean(), tmp);
+
+            pred_state.mean() = std::move(tmp);
+        }
+
+        return;
+    }
+
+    KFPrediction::predictStep(prev_state, pred_state);
+
+    /* Check the convergence of the full recursion. */
+    converged_ = cacheable && (revision == model_revision_) &&
+                 (pred_state.covariance().cols() == pred_covariance_.cols()) &&
+                 ((pred_state.covariance() - pred_covariance_).norm() <= tolerance_ * pred_covariance_.norm());
+
+    model_revision_ = revision;
+    prev_covariance_ = prev_state.covariance();
+    pred_covariance_ = pred_state.covariance();
+    prev_covariance_norm_ = prev_covariance_.norm();
+}
@@ -0,0 +1,50 @@
+#include <BayesFilters/StratifiedResampling.h>
+
+#include <utility>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+StratifiedResampling::StratifiedResampling(const unsigned int seed) noexcept :
+    Resampling(seed) { }
+
+
+StratifiedResampling::StratifiedResampling() noexcept :
+    StratifiedResampling(1) { }
+
+
+StratifiedResampling::StratifiedResampling(StratifiedResampling&& resampling) noexcept :
+    Resampling(std::move(resampling)) { }
+
+
+StratifiedResampling::~StratifiedResampling() noexcept { }
+
+
+StratifiedResampling& StratifiedResampling::operator=(StratifiedResampling&& resampling) noexcept
+{
+    Resampling::operator=(std::move(resampling));
+
+    return *this;
+}
+
+
+void StratifiedResampling::resample(const ParticleSet& cor_particles, ParticleSet& res_particles, Ref<VectorXi> res_parents)
+{
+    int num_particles = static_cast<int>(cor_particles.weight().rows());
+    csw_.resize(num_particles);
+    cumulativeSum(cor_particles.weight(), csw_);
+
+    std::uniform_real_distribution<double> distribution_res(0.0, 1.0);
+
+    int idx_csw = 0;
+    for (int j = 0; j < num_particles; ++j)
+    {
+        double u_j = (static_cast<double>(j) + distribution_res(generator_)) / num_particles;
+
+        while (u_j > csw_(idx_csw) && idx_csw < (num_particles - 1))
+            idx_csw += 1;
+
+        assignParent(cor_particles, res_particles, res_parents, j, idx_csw);
+    }
+}
@@ -33,11 +33,40 @@ UKFCorrection::UKFCorrection
 { }
 
 
+UKFCorrection::UKFCorrection
+(
+    std::unique_ptr<MeasurementModel> measurement_model,
+    const UTWeight& ut_weight
+) noexcept :
+    measurement_model_(std::move(measurement_model)),
+    type_(UKFCorrectionType::Generic),
+    ut_weight_(ut_weight)
+{ }
+
+
+UKFCorrection::UKFCorrection
+(
+    std::unique_ptr<AdditiveMeasurementModel> measurement_model,
+    const UTWeight& ut_weight
+) noexcept :
+    additive_measurement_model_(std::move(measurement_model)),
+    type_(UKFCorrectionType::Additive),
+    ut_weight_(ut_weight)
+{ }
+
+
 UKFCorrection::UKFCorrection(UKFCorrection&& ukf_correction) noexcept :
     measurement_model_(std::move(ukf_correction.measurement_model_)),
     additive_measurement_model_(std::move(ukf_correction.additive_measurement_model_)),
     type_(ukf_correction.type_),
-    ut_weight_(ukf_correction.ut_weight_)
+    ut_weight_(ukf_correction.ut_weight_),
+    ut_workspace_(std::move(ukf_correction.ut_workspace_)),
+    noise_covariance_matrix_(std::move(ukf_correction.noise_covariance_matrix_)),
+    predicted_measurement_(std::move(ukf_correction.predicted_measurement_)),
+    Py_llt_(std::move(ukf_correction.Py_llt_)),
+    Py_ldlt_(std::move(ukf_correction.Py_ldlt_)),
+    W_(std::move(ukf_correction.W_)),
+    gain_innovation_(std::move(ukf_correction.gain_innovation_))
 { }
 
 
@@ -70,28 +99,23 @@ void UKFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixtu
         return;
     }
 
-    /* Initialize predicted measurement GaussianMixture. */
+    /* Predicted measurement size. */
     std::pair<std::size_t, std::size_t> meas_sizes = model.getOutputSize();
     std::size_t meas_size = meas_sizes.first + meas_sizes.second;
-    GaussianMixture pred_meas(pred_state.components, meas_size);
 
     /* Evaluate the joint state-measurement statistics, if possible. */
-    bool valid;
-    MatrixXd Pxy;
+    bool valid = false;
     if (type_ == UKFCorrectionType::Generic)
     {
         /* Augment the previous state using measurement noise statistics. */
-        GaussianMixture pred_state_augmented = pred_state;
+        std::tie(std::ignore, noise_covariance_matrix_) = model.getNoiseCovarianceMatrix();
+        const GaussianMixture& pred_state_augmented = augment_with_noise(pred_state, noise_covariance_matrix_, ut_workspace_);
 
-        MatrixXd noise_covariance_matrix;
-        std::tie(std::ignore, noise_covariance_matrix) = model.getNoiseCovarianceMatrix();
-        pred_state_augmented.augmentWithNoise(noise_covariance_matrix);
-
-        std::tie(valid, pred_meas, Pxy) = sigma_point::unscented_transform(pred_state_augmented, ut_weight_, *measurement_model_);
+        valid = sigma_point::unscented_transform(pred_state_augmented, ut_weight_, *measurement_model_, ut_workspace_);
     }
     else if (type_ == UKFCorrectionType::Additive)
     {
-        std::tie(valid, pred_meas, Pxy) = sigma_point::unscented_transform(pred_state, ut_weight_, *additive_measurement_model_);
+        valid = sigma_point::unscented_transform(pred_state, ut_weight_, *additive_measurement_model_, ut_workspace_);
     }
 
     if (!valid)
@@ -100,15 +124,18 @@ void UKFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixtu
         return;
     }
 
+    const GaussianMixture& pred_meas = ut_workspace_.output;
+    const MatrixXd& Pxy = ut_workspace_.cross_covariance;
+
     /* Evaluate the innovation if possible. */
     bool valid_innovation;
     Data innovation;
-    /* This temporary is required since some MeasurementModel::innovation methods may try to cast from
-       const Ref<const MatrixXd> to MatrixXd resulting in a bfl::any::bad_any_cast. 
-
-       Hopefully, using std::move, it is possible to steal the memory from pred_meas.mean(). */
-    MatrixXd y_p = std::move(pred_meas.mean());
-    std::tie(valid_innovation, innovation) = model.innovation(y_p, measurement);
+    /* The predicted measurement is stored as a MatrixXd, since some MeasurementModel::innovation methods may try to cast from
+       const Ref<const MatrixXd> to MatrixXd resulting in a bfl::any::bad_any_cast. The Data is reused across steps. */
+    if (!predicted_measurement_.has_value())
+        predicted_measurement_ = MatrixXd();
+    any::any_cast<MatrixXd&>(predicted_measurement_) = pred_meas.mean();
+    std::tie(valid_innovation, innovation) = model.innovation(predicted_measurement_, measurement);
 
     if (!valid_innovation)
     {
@@ -116,23 +143,50 @@ void UKFCorrection::correctStep(const GaussianMixture& pred_state, GaussianMixtu
         return;
     }
 
-    /* Cast innovations once for all. */
-    MatrixXd innovations = any::any_cast<MatrixXd&&>(std::move(innovation));
+    const MatrixXd& innovations = any::any_cast<const MatrixXd&>(innovation);
 
     /* Process all the components in the mixture. */
     for (size_t i=0; i < pred_state.components; i++)
     {
-        /* Evaluate the Kalman Gain
-           K = Pxy * (Py)^{-1} */
-        MatrixXd K = Pxy.middleCols(meas_size * i, meas_size) * pred_meas.covariance(i).inverse();
-
-        /* Evaluate the filtered mean.
-           x_{k}+ = x{k}- + K * innovation */
-        corr_state.mean(i) = pred_state.mean(i) + K * innovations.col(i);
-
-        /* Evaluate the filtered covariance
-           P_{k}+ = P_{k}- - K * Py * K' */
-        corr_state.covariance(i) = pred_state.covariance(i) - K * pred_meas.covariance(i) * K.transpose();
+        const auto Pxy_i = Pxy.middleCols(meas_size * i, meas_size);
+
+        /* Decompose Py = L * L'. */
+        Py_llt_.compute(pred_meas.covariance(i));
+
+        if (Py_llt_.info() == Success)
+        {
+            /* Evaluate the filtered mean
+               x_{k}+ = x{k}- + K * innovation
+               using the Kalman gain K = Pxy * (Py)^{-1} through a solve. */
+            gain_innovation_ = Py_llt_.solve(innovations.col(i));
+            corr_state.mean(i) = pred_state.mean(i);
+            corr_state.mean(i).noalias() += Pxy_i * gain_innovation_;
+
+            /* Evaluate W = L^{-1} * Pxy', such that K * Py * K' = Pxy * (Py)^{-1} * Pxy' = W' * W,
+               and the filtered covariance
+               P_{k}+ = P_{k}- - K * Py * K' = P_{k}- - W' * W
+               as a symmetric rank-k update of the lower triangle, then mirrored in the upper one. */
+            W_ = Pxy_i.transpose();
+            Py_llt_.matrixL().solveInPlace(W_);
+
+            corr_state.covariance(i) = pred_state.covariance(i);
+            corr_state.covariance(i).selfadjointView<Lower>().rankUpdate(W_.transpose(), -1.0);
+            corr_state.covariance(i).triangularView<StrictlyUpper>() = corr_state.covariance(i).transpose();
+        }
+        else
+        {
+            /* Py is not numerically positive definite, use the solve of the LDL' decomposition.
+               K = Pxy * (Py)^{-1} */
+            Py_ldlt_.compute(pred_meas.covariance(i));
+            W_ = Py_ldlt_.solve(Pxy_i.transpose());
+
+            corr_state.mean(i) = pred_state.mean(i);
+            corr_state.mean(i).noalias() += W_.transpose() * innovations.col(i);
+
+            /* P_{k}+ = P_{k}- - K * Py * K' = P_{k}- - K * Pxy' */
+            corr_state.covariance(i) = pred_state.covariance(i);
+            corr_state.covariance(i).noalias() -= W_.transpose() * Pxy_i.transpose();
+        }
     }
 }
 
@@ -33,11 +33,34 @@ UKFPrediction::UKFPrediction
 { }
 
 
+UKFPrediction::UKFPrediction
+(
+    std::unique_ptr<StateModel> state_model,
+    const UTWeight& ut_weight
+) noexcept :
+    state_model_(std::move(state_model)),
+    type_(UKFPredictionType::Generic),
+    ut_weight_(ut_weight)
+{ }
+
+
+UKFPrediction::UKFPrediction
+(
+    std::unique_ptr<AdditiveStateModel> state_model,
+    const UTWeight& ut_weight
+) noexcept :
+    add_state_model_(std::move(state_model)),
+    type_(UKFPredictionType::Additive),
+    ut_weight_(ut_weight)
+{ }
+
+
 UKFPrediction::UKFPrediction(UKFPrediction&& ukf_prediction) noexcept:
     state_model_(std::move(ukf_prediction.state_model_)),
     add_state_model_(std::move(ukf_prediction.add_state_model_)),
     type_(ukf_prediction.type_),
-    ut_weight_(ukf_prediction.ut_weight_)
+    ut_weight_(ukf_prediction.ut_weight_),
+    ut_workspace_(std::move(ukf_prediction.ut_workspace_))
 { }
 
 
@@ -67,14 +90,13 @@ void UKFPrediction::predictStep(const GaussianMixture& prev_state, GaussianMixtu
         if (type_ == UKFPredictionType::Generic)
         {
             /* Augment the previous state using process noise statistics. */
-            GaussianMixture prev_state_augmented = prev_state;
-            prev_state_augmented.augmentWithNoise(state_model_->getNoiseCovarianceMatrix());
+            const GaussianMixture& prev_state_augmented = augment_with_noise(prev_state, state_model_->getNoiseCovarianceMatrix(), ut_workspace_);
 
-            std::tie(pred_state, std::ignore) = unscented_transform(prev_state_augmented, ut_weight_, *state_model_, *exog_model_);
+            unscented_transform(prev_state_augmented, ut_weight_, *state_model_, *exog_model_, ut_workspace_);
         }
         else if (type_ == UKFPredictionType::Additive)
         {
-            std::tie(pred_state, std::ignore) = unscented_transform(prev_state, ut_weight_, *add_state_model_, *exog_model_);
+            unscented_transform(prev_state, ut_weight_, *add_state_model_, *exog_model_, ut_workspace_);
         }
     }
     else if (!getSkipState())
@@ -83,16 +105,17 @@ void UKFPrediction::predictStep(const GaussianMixture& prev_state, GaussianMixtu
         if (type_ == UKFPredictionType::Generic)
         {
             /* Augment the previous state using process noise statistics. */
-            GaussianMixture prev_state_augmented = prev_state;
-            prev_state_augmented.augmentWithNoise(state_model_->getNoiseCovarianceMatrix());
+            const GaussianMixture& prev_state_augmented = augment_with_noise(prev_state, state_model_->getNoiseCovarianceMatrix(), ut_workspace_);
 
-            std::tie(pred_state, std::ignore) = unscented_transform(prev_state_augmented, ut_weight_, *state_model_);
+            unscented_transform(prev_state_augmented, ut_weight_, *state_model_, ut_workspace_);
         }
         else if (type_ == UKFPredictionType::Additive)
         {
-            std::tie(pred_state, std::ignore) = unscented_transform(prev_state, ut_weight_, *add_state_model_);
+            unscented_transform(prev_state, ut_weight_, *add_state_model_, ut_workspace_);
         }
     }
     else if (!skip_exogenous)
-        std::tie(pred_state, std::ignore) = unscented_transform(prev_state, ut_weight_, *exog_model_);
+        unscented_transform(prev_state, ut_weight_, *exog_model_, ut_workspace_);
+
+    pred_state = ut_workspace_.output;
 }
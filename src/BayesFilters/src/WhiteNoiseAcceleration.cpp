@@ -36,6 +36,9 @@ WhiteNoiseAcceleration::WhiteNoiseAcceleration
 
     LDLT<Matrix4d> chol_ldlt(Q_);
     sqrt_Q_ = (chol_ldlt.transpositionsP() * Matrix4d::Identity()).transpose() * chol_ldlt.matrixL() * chol_ldlt.vectorD().real().cwiseSqrt().asDiagonal();
+
+    inv_Q_ = chol_ldlt.solve(Matrix4d::Identity());
+    log_normalizer_ = -0.5 * 4.0 * log(2.0 * M_PI) - 0.5 * chol_ldlt.vectorD().array().log().sum();
 }
 
 
@@ -61,6 +64,8 @@ WhiteNoiseAcceleration::WhiteNoiseAcceleration(const WhiteNoiseAcceleration& wna
     Q_(wna.Q_),
     tilde_q_(wna.tilde_q_),
     sqrt_Q_(wna.sqrt_Q_),
+    inv_Q_(wna.inv_Q_),
+    log_normalizer_(wna.log_normalizer_),
     gauss_rnd_sample_(wna.gauss_rnd_sample_)
 { }
 
@@ -73,6 +78,8 @@ WhiteNoiseAcceleration::WhiteNoiseAcceleration(WhiteNoiseAcceleration&& wna) noe
     Q_(std::move(wna.Q_)),
     tilde_q_(wna.tilde_q_),
     sqrt_Q_(std::move(wna.sqrt_Q_)),
+    inv_Q_(std::move(wna.inv_Q_)),
+    log_normalizer_(wna.log_normalizer_),
     gauss_rnd_sample_(std::move(wna.gauss_rnd_sample_))
 {
     wna.T_       = 0.0;
@@ -97,6 +104,8 @@ WhiteNoiseAcceleration& WhiteNoiseAcceleration::operator=(WhiteNoiseAcceleration
     tilde_q_ = wna.tilde_q_;
 
     sqrt_Q_           = std::move(wna.sqrt_Q_);
+    inv_Q_            = std::move(wna.inv_Q_);
+    log_normalizer_   = wna.log_normalizer_;
     generator_        = std::move(wna.generator_);
     distribution_     = std::move(wna.distribution_);
     gauss_rnd_sample_ = std::move(wna.gauss_rnd_sample_);
@@ -132,16 +141,16 @@ MatrixXd WhiteNoiseAcceleration::getStateTransitionMatrix()
 
 VectorXd WhiteNoiseAcceleration::getTransitionProbability(const Ref<const MatrixXd>& prev_states, Ref<MatrixXd> cur_states)
 {
-    VectorXd probabilities(prev_states.cols());
-    MatrixXd differences = cur_states - prev_states;
+    return getLogTransitionProbability(prev_states, cur_states).array().exp();
+}
 
-    std::size_t size = differences.rows();
-    for (std::size_t i = 0; i < prev_states.cols(); i++)
-    {
-        probabilities(i) = (-0.5 * static_cast<double>(size) * log(2.0 * M_PI) + -0.5 * log(Q_.determinant()) -0.5 * (differences.col(i).transpose() * Q_.inverse() * differences.col(i)).array()).exp().coeff(0);
-    }
 
-    return probabilities;
+VectorXd WhiteNoiseAcceleration::getLogTransitionProbability(const Ref<const MatrixXd>& prev_states, Ref<MatrixXd> cur_states)
+{
+    state_differences_ = cur_states - prev_states;
+
+    /* All the squared Mahalanobis distances are the column sums of (x_k - x_{k-1}) .* (Q^{-1} * (x_k - x_{k-1})). */
+    return (log_normalizer_ - 0.5 * (inv_Q_ * state_differences_).cwiseProduct(state_differences_).colwise().sum().array()).transpose();
 }
 
 
@@ -7,29 +7,98 @@ using namespace bfl::directional_statistics;
 using namespace Eigen;
 
 
+namespace
+{
+    constexpr double pi = EIGEN_PI;
+
+    constexpr double two_pi = 2.0 * EIGEN_PI;
+
+    constexpr double inv_two_pi = 1.0 / (2.0 * EIGEN_PI);
+
+
+    /**
+     * Wrap the angles in (-pi, pi] as angle - 2pi * ceil((angle - pi) / 2pi),
+     * a branch-free expression that is evaluated coefficient-wise.
+     */
+    void wrap(Ref<VectorXd> angle)
+    {
+        angle.array() -= two_pi * ((angle.array() - pi) * inv_two_pi).ceil();
+    }
+}
+
+
 MatrixXd bfl::directional_statistics::directional_add(const Ref<const MatrixXd>& a, const Ref<const VectorXd>& b)
 {
-    /* Let M = a.colwise() + b.
-       Then Mij = arg(exp(j * Mij)) where j is the imaginary unit
-       and arg(x) is the phase angle of the complex number x. */
-    return (std::complex<double>(0.0, 1.0) * (a.colwise() + b)).array().exp().arg();
+    MatrixXd result(a.rows(), a.cols());
+    directional_add(a, b, result);
+
+    return result;
 }
 
 
 MatrixXd bfl::directional_statistics::directional_sub(const Ref<const MatrixXd>& a, const Ref<const VectorXd>& b)
 {
-    return directional_add(a, -b);
+    MatrixXd result(a.rows(), a.cols());
+    directional_sub(a, b, result);
+
+    return result;
 }
 
 
 VectorXd bfl::directional_statistics::directional_mean(const Ref<const MatrixXd>& a, const Ref<const VectorXd>& w)
+{
+    VectorXd mean(a.rows());
+    directional_mean(a, w, mean);
+
+    return mean;
+}
+
+
+void bfl::directional_statistics::directional_add(const Ref<const MatrixXd>& a, const Ref<const VectorXd>& b, Ref<MatrixXd> result)
+{
+    /* Let M = a.colwise() + b.
+       Then Mij is wrapped in (-pi, pi], as arg(exp(j * Mij)) where j is the imaginary unit
+       and arg(x) is the phase angle of the complex number x. */
+    for (Index k = 0; k < a.cols(); k++)
+    {
+        result.col(k) = a.col(k) + b;
+        wrap(result.col(k));
+    }
+}
+
+
+void bfl::directional_statistics::directional_sub(const Ref<const MatrixXd>& a, const Ref<const VectorXd>& b, Ref<MatrixXd> result)
+{
+    for (Index k = 0; k < a.cols(); k++)
+    {
+        result.col(k) = a.col(k) - b;
+        wrap(result.col(k));
+    }
+}
+
+
+void bfl::directional_statistics::directional_mean(const Ref<const MatrixXd>& a, const Ref<const VectorXd>& w, Ref<VectorXd> result)
 {
     /* If one column only is provided, it is returned as is. */
     if (a.cols() == 1)
-        return a.col(0);
-    
-    /* For each row i of the matrix a,
-       the method computes the sum of exponentials sum(w_{k} * e^(j*a_{ik})) where j is the imaginary unit
-       and then extract the phase angle using the method arg(x). */
-   return ((std::complex<double>(0.0, 1.0) * a).array().exp().matrix() * w).array().arg();
+    {
+        result = a.col(0);
+        return;
+    }
+
+    /* For each row i of the matrix a, the phase angle of the sum of exponentials sum(w_{k} * e^(j*a_{ik})),
+       where j is the imaginary unit, is the angle atan2(sum(w_{k} * sin(a_{ik})), sum(w_{k} * cos(a_{ik}))).
+       The sums are accumulated row by row in scalars, hence no buffer is needed. */
+    for (Index i = 0; i < a.rows(); i++)
+    {
+        double sin_sum = 0.0;
+        double cos_sum = 0.0;
+        for (Index k = 0; k < a.cols(); k++)
+        {
+            sin_sum += w(k) * std::sin(a(i, k));
+            cos_sum += w(k) * std::cos(a(i, k));
+        }
+
+        result(i) = std::atan2(sin_sum, cos_sum);
+    }
 }
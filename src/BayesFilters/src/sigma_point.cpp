@@ -1,6 +1,9 @@
 #include <BayesFilters/sigma_point.h>
 #include <BayesFilters/directional_statistics.h>
 
+#include <algorithm>
+
+#include <Eigen/Cholesky>
 #include <Eigen/SVD>
 
 using namespace bfl;
@@ -17,9 +20,59 @@ bfl::sigma_point::UTWeight::UTWeight
     const double kappa
 ) :
     mean((2 * n) + 1),
-    covariance((2 * n) + 1)
+    covariance((2 * n) + 1),
+    point_set(SigmaPointSet::Symmetric),
+    points(n, (2 * n) + 1)
 {
     unscented_weights(n, alpha, beta, kappa, mean, covariance, c);
+
+    points << VectorXd::Zero(n), std::sqrt(c) * MatrixXd::Identity(n, n), -std::sqrt(c) * MatrixXd::Identity(n, n);
+}
+
+
+bfl::sigma_point::UTWeight::UTWeight
+(
+    const SigmaPointSet point_set,
+    const std::size_t n,
+    const double w0
+) :
+    point_set(point_set)
+{
+    switch (point_set)
+    {
+        case SigmaPointSet::Symmetric:
+        {
+            /* With alpha = 1 and beta = 0, the weight of the center point is kappa / (n + kappa). */
+            *this = UTWeight(n, 1.0, 0.0, w0 * n / (1.0 - w0));
+
+            break;
+        }
+
+        case SigmaPointSet::SphericalSimplex:
+        {
+            mean.resize(n + 2);
+            covariance.resize(n + 2);
+            points.resize(n, n + 2);
+            c = 0.0;
+
+            spherical_simplex_weights(n, w0, mean, covariance, points);
+
+            break;
+        }
+
+        case SigmaPointSet::Cubature:
+        {
+            mean.resize(2 * n);
+            covariance.resize(2 * n);
+            points.resize(n, 2 * n);
+
+            cubature_weights(n, mean, covariance, c);
+
+            points << std::sqrt(c) * MatrixXd::Identity(n, n), -std::sqrt(c) * MatrixXd::Identity(n, n);
+
+            break;
+        }
+    }
 }
 
 
@@ -54,203 +107,607 @@ void bfl::sigma_point::unscented_weights
 }
 
 
-MatrixXd bfl::sigma_point::sigma_point(const GaussianMixture& state, const double c)
+void bfl::sigma_point::spherical_simplex_weights
+(
+    const std::size_t n,
+    const double w0,
+    Ref<VectorXd> weight_mean,
+    Ref<VectorXd> weight_covariance,
+    Ref<MatrixXd> points
+)
 {
-    MatrixXd sigma_points(state.dim, ((state.dim * 2) + 1) * state.components);
+    double w1 = (1.0 - w0) / (n + 1);
 
-    for (std::size_t i = 0; i < state.components; i++)
+    weight_mean(0) = w0;
+    weight_mean.tail(n + 1).setConstant(w1);
+    weight_covariance = weight_mean;
+
+    /* The points are built one dimension at a time: the j-th coordinate is zero for
+       the center point and the first j - 1 points, negative for the following j points
+       and positive for the (j + 1)-th point. */
+    points.setZero();
+    for (std::size_t j = 1; j <= n; ++j)
+    {
+        double scale = 1.0 / std::sqrt(j * (j + 1) * w1);
+
+        points.block(j - 1, 1, 1, j).setConstant(-scale);
+        points(j - 1, j + 1) = j * scale;
+    }
+}
+
+
+void bfl::sigma_point::cubature_weights
+(
+    const std::size_t n,
+    Ref<VectorXd> weight_mean,
+    Ref<VectorXd> weight_covariance,
+    double& c
+)
+{
+    weight_mean.setConstant(1.0 / (2 * n));
+    weight_covariance = weight_mean;
+
+    c = n;
+}
+
+namespace
+{
+    /**
+     * Square root of a covariance matrix, as in sigma_point::square_root(),
+     * using the given decompositions to avoid allocating them.
+     */
+    SquareRootMethod evaluate_square_root
+    (
+        const Ref<const MatrixXd>& covariance,
+        Ref<MatrixXd> sqrt_covariance,
+        LLT<MatrixXd>& chol_llt,
+        LDLT<MatrixXd>& chol_ldlt
+    )
     {
-        JacobiSVD<MatrixXd> svd = state.covariance(i).jacobiSvd(ComputeThinU);
+        chol_llt.compute(covariance);
+        if (chol_llt.info() == Success)
+        {
+            sqrt_covariance = chol_llt.matrixL();
 
-        MatrixXd A = svd.matrixU() * svd.singularValues().cwiseSqrt().asDiagonal();
+            return SquareRootMethod::LLT;
+        }
+
+        /* The LDL' decomposition, with pivoting, handles positive semidefinite matrices. */
+        chol_ldlt.compute(covariance);
+        if ((chol_ldlt.info() == Success) && (chol_ldlt.vectorD().array() >= 0.0).all())
+        {
+            sqrt_covariance = (chol_ldlt.transpositionsP() * MatrixXd::Identity(covariance.rows(), covariance.cols())).transpose() *
+                              chol_ldlt.matrixL() *
+                              chol_ldlt.vectorD().cwiseSqrt().asDiagonal();
 
-        Ref<MatrixXd> sp = sigma_points.middleCols(((state.dim * 2) + 1) * i, ((state.dim * 2) + 1));
+            return SquareRootMethod::LDLT;
+        }
 
-        sp << VectorXd::Zero(state.dim), std::sqrt(c) * A, -std::sqrt(c) * A;
+        JacobiSVD<MatrixXd> svd = covariance.jacobiSvd(ComputeThinU);
+        sqrt_covariance = svd.matrixU() * svd.singularValues().cwiseSqrt().asDiagonal();
+
+        return SquareRootMethod::SVD;
+    }
+
+
+    /**
+     * Evaluate in `sigma_points` the sigma points of the set `point_set` for the i-th component
+     * of the mixture `state`, given the square root A of its covariance matrix.
+     * The standard normal sigma points `points` are required only by the SphericalSimplex set.
+     */
+    void place_sigma_points
+    (
+        const GaussianMixture& state,
+        const std::size_t i,
+        const Ref<const MatrixXd>& A,
+        const SigmaPointSet point_set,
+        const double c,
+        const Ref<const MatrixXd>& points,
+        Ref<MatrixXd> sigma_points
+    )
+    {
+        if (point_set == SigmaPointSet::Symmetric)
+            sigma_points << VectorXd::Zero(state.dim), std::sqrt(c) * A, -std::sqrt(c) * A;
+        else if (point_set == SigmaPointSet::Cubature)
+            sigma_points << std::sqrt(c) * A, -std::sqrt(c) * A;
+        else
+            sigma_points.noalias() = A * points;
 
         if (state.dim_linear > 0)
-            sp.topRows(state.dim_linear).colwise() += state.mean(i).topRows(state.dim_linear);
+            sigma_points.topRows(state.dim_linear).colwise() += state.mean(i).topRows(state.dim_linear);
 
         if (state.dim_circular > 0)
-            sp.middleRows(state.dim_linear, state.dim_circular) = directional_add(sp.middleRows(state.dim_linear, state.dim_circular), state.mean(i).middleRows(state.dim_linear, state.dim_circular));
+            directional_add(sigma_points.middleRows(state.dim_linear, state.dim_circular), state.mean(i).middleRows(state.dim_linear, state.dim_circular), sigma_points.middleRows(state.dim_linear, state.dim_circular));
 
         if (state.dim_noise > 0)
-            sp.bottomRows(state.dim_noise).colwise() += state.mean(i).bottomRows(state.dim_noise);
+            sigma_points.bottomRows(state.dim_noise).colwise() += state.mean(i).bottomRows(state.dim_noise);
+    }
+
+
+    /**
+     * Evaluate the sigma points of the set `point_set` for all the components of the mixture `state`
+     * in `workspace.input_sigma_points`. The standard normal sigma points `points` are required
+     * only by the SphericalSimplex set.
+     */
+    void evaluate_sigma_points(const GaussianMixture& state, const SigmaPointSet point_set, const double c, const Ref<const MatrixXd>& points, UTWorkspace& workspace)
+    {
+        std::size_t base = (state.dim * 2) + 1;
+        if (point_set == SigmaPointSet::Cubature)
+            base = state.dim * 2;
+        else if (point_set == SigmaPointSet::SphericalSimplex)
+            base = points.cols();
+
+        workspace.input_sigma_points.resize(state.dim, base * state.components);
+        workspace.sqrt_covariance.resize(state.dim, state.dim);
+        workspace.methods.resize(state.components);
+
+        for (std::size_t i = 0; i < state.components; i++)
+        {
+            workspace.methods[i] = evaluate_square_root(state.covariance(i), workspace.sqrt_covariance, workspace.llt, workspace.ldlt);
+
+            place_sigma_points(state, i, workspace.sqrt_covariance, point_set, c, points, workspace.input_sigma_points.middleCols(base * i, base));
+        }
     }
 
-    return sigma_points;
+
+    /**
+     * Store in `triangular` the transpose of the triangular factor of the QR decomposition of `workspace.compound`,
+     * i.e. a lower triangular matrix S such that S * S' = compound' * compound.
+     * The signs are chosen such that the diagonal of S is non-negative.
+     */
+    void triangularize(UTWorkspace& workspace, Ref<MatrixXd> triangular)
+    {
+        const std::size_t size = workspace.compound.cols();
+        const std::size_t rank = std::min<std::size_t>(workspace.compound.rows(), size);
+
+        workspace.qr.compute(workspace.compound);
+
+        triangular.setZero();
+        triangular.leftCols(rank) = workspace.qr.matrixQR().topRows(rank).transpose();
+        triangular.leftCols(rank).triangularView<StrictlyUpper>().setZero();
+
+        for (std::size_t j = 0; j < rank; j++)
+        {
+            if (triangular(j, j) < 0.0)
+                triangular.col(j) = -triangular.col(j);
+        }
+    }
+
+
+    /**
+     * Evaluate the sigma points of the set in `weight` for all the components of `state` in `workspace.input_sigma_points`.
+     */
+    void evaluate_sigma_points(const GaussianMixture& state, const UTWeight& weight, UTWorkspace& workspace)
+    {
+        evaluate_sigma_points(state, weight.point_set, weight.c, weight.points, workspace);
+    }
+
+
+    /**
+     * Evaluate the statistics of the sigma points `workspace.prop_sigma_points`, propagated from the sigma points
+     * `workspace.input_sigma_points` of `input`, in `workspace.output` and `workspace.cross_covariance`.
+     */
+    void propagated_statistics(const GaussianMixture& input, const UTWeight& weight, const OutputSize& output_size, UTWorkspace& workspace)
+    {
+        const std::size_t base = weight.mean.size();
+        const std::size_t output_dim = workspace.prop_sigma_points.rows();
+
+        /* Initialize transformed gaussian. */
+        GaussianMixture& output = workspace.output;
+        if ((output.components != input.components) || (output.dim != output_dim) || (output.dim_noise != 0))
+            output = GaussianMixture(input.components, output_dim);
+
+        /* Initialize cross covariance matrix and the buffer of the weighted sigma points. */
+        workspace.cross_covariance.resize(input.dim, output.dim * output.components);
+        workspace.weighted_sigma_points.resize(std::max(input.dim, output.dim), base);
+
+        /* Process all the components of the mixture. */
+        for (std::size_t i = 0; i < input.components; i++)
+        {
+            Ref<MatrixXd> input_sigma_points_i = workspace.input_sigma_points.middleCols(base * i, base);
+            Ref<MatrixXd> prop_sigma_points_i = workspace.prop_sigma_points.middleCols(base * i, base);
+
+            /* Evaluate the mean. */
+            output.mean(i).topRows(output_size.first).noalias() = prop_sigma_points_i.topRows(output_size.first) * weight.mean;
+            if (output_size.second > 0)
+                output.mean(i).bottomRows(output_size.second) = directional_mean(prop_sigma_points_i.bottomRows(output_size.second), weight.mean);
+
+            /* Evaluate the covariance. */
+            prop_sigma_points_i.topRows(output_size.first).colwise() -= output.mean(i).topRows(output_size.first);
+            if (output_size.second > 0)
+                directional_sub(prop_sigma_points_i.bottomRows(output_size.second), output.mean(i).bottomRows(output_size.second), prop_sigma_points_i.bottomRows(output_size.second));
+
+            Ref<MatrixXd> weighted_prop_sigma_points_i = workspace.weighted_sigma_points.topRows(output.dim);
+            weighted_prop_sigma_points_i.noalias() = prop_sigma_points_i * weight.covariance.asDiagonal();
+            output.covariance(i).noalias() = weighted_prop_sigma_points_i * prop_sigma_points_i.transpose();
+
+            /* Evaluate the input-output cross covariance matrix
+               (noise components in the input are not considered). */
+            Ref<MatrixXd> cross_covariance_i = workspace.cross_covariance.middleCols(output.dim * i, output.dim);
+            input_sigma_points_i.topRows(input.dim_linear).colwise() -= input.mean(i).topRows(input.dim_linear);
+            if (input.dim_circular > 0)
+                directional_sub(input_sigma_points_i.middleRows(input.dim_linear, input.dim_circular), input.mean(i).middleRows(input.dim_linear, input.dim_circular), input_sigma_points_i.middleRows(input.dim_linear, input.dim_circular));
+
+            Ref<MatrixXd> weighted_input_sigma_points_i = workspace.weighted_sigma_points.topRows(input.dim_linear + input.dim_circular);
+            weighted_input_sigma_points_i.noalias() = input_sigma_points_i.topRows(input.dim_linear + input.dim_circular) * weight.covariance.asDiagonal();
+            cross_covariance_i.topRows(input.dim_linear + input.dim_circular).noalias() = weighted_input_sigma_points_i * prop_sigma_points_i.transpose();
+        }
+    }
 }
 
 
-std::tuple<bool, GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+SquareRootMethod bfl::sigma_point::square_root(const Ref<const MatrixXd>& covariance, Ref<MatrixXd> sqrt_covariance)
+{
+    LLT<MatrixXd> chol_llt;
+    LDLT<MatrixXd> chol_ldlt;
+
+    return evaluate_square_root(covariance, sqrt_covariance, chol_llt, chol_ldlt);
+}
+
+
+MatrixXd bfl::sigma_point::sigma_point(const GaussianMixture& state, const double c)
+{
+    std::vector<SquareRootMethod> methods;
+
+    return sigma_point(state, c, methods);
+}
+
+
+MatrixXd bfl::sigma_point::sigma_point(const GaussianMixture& state, const double c, std::vector<SquareRootMethod>& methods)
+{
+    UTWorkspace workspace;
+    evaluate_sigma_points(state, SigmaPointSet::Symmetric, c, MatrixXd(0, 0), workspace);
+
+    methods = std::move(workspace.methods);
+
+    return std::move(workspace.input_sigma_points);
+}
+
+
+MatrixXd bfl::sigma_point::sigma_point(const GaussianMixture& state, const UTWeight& weight)
+{
+    UTWorkspace workspace;
+    evaluate_sigma_points(state, weight, workspace);
+
+    return std::move(workspace.input_sigma_points);
+}
+
+
+void bfl::sigma_point::sigma_point(const GaussianMixture& state, const Ref<const MatrixXd>& sqrt_covariance, const UTWeight& weight, UTWorkspace& workspace)
+{
+    const std::size_t base = weight.mean.size();
+
+    workspace.input_sigma_points.resize(state.dim, base * state.components);
+
+    for (std::size_t i = 0; i < state.components; i++)
+        place_sigma_points(state, i, sqrt_covariance.middleCols(state.dim * i, state.dim), weight.point_set, weight.c, weight.points, workspace.input_sigma_points.middleCols(base * i, base));
+}
+
+
+bool bfl::sigma_point::cholesky_update(Ref<MatrixXd> sqrt_covariance, Ref<VectorXd> vector, const double sigma)
+{
+    const std::size_t size = sqrt_covariance.rows();
+    const double sign = (sigma < 0.0) ? -1.0 : 1.0;
+
+    vector *= std::sqrt(std::abs(sigma));
+
+    for (std::size_t k = 0; k < size; k++)
+    {
+        const double diagonal = sqrt_covariance(k, k);
+        const double squared = (diagonal * diagonal) + (sign * vector(k) * vector(k));
+
+        if ((diagonal <= 0.0) || (squared <= 0.0))
+            return false;
+
+        const double updated = std::sqrt(squared);
+        const double cosine = updated / diagonal;
+        const double sine = vector(k) / diagonal;
+
+        sqrt_covariance(k, k) = updated;
+
+        const std::size_t tail = size - k - 1;
+        if (tail > 0)
+        {
+            sqrt_covariance.col(k).tail(tail) = (sqrt_covariance.col(k).tail(tail) + (sign * sine) * vector.tail(tail)) / cosine;
+            vector.tail(tail) = cosine * vector.tail(tail) - sine * sqrt_covariance.col(k).tail(tail);
+        }
+    }
+
+    return true;
+}
+
+
+bool bfl::sigma_point::triangular_square_root
 (
-    const GaussianMixture& input,
-    const UTWeight& weight,
-    FunctionEvaluation function
+    const Ref<const MatrixXd>& deviations,
+    const Ref<const VectorXd>& weights,
+    const Ref<const MatrixXd>& sqrt_noise,
+    Ref<MatrixXd> sqrt_covariance,
+    UTWorkspace& workspace
 )
 {
-    /* Sample sigma points. */
-    MatrixXd input_sigma_points = sigma_point::sigma_point(input, weight.c);
+    const std::size_t size = deviations.rows();
+    const std::size_t noise_size = sqrt_noise.cols();
+    const std::size_t positive = (weights.array() >= 0.0).count();
 
-    /* Propagate sigma points */
-    Data fun_data;
-    bool valid_fun_data;
-    bfl::sigma_point::OutputSize output_size;
-    std::tie(valid_fun_data, fun_data, output_size) = function(input_sigma_points);
+    /* Triangularize the deviations having non-negative weight together with the square root of the noise. */
+    workspace.compound.resize(positive + noise_size, size);
 
-    /* Stop here if function evaluation failed. */
-    if (!valid_fun_data)
-        return std::make_tuple(false, GaussianMixture(), MatrixXd(0, 0));
+    std::size_t row = 0;
+    for (std::size_t j = 0; j < static_cast<std::size_t>(weights.size()); j++)
+    {
+        if (weights(j) >= 0.0)
+            workspace.compound.row(row++) = std::sqrt(weights(j)) * deviations.col(j).transpose();
+    }
+    if (noise_size > 0)
+        workspace.compound.bottomRows(noise_size) = sqrt_noise.transpose();
 
-    /* For now casting Data to MatrixXd. */
-    MatrixXd prop_sigma_points = bfl::any::any_cast<MatrixXd&&>(std::move(fun_data));
+    triangularize(workspace, sqrt_covariance);
+
+    /* Remove the deviations having negative weight. */
+    bool valid = true;
+    for (std::size_t j = 0; (j < static_cast<std::size_t>(weights.size())) && valid; j++)
+    {
+        if (weights(j) < 0.0)
+        {
+            workspace.update_vector = deviations.col(j);
+            valid = cholesky_update(sqrt_covariance, workspace.update_vector, weights(j));
+        }
+    }
+
+    if (valid)
+        return true;
 
-    /* Initialize transformed gaussian. */
-    GaussianMixture output(input.components, prop_sigma_points.rows());
+    /* Fall back to the square root of the whole matrix. */
+    MatrixXd covariance = deviations * weights.asDiagonal() * deviations.transpose();
+    if (noise_size > 0)
+        covariance.noalias() += sqrt_noise * sqrt_noise.transpose();
 
-    /* Initialize cross covariance matrix. */
-    MatrixXd cross_covariance(input.dim, output.dim * output.components);
+    workspace.sqrt_covariance.resize(size, size);
+    evaluate_square_root(covariance, workspace.sqrt_covariance, workspace.llt, workspace.ldlt);
+
+    workspace.compound = workspace.sqrt_covariance.transpose();
+    triangularize(workspace, sqrt_covariance);
+
+    return false;
+}
+
+
+const GaussianMixture& bfl::sigma_point::augment_with_noise
+(
+    const GaussianMixture& state,
+    const Ref<const MatrixXd>& noise_covariance_matrix,
+    UTWorkspace& workspace
+)
+{
+    GaussianMixture& augmented = workspace.augmented_input;
+    const std::size_t dim_noise = noise_covariance_matrix.rows();
 
-    /* Process all the components of the mixture. */
-    std::size_t base = ((input.dim * 2) + 1);
-    for (std::size_t i = 0; i < input.components; i++)
+    if ((augmented.components != state.components) || (augmented.dim_linear != state.dim_linear) ||
+        (augmented.dim_circular != state.dim_circular) || (augmented.dim != state.dim + dim_noise))
     {
-        Ref<MatrixXd> input_sigma_points_i = input_sigma_points.middleCols(base * i, base);
-        Ref<MatrixXd> prop_sigma_points_i = prop_sigma_points.middleCols(base * i, base);
-
-        /* Evaluate the mean. */
-        output.mean(i).topRows(output_size.first).noalias() = prop_sigma_points_i.topRows(output_size.first) * weight.mean;
-        output.mean(i).bottomRows(output_size.second) =  directional_mean(prop_sigma_points_i.bottomRows(output_size.second), weight.mean);
-
-        /* Evaluate the covariance. */
-        prop_sigma_points_i.topRows(output_size.first).colwise() -= output.mean(i).topRows(output_size.first);
-        prop_sigma_points_i.bottomRows(output_size.second) = directional_sub(prop_sigma_points_i.bottomRows(output_size.second), output.mean(i).bottomRows(output_size.second));
-        output.covariance(i).noalias() = prop_sigma_points_i * weight.covariance.asDiagonal() * prop_sigma_points_i.transpose();
-
-        /* Evaluate the input-output cross covariance matrix
-           (noise components in the input are not considered). */
-        Ref<MatrixXd> cross_covariance_i = cross_covariance.middleCols(output.dim * i, output.dim);
-        input_sigma_points_i.topRows(input.dim_linear).colwise() -= input.mean(i).topRows(input.dim_linear);
-        input_sigma_points_i.middleRows(input.dim_linear, input.dim_circular) = directional_sub(input_sigma_points_i.middleRows(input.dim_linear, input.dim_circular), input.mean(i).middleRows(input.dim_linear, input.dim_circular));
-        cross_covariance_i.noalias() = input_sigma_points_i.topRows(input.dim_linear + input.dim_circular) * weight.covariance.asDiagonal() * prop_sigma_points_i.transpose();
+        augmented = state;
+        augmented.augmentWithNoise(noise_covariance_matrix);
+
+        return augmented;
     }
 
-    return std::make_tuple(true, output, cross_covariance);
+    /* Same sizes as in the previous call, copy the state in place. */
+    for (std::size_t i = 0; i < state.components; i++)
+    {
+        augmented.mean(i).topRows(state.dim) = state.mean(i);
+        augmented.mean(i).bottomRows(dim_noise).setZero();
+
+        augmented.covariance(i).setZero();
+        augmented.covariance(i).topLeftCorner(state.dim, state.dim) = state.covariance(i);
+        augmented.covariance(i).bottomRightCorner(dim_noise, dim_noise) = noise_covariance_matrix;
+    }
+    augmented.weight() = state.weight();
+
+    return augmented;
 }
 
 
-std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+void bfl::sigma_point::unscented_transform
 (
     const GaussianMixture& state,
     const UTWeight& weight,
-    StateModel& state_model
+    StateModel& state_model,
+    UTWorkspace& workspace
 )
 {
-    FunctionEvaluation f = [&state_model](const Ref<const MatrixXd>& state)
-                           {
-                               MatrixXd tmp(state.rows(), state.cols());
+    evaluate_sigma_points(state, weight, workspace);
 
-                               state_model.motion(state, tmp);
+    workspace.prop_sigma_points.resize(workspace.input_sigma_points.rows(), workspace.input_sigma_points.cols());
+    state_model.motion(workspace.input_sigma_points, workspace.prop_sigma_points);
 
-                               return std::make_tuple(true, std::move(tmp), state_model.getOutputSize());
-                           };
-    MatrixXd cross_covariance;
-    GaussianMixture output;
-    std::tie(std::ignore, output, cross_covariance) = unscented_transform(state, weight, f);
-
-    return std::make_pair(output, cross_covariance);
+    propagated_statistics(state, weight, state_model.getOutputSize(), workspace);
 }
 
 
-std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+void bfl::sigma_point::unscented_transform
 (
     const GaussianMixture& state,
     const UTWeight& weight,
     StateModel& state_model,
-    ExogenousModel& exogenous_model
+    ExogenousModel& exogenous_model,
+    UTWorkspace& workspace
 )
 {
-    FunctionEvaluation f = [&state_model, &exogenous_model](const Ref<const MatrixXd>& state)
-                           {
-                               MatrixXd tmp_state(state.rows(), state.cols());
-                               state_model.motion(state, tmp_state);
-
-                               MatrixXd tmp_exog(tmp_state.rows(), tmp_state.cols());
-                               exogenous_model.propagate(tmp_state, tmp_exog);
-
-                               /* Making the assumption that
-                                  state_model.getOutputSize() == exogenous_model.getOutputSize(). */
-                               return std::make_tuple(true, std::move(tmp_exog), state_model.getOutputSize());
-                           };
-    MatrixXd cross_covariance;
-    GaussianMixture output;
-    std::tie(std::ignore, output, cross_covariance) = unscented_transform(state, weight, f);
-
-    return std::make_pair(output, cross_covariance);
+    evaluate_sigma_points(state, weight, workspace);
+
+    workspace.tmp_sigma_points.resize(workspace.input_sigma_points.rows(), workspace.input_sigma_points.cols());
+    state_model.motion(workspace.input_sigma_points, workspace.tmp_sigma_points);
+
+    workspace.prop_sigma_points.resize(workspace.tmp_sigma_points.rows(), workspace.tmp_sigma_points.cols());
+    exogenous_model.propagate(workspace.tmp_sigma_points, workspace.prop_sigma_points);
+
+    /* Making the assumption that
+       state_model.getOutputSize() == exogenous_model.getOutputSize(). */
+    propagated_statistics(state, weight, state_model.getOutputSize(), workspace);
 }
 
 
-std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+void bfl::sigma_point::unscented_transform
 (
     const GaussianMixture& state,
     const UTWeight& weight,
-    AdditiveStateModel& state_model
+    AdditiveStateModel& state_model,
+    UTWorkspace& workspace
 )
 {
-    FunctionEvaluation f = [&state_model](const Ref<const MatrixXd>& state)
-                           {
-                               MatrixXd tmp(state.rows(), state.cols());
+    evaluate_sigma_points(state, weight, workspace);
 
-                               state_model.propagate(state, tmp);
+    workspace.prop_sigma_points.resize(workspace.input_sigma_points.rows(), workspace.input_sigma_points.cols());
+    state_model.propagate(workspace.input_sigma_points, workspace.prop_sigma_points);
 
-                               return std::make_tuple(true, std::move(tmp), state_model.getOutputSize());
-                           };
+    propagated_statistics(state, weight, state_model.getOutputSize(), workspace);
+
+    /* In the additive case the covariance matrix is augmented with the noise
+       covariance matrix. */
+    const MatrixXd noise_covariance_matrix = state_model.getNoiseCovarianceMatrix();
+    for (std::size_t i = 0; i < state.components; i++)
+        workspace.output.covariance(i) += noise_covariance_matrix;
+}
 
-    MatrixXd cross_covariance;
-    GaussianMixture output;
-    std::tie(std::ignore, output, cross_covariance) = unscented_transform(state, weight, f);
+
+void bfl::sigma_point::unscented_transform
+(
+    const GaussianMixture& state,
+    const UTWeight& weight,
+    AdditiveStateModel& state_model,
+    ExogenousModel& exogenous_model,
+    UTWorkspace& workspace
+)
+{
+    evaluate_sigma_points(state, weight, workspace);
+
+    workspace.tmp_sigma_points.resize(workspace.input_sigma_points.rows(), workspace.input_sigma_points.cols());
+    state_model.propagate(workspace.input_sigma_points, workspace.tmp_sigma_points);
+
+    workspace.prop_sigma_points.resize(workspace.tmp_sigma_points.rows(), workspace.tmp_sigma_points.cols());
+    exogenous_model.propagate(workspace.tmp_sigma_points, workspace.prop_sigma_points);
+
+    /* Making the assumption that
+       state_model.getOutputSize() == exogenous_model.getOutputSize(). */
+    propagated_statistics(state, weight, state_model.getOutputSize(), workspace);
 
     /* In the additive case the covariance matrix is augmented with the noise
        covariance matrix. */
-    for(std::size_t i = 0; i < state.components; i++)
-        output.covariance(i) += state_model.getNoiseCovarianceMatrix();
+    const MatrixXd noise_covariance_matrix = state_model.getNoiseCovarianceMatrix();
+    for (std::size_t i = 0; i < state.components; i++)
+        workspace.output.covariance(i) += noise_covariance_matrix;
+}
 
-    return std::make_pair(output, cross_covariance);
+
+void bfl::sigma_point::unscented_transform
+(
+    const GaussianMixture& state,
+    const UTWeight& weight,
+    ExogenousModel& exogenous_model,
+    UTWorkspace& workspace
+)
+{
+    evaluate_sigma_points(state, weight, workspace);
+
+    workspace.prop_sigma_points.resize(workspace.input_sigma_points.rows(), workspace.input_sigma_points.cols());
+    exogenous_model.propagate(workspace.input_sigma_points, workspace.prop_sigma_points);
+
+    propagated_statistics(state, weight, exogenous_model.getOutputSize(), workspace);
 }
 
 
-std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+bool bfl::sigma_point::unscented_transform
 (
     const GaussianMixture& state,
     const UTWeight& weight,
-    AdditiveStateModel& state_model,
-    ExogenousModel& exogenous_model
+    MeasurementModel& meas_model,
+    UTWorkspace& workspace
 )
 {
-    FunctionEvaluation f = [&state_model, &exogenous_model](const Ref<const MatrixXd>& state)
-                           {
-                               MatrixXd tmp_state(state.rows(), state.cols());
-                               state_model.propagate(state, tmp_state);
+    evaluate_sigma_points(state, weight, workspace);
 
-                               MatrixXd tmp_exog(tmp_state.rows(), tmp_state.cols());
-                               exogenous_model.propagate(tmp_state, tmp_exog);
+    bool valid_prediction;
+    Data prediction;
+    std::tie(valid_prediction, prediction) = meas_model.predictedMeasure(workspace.input_sigma_points);
 
-                               /* Making the assumption that
-                                  state_model.getOutputSize() == exogenous_model.getOutputSize(). */
-                               return std::make_tuple(true, std::move(tmp_exog), state_model.getOutputSize());
-                           };
+    if (!valid_prediction)
+        return false;
 
-    bool valid;
-    MatrixXd cross_covariance;
-    GaussianMixture output;
-    std::tie(valid, output, cross_covariance) = unscented_transform(state, weight, f);
+    /* The measurement model returns its own matrix, which replaces the buffer of the workspace. */
+    workspace.prop_sigma_points = any::any_cast<MatrixXd&&>(std::move(prediction));
+
+    propagated_statistics(state, weight, meas_model.getOutputSize(), workspace);
+
+    return true;
+}
+
+
+bool bfl::sigma_point::unscented_transform
+(
+    const GaussianMixture& state,
+    const UTWeight& weight,
+    AdditiveMeasurementModel& meas_model,
+    UTWorkspace& workspace
+)
+{
+    MeasurementModel& model = meas_model;
+    if (!unscented_transform(state, weight, model, workspace))
+        return false;
 
     /* In the additive case the covariance matrix is augmented with the noise
        covariance matrix. */
+    MatrixXd noise_covariance_matrix;
+    std::tie(std::ignore, noise_covariance_matrix) = meas_model.getNoiseCovarianceMatrix();
     for (std::size_t i = 0; i < state.components; i++)
-        output.covariance(i) += state_model.getNoiseCovarianceMatrix();
+        workspace.output.covariance(i) += noise_covariance_matrix;
+
+    return true;
+}
+
+
+std::tuple<bool, GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+(
+    const GaussianMixture& input,
+    const UTWeight& weight,
+    FunctionEvaluation function
+)
+{
+    UTWorkspace workspace;
+
+    /* Sample sigma points. */
+    evaluate_sigma_points(input, weight, workspace);
+
+    /* Propagate sigma points */
+    Data fun_data;
+    bool valid_fun_data;
+    bfl::sigma_point::OutputSize output_size;
+    std::tie(valid_fun_data, fun_data, output_size) = function(workspace.input_sigma_points);
+
+    /* Stop here if function evaluation failed. */
+    if (!valid_fun_data)
+        return std::make_tuple(false, GaussianMixture(), MatrixXd(0, 0));
+
+    /* For now casting Data to MatrixXd. */
+    workspace.prop_sigma_points = bfl::any::any_cast<MatrixXd&&>(std::move(fun_data));
+
+    propagated_statistics(input, weight, output_size, workspace);
+
+    return std::make_tuple(true, std::move(workspace.output), std::move(workspace.cross_covariance));
+}
+
+
+std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+(
+    const GaussianMixture& state,
+    const UTWeight& weight,
+    StateModel& state_model
+)
+{
+    UTWorkspace workspace;
+    unscented_transform(state, weight, state_model, workspace);
 
-    return std::make_pair(output, cross_covariance);
+    return std::make_pair(std::move(workspace.output), std::move(workspace.cross_covariance));
 }
 
 
@@ -258,50 +715,57 @@ std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
 (
     const GaussianMixture& state,
     const UTWeight& weight,
+    StateModel& state_model,
     ExogenousModel& exogenous_model
 )
 {
-    FunctionEvaluation f = [&exogenous_model](const Ref<const MatrixXd>& state)
-                           {
-                               MatrixXd tmp(state.rows(), state.cols());
+    UTWorkspace workspace;
+    unscented_transform(state, weight, state_model, exogenous_model, workspace);
 
-                               exogenous_model.propagate(state, tmp);
+    return std::make_pair(std::move(workspace.output), std::move(workspace.cross_covariance));
+}
 
-                               return std::make_tuple(true, std::move(tmp), exogenous_model.getOutputSize());
-                           };
 
-    bool valid;
-    MatrixXd cross_covariance;
-    GaussianMixture output;
-    std::tie(valid, output, cross_covariance) = unscented_transform(state, weight, f);
+std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+(
+    const GaussianMixture& state,
+    const UTWeight& weight,
+    AdditiveStateModel& state_model
+)
+{
+    UTWorkspace workspace;
+    unscented_transform(state, weight, state_model, workspace);
 
-    return std::make_pair(output, cross_covariance);
+    return std::make_pair(std::move(workspace.output), std::move(workspace.cross_covariance));
 }
 
 
-std::tuple<bool, GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
 (
     const GaussianMixture& state,
     const UTWeight& weight,
-    MeasurementModel& meas_model
+    AdditiveStateModel& state_model,
+    ExogenousModel& exogenous_model
 )
 {
-    FunctionEvaluation f = [&meas_model](const Ref<const MatrixXd>& state)
-                           {
-                               bool valid_prediction;
-                               bfl::Data prediction;
+    UTWorkspace workspace;
+    unscented_transform(state, weight, state_model, exogenous_model, workspace);
 
-                               std::tie(valid_prediction, prediction) = meas_model.predictedMeasure(state);
+    return std::make_pair(std::move(workspace.output), std::move(workspace.cross_covariance));
+}
 
-                               return std::make_tuple(valid_prediction, std::move(prediction), meas_model.getOutputSize());
-                           };
 
-    bool valid;
-    MatrixXd cross_covariance;
-    GaussianMixture output;
-    std::tie(valid, output, cross_covariance) = unscented_transform(state, weight, f);
+std::pair<GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+(
+    const GaussianMixture& state,
+    const UTWeight& weight,
+    ExogenousModel& exogenous_model
+)
+{
+    UTWorkspace workspace;
+    unscented_transform(state, weight, exogenous_model, workspace);
 
-    return std::make_tuple(valid, output, cross_covariance);
+    return std::make_pair(std::move(workspace.output), std::move(workspace.cross_covariance));
 }
 
 
@@ -309,30 +773,25 @@ std::tuple<bool, GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transfor
 (
     const GaussianMixture& state,
     const UTWeight& weight,
-    AdditiveMeasurementModel& meas_model
+    MeasurementModel& meas_model
 )
 {
-    FunctionEvaluation f = [&meas_model](const Ref<const MatrixXd>& state)
-                           {
-                               bool valid_prediction;
-                               bfl::Data prediction;
-
-                               std::tie(valid_prediction, prediction) = meas_model.predictedMeasure(state);
+    UTWorkspace workspace;
+    bool valid = unscented_transform(state, weight, meas_model, workspace);
 
-                               return std::make_tuple(valid_prediction, std::move(prediction), meas_model.getOutputSize());
-                           };
+    return std::make_tuple(valid, std::move(workspace.output), std::move(workspace.cross_covariance));
+}
 
-    bool valid;
-    MatrixXd cross_covariance;
-    GaussianMixture output;
-    std::tie(valid, output, cross_covariance) = unscented_transform(state, weight, f);
 
-    /* In the additive case the covariance matrix is augmented with the noise
-       covariance matrix. */
-    MatrixXd noise_cov;
-    std::tie(std::ignore, noise_cov) = meas_model.getNoiseCovarianceMatrix();
-    for (std::size_t i = 0; i < state.components; i++)
-        output.covariance(i) += noise_cov;
+std::tuple<bool, GaussianMixture, MatrixXd> bfl::sigma_point::unscented_transform
+(
+    const GaussianMixture& state,
+    const UTWeight& weight,
+    AdditiveMeasurementModel& meas_model
+)
+{
+    UTWorkspace workspace;
+    bool valid = unscented_transform(state, weight, meas_model, workspace);
 
-    return std::make_tuple(valid, output, cross_covariance);
+    return std::make_tuple(valid, std::move(workspace.output), std::move(workspace.cross_covariance));
 }
@@ -1,10 +1,120 @@
 #include <BayesFilters/utils.h>
+#include <BayesFilters/FilteringExecutor.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 using namespace Eigen;
 
+
+namespace
+{
+    /**
+     * Threads shared by all the calls to parallel_for(), started at the first call with more than one chunk.
+     */
+    bfl::FilteringExecutor& parallel_for_pool()
+    {
+        static bfl::FilteringExecutor pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+
+        return pool;
+    }
+
+    /**
+     * True on the threads of the pool, where parallel_for() runs the chunks serially instead of waiting for the pool.
+     */
+    thread_local bool in_parallel_for_pool = false;
+}
+
 double bfl::utils::log_sum_exp(const Ref<const VectorXd>& arguments)
 {
     double max = arguments.maxCoeff();
 
     return max + log((arguments.array() - max).exp().sum());
 }
+
+
+void bfl::utils::parallel_for(const std::size_t num_threads, const std::size_t size, const std::function<void(const std::size_t, const std::size_t)>& body)
+{
+    std::size_t chunks = std::max<std::size_t>(1, std::min(num_threads, size));
+
+    if (chunks == 1)
+    {
+        body(0, size);
+        return;
+    }
+
+    std::size_t chunk_size = size / chunks;
+    std::size_t remainder  = size % chunks;
+
+    /* The first 'remainder' chunks take one more element than the others. */
+    if (in_parallel_for_pool)
+    {
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < chunks; ++i)
+        {
+            std::size_t end = begin + chunk_size + (i < remainder ? 1 : 0);
+
+            body(begin, end);
+
+            begin = end;
+        }
+
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv_done;
+    std::size_t pending = chunks - 1;
+
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < chunks - 1; ++i)
+    {
+        std::size_t end = begin + chunk_size + (i < remainder ? 1 : 0);
+
+        parallel_for_pool().submit([&body, &mutex, &cv_done, &pending, begin, end]()
+                                   {
+                                       in_parallel_for_pool = true;
+
+                                       body(begin, end);
+
+                                       std::lock_guard<std::mutex> lock(mutex);
+                                       if (--pending == 0)
+                                           cv_done.notify_one();
+                                   });
+
+        begin = end;
+    }
+
+    /* The chunks run by the pool refer to the local variables, hence they are waited for also if the last one throws. */
+    std::exception_ptr exception;
+    try
+    {
+        body(begin, size);
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv_done.wait(lock, [&pending]{ return pending == 0; });
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+
+std::pair<bool, SparseMatrix<double>> bfl::utils::sparse_view(const Ref<const MatrixXd>& matrix, const double max_density)
+{
+    const std::size_t non_zeros = (matrix.array() != 0.0).count();
+
+    if ((matrix.size() == 0) || (non_zeros > max_density * matrix.size()))
+        return std::make_pair(false, SparseMatrix<double>());
+
+    return std::make_pair(true, SparseMatrix<double>(matrix.sparseView()));
+}
@@ -0,0 +1,384 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <BayesFilters/BatchKalmanFilter.h>
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/KFCorrection.h>
+#include <BayesFilters/KFPrediction.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * A sensor measuring the position (x, y) of each target, returning the measurements set by the test, one per column.
+ */
+class PositionSensor : public LTIMeasurementModel
+{
+public:
+    PositionSensor(const Ref<const MatrixXd>& noise_covariance_matrix) :
+        LTIMeasurementModel((MatrixXd(2, 4) << 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0).finished(), noise_covariance_matrix)
+    {
+        enableRevisionTracking();
+    }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+    MatrixXd measurement;
+};
+
+
+/**
+ * A position sensor wrapping the innovations of the y coordinate in [-pi, pi), as for an angle.
+ */
+class WrappingPositionSensor : public PositionSensor
+{
+public:
+    WrappingPositionSensor(const Ref<const MatrixXd>& noise_covariance_matrix) :
+        PositionSensor(noise_covariance_matrix)
+    { }
+
+    std::pair<bool, Data> innovation(const Data& predicted_measurements, const Data& measurements) const override
+    {
+        MatrixXd innovations = any::any_cast<MatrixXd&&>(PositionSensor::innovation(predicted_measurements, measurements).second);
+
+        innovations.row(1) = innovations.row(1).unaryExpr([](const double angle) { return angle - 2.0 * M_PI * std::floor((angle + M_PI) / (2.0 * M_PI)); });
+
+        return std::make_pair(true, std::move(innovations));
+    }
+};
+
+
+/**
+ * Filtering steps exposing the protected predictStep() and correctStep().
+ */
+class TestKFPrediction : public KFPrediction
+{
+public:
+    TestKFPrediction(std::unique_ptr<LinearStateModel> state_model) :
+        KFPrediction(std::move(state_model))
+    { }
+
+    void predictStep(const GaussianMixture& prev_state, GaussianMixture& pred_state) override
+    {
+        KFPrediction::predictStep(prev_state, pred_state);
+    }
+};
+
+
+class TestKFCorrection : public KFCorrection
+{
+public:
+    TestKFCorrection(std::unique_ptr<PositionSensor> sensor) :
+        KFCorrection(std::move(sensor))
+    { }
+
+    void correctStep(const GaussianMixture& pred_state, GaussianMixture& corr_state) override
+    {
+        KFCorrection::correctStep(pred_state, corr_state);
+    }
+
+    PositionSensor& getSensor()
+    {
+        return dynamic_cast<PositionSensor&>(getMeasurementModel());
+    }
+};
+
+
+/**
+ * Kalman filters of single targets, one per target.
+ */
+struct Reference
+{
+    Reference(const Ref<const MatrixXd>& R, const std::size_t targets) :
+        prediction(utils::make_unique<WhiteNoiseAcceleration>(0.1, 1.0))
+    {
+        for (std::size_t j = 0; j < targets; j++)
+        {
+            corrections.emplace_back(utils::make_unique<PositionSensor>(R));
+            pred_states.emplace_back(1, 4);
+            corr_states.emplace_back(1, 4);
+        }
+    }
+
+    void step(const Ref<const MatrixXd>& measurements)
+    {
+        for (std::size_t j = 0; j < corrections.size(); j++)
+        {
+            corrections[j].getSensor().measurement = measurements.col(j);
+
+            prediction.predictStep(corr_states[j], pred_states[j]);
+            corrections[j].correctStep(pred_states[j], corr_states[j]);
+        }
+    }
+
+    TestKFPrediction prediction;
+
+    std::vector<TestKFCorrection> corrections;
+
+    std::vector<GaussianMixture> pred_states;
+
+    std::vector<GaussianMixture> corr_states;
+};
+
+
+MatrixXd random_matrix(const std::size_t rows, const std::size_t cols, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    MatrixXd matrix(rows, cols);
+    for (std::size_t i = 0; i < rows * cols; i++)
+        matrix.data()[i] = normal(generator);
+
+    return matrix;
+}
+
+
+MatrixXd random_covariance(const std::size_t size, std::mt19937_64& generator)
+{
+    MatrixXd A = random_matrix(size, size, generator);
+
+    return A * A.transpose() / size + 0.1 * MatrixXd::Identity(size, size);
+}
+
+
+/**
+ * Correct the state of a target with the pseudo-inverse of the covariance matrix of the predicted measurement.
+ */
+void correct_target(VectorXd& mean, MatrixXd& covariance, const Ref<const MatrixXd>& H, const Ref<const MatrixXd>& R, const Ref<const VectorXd>& measurement)
+{
+    const MatrixXd K = covariance * H.transpose() * (H * covariance * H.transpose() + R).completeOrthogonalDecomposition().pseudoInverse();
+
+    mean += K * (measurement - H * mean);
+    covariance -= K * H * covariance;
+}
+
+
+double relative_error(const Ref<const MatrixXd>& value, const Ref<const MatrixXd>& reference)
+{
+    return (value - reference).norm() / std::max(reference.norm(), 1.0);
+}
+
+
+/**
+ * Compare the state of all the targets.
+ */
+double state_error(const BatchKalmanFilter& batch_kf, const Reference& reference)
+{
+    double error = 0.0;
+    for (std::size_t j = 0; j < batch_kf.getNumberOfTargets(); j++)
+    {
+        error = std::max(error, relative_error(batch_kf.getMean(j), reference.corr_states[j].mean()));
+        error = std::max(error, relative_error(batch_kf.getCovariance(j), reference.corr_states[j].covariance()));
+    }
+
+    return error;
+}
+
+
+int main()
+{
+    std::cout << "Running BatchKalmanFilter tests." << std::endl;
+
+    std::mt19937_64 generator(1);
+
+    const MatrixXd R = random_covariance(2, generator);
+
+    /* The batch filter must match the Kalman filters of the single targets, with any number of threads. */
+    for (const unsigned int num_threads : {1, 3})
+    {
+        const std::size_t targets = 50;
+
+        std::unique_ptr<PositionSensor> sensor = utils::make_unique<PositionSensor>(R);
+        PositionSensor& batch_sensor = *sensor;
+        BatchKalmanFilter batch_kf(utils::make_unique<WhiteNoiseAcceleration>(0.1, 1.0), std::move(sensor), targets, num_threads);
+
+        Reference reference(R, targets);
+
+        for (std::size_t j = 0; j < targets; j++)
+        {
+            const VectorXd mean = random_matrix(4, 1, generator);
+            const MatrixXd covariance = random_covariance(4, generator);
+
+            batch_kf.setState(j, mean, covariance);
+            reference.corr_states[j].mean() = mean;
+            reference.corr_states[j].covariance() = covariance;
+        }
+
+        for (std::size_t k = 0; k < 20; k++)
+        {
+            const MatrixXd measurements = random_matrix(2, targets, generator);
+
+            batch_sensor.measurement = measurements;
+            batch_kf.predict();
+            if (!batch_kf.correct())
+            {
+                std::cerr << "[" << num_threads << " threads] Correction failed." << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            reference.step(measurements);
+        }
+
+        const double error = state_error(batch_kf, reference);
+        if (error > 1e-12)
+        {
+            std::cerr << "[" << num_threads << " threads] Wrong state, error " << error << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[" << num_threads << " threads] Passed, error " << error << "." << std::endl;
+    }
+
+    /* The innovations are evaluated by the measurement model: with wrapped angles, measurements differing by 2 * pi give the same state. */
+    {
+        const std::size_t targets = 20;
+
+        BatchKalmanFilter batch_kf(utils::make_unique<WhiteNoiseAcceleration>(0.1, 1.0), utils::make_unique<WrappingPositionSensor>(R), targets);
+        BatchKalmanFilter shifted_batch_kf(utils::make_unique<WhiteNoiseAcceleration>(0.1, 1.0), utils::make_unique<WrappingPositionSensor>(R), targets);
+
+        const MatrixXd measurements = random_matrix(2, targets, generator);
+        MatrixXd shifted_measurements = measurements;
+        shifted_measurements.row(1).array() += 2.0 * M_PI;
+
+        if (!batch_kf.correct(measurements) || !shifted_batch_kf.correct(shifted_measurements))
+        {
+            std::cerr << "[Innovation] Correction failed." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const double error = std::max(relative_error(batch_kf.means(), shifted_batch_kf.means()), relative_error(batch_kf.covariances(), shifted_batch_kf.covariances()));
+        if (error > 1e-12)
+        {
+            std::cerr << "[Innovation] The innovations of the measurement model have not been used, error " << error << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Innovation] Passed." << std::endl;
+    }
+
+    /* A singular covariance matrix of the predicted measurement is inverted with its pseudo-inverse. */
+    {
+        const MatrixXd H = (MatrixXd(2, 4) << 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0).finished();
+        const MatrixXd singular_R = Vector2d(1.0, 0.0).asDiagonal();
+
+        BatchKalmanFilter batch_kf(utils::make_unique<WhiteNoiseAcceleration>(0.1, 1.0), utils::make_unique<PositionSensor>(singular_R), 2);
+
+        std::vector<VectorXd> means = {random_matrix(4, 1, generator), random_matrix(4, 1, generator)};
+        std::vector<MatrixXd> covariances = {MatrixXd::Identity(4, 4), Vector4d(1.0, 1.0, 0.0, 1.0).asDiagonal()};
+        const MatrixXd measurements = random_matrix(2, 2, generator);
+
+        for (std::size_t j = 0; j < 2; j++)
+            batch_kf.setState(j, means[j], covariances[j]);
+
+        const bool corrected = batch_kf.correct(measurements);
+
+        double error = 0.0;
+        for (std::size_t j = 0; j < 2; j++)
+        {
+            correct_target(means[j], covariances[j], H, singular_R, measurements.col(j));
+
+            error = std::max(error, relative_error(batch_kf.getMean(j), means[j]));
+            error = std::max(error, relative_error(batch_kf.getCovariance(j), covariances[j]));
+        }
+
+        if (!corrected || !batch_kf.means().allFinite() || !batch_kf.covariances().allFinite() || (error > 1e-12))
+        {
+            std::cerr << "[Singular] Wrong state, error " << error << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Singular] Passed." << std::endl;
+    }
+
+    /* The targets whose covariance matrix of the predicted measurement is not positive semidefinite are left unchanged. */
+    {
+        const MatrixXd H = (MatrixXd(2, 4) << 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0).finished();
+        const MatrixXd indefinite_R = Vector2d(1.0, -2.0).asDiagonal();
+
+        BatchKalmanFilter batch_kf(utils::make_unique<WhiteNoiseAcceleration>(0.1, 1.0), utils::make_unique<PositionSensor>(indefinite_R), 2);
+
+        std::vector<VectorXd> means = {random_matrix(4, 1, generator), random_matrix(4, 1, generator)};
+        std::vector<MatrixXd> covariances = {MatrixXd::Identity(4, 4), Vector4d(1.0, 1.0, 4.0, 1.0).asDiagonal()};
+        const MatrixXd measurements = random_matrix(2, 2, generator);
+
+        for (std::size_t j = 0; j < 2; j++)
+            batch_kf.setState(j, means[j], covariances[j]);
+
+        const bool corrected = batch_kf.correct(measurements);
+
+        correct_target(means[1], covariances[1], H, indefinite_R, measurements.col(1));
+
+        const double error = std::max({relative_error(batch_kf.getMean(0), means[0]), relative_error(batch_kf.getCovariance(0), covariances[0]),
+                                       relative_error(batch_kf.getMean(1), means[1]), relative_error(batch_kf.getCovariance(1), covariances[1])});
+
+        if (corrected || (error > 1e-12))
+        {
+            std::cerr << "[Indefinite] Wrong state or correction reported as successful, error " << error << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Indefinite] Passed." << std::endl;
+    }
+
+    /* Time a filtering step of 10000 targets with white noise acceleration models. */
+    {
+        const std::size_t targets = 10000;
+        const std::size_t repetitions = 50;
+
+        const MatrixXd measurements = random_matrix(2, targets, generator);
+
+        Reference reference(R, targets);
+        auto start = std::chrono::steady_clock::now();
+        reference.step(measurements);
+        auto stop = std::chrono::steady_clock::now();
+        const double reference_time = std::chrono::duration<double, std::milli>(stop - start).count();
+
+        std::cout << "[Benchmark] " << targets << " targets, one KFPrediction and KFCorrection per target: "
+                  << std::fixed << std::setprecision(2) << reference_time << " ms per step" << std::endl;
+
+        for (const unsigned int num_threads : {1, 2, 4})
+        {
+            BatchKalmanFilter batch_kf(utils::make_unique<WhiteNoiseAcceleration>(0.1, 1.0), utils::make_unique<PositionSensor>(R), targets, num_threads);
+
+            start = std::chrono::steady_clock::now();
+            for (std::size_t k = 0; k < repetitions; k++)
+            {
+                batch_kf.predict();
+                batch_kf.correct(measurements);
+            }
+            stop = std::chrono::steady_clock::now();
+            const double time = std::chrono::duration<double, std::milli>(stop - start).count() / repetitions;
+
+            std::cout << "[Benchmark] " << targets << " targets, BatchKalmanFilter with " << num_threads << " threads: "
+                      << time << " ms per step, " << 1000.0 / time << " steps per second" << std::endl;
+        }
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,4 +1,8 @@
+#include <chrono>
+#include <cmath>
+#include <complex>
 #include <iostream>
+#include <random>
 #include <thread>
 
 #include <BayesFilters/directional_statistics.h>
@@ -8,6 +12,42 @@ using namespace bfl::directional_statistics;
 using namespace Eigen;
 
 
+/**
+ * Reference implementations using complex exponentials.
+ */
+MatrixXd reference_add(const Ref<const MatrixXd>& a, const Ref<const VectorXd>& b)
+{
+    return (std::complex<double>(0.0, 1.0) * (a.colwise() + b)).array().exp().arg();
+}
+
+
+VectorXd reference_mean(const Ref<const MatrixXd>& a, const Ref<const VectorXd>& w)
+{
+    return ((std::complex<double>(0.0, 1.0) * a).array().exp().matrix() * w).array().arg();
+}
+
+
+/**
+ * Distance between angles, such that pi and -pi are the same angle.
+ */
+double angular_error(const Ref<const MatrixXd>& a, const Ref<const MatrixXd>& b)
+{
+    return (a - b).array().unaryExpr([](const double d) { return std::abs(std::remainder(d, 2.0 * EIGEN_PI)); }).maxCoeff();
+}
+
+
+template<typename Function>
+double time_per_call(Function function, const std::size_t repetitions)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t k = 0; k < repetitions; k++)
+        function();
+    auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+}
+
+
 int main()
 {
     std::cout << "Running directional add...\n" << std::endl;
@@ -110,5 +150,56 @@ int main()
     std::cout << "...done!\n" << std::endl;
 
 
+    std::cout << "Comparing with the complex exponential implementation...\n" << std::endl;
+    {
+        std::mt19937_64 generator(1);
+        std::uniform_real_distribution<double> uniform(-20.0, 20.0);
+
+        const std::size_t rows = 3;
+        const std::size_t cols = 2001;
+
+        MatrixXd angles(rows, cols);
+        for (std::size_t i = 0; i < rows * cols; i++)
+            angles.data()[i] = uniform(generator);
+
+        VectorXd offset(rows);
+        offset << EIGEN_PI, -EIGEN_PI, 0.5;
+
+        VectorXd weights = VectorXd::Constant(cols, 1.0 / cols);
+        weights(0) = -0.3;
+
+        const double add_error = angular_error(directional_add(angles, offset), reference_add(angles, offset));
+        const double sub_error = angular_error(directional_sub(angles, offset), reference_add(angles, -offset));
+        const double mean_error = angular_error(directional_mean(angles, weights), reference_mean(angles, weights));
+
+        /* The result must be in (-pi, pi] and may overwrite the input. */
+        MatrixXd in_place = angles;
+        directional_add(in_place, offset, in_place);
+        const bool in_range = (in_place.array() > -EIGEN_PI).all() && (in_place.array() <= EIGEN_PI).all();
+        const double in_place_error = angular_error(in_place, reference_add(angles, offset));
+
+        std::cout << "Errors: add " << add_error << ", sub " << sub_error << ", mean " << mean_error << ", in place " << in_place_error << "\n" << std::endl;
+
+        if ((add_error > 1e-12) || (sub_error > 1e-12) || (mean_error > 1e-12) || (in_place_error > 1e-12) || !in_range)
+        {
+            std::cerr << "Directional statistics differ from the complex exponential implementation." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const std::size_t repetitions = 2000;
+        MatrixXd output(rows, cols);
+
+        const double reference_add_time = time_per_call([&]() { output = reference_add(angles, offset); }, repetitions);
+        const double add_time = time_per_call([&]() { directional_add(angles, offset, output); }, repetitions);
+        const double reference_mean_time = time_per_call([&]() { offset = reference_mean(angles, weights); }, repetitions);
+        const double mean_time = time_per_call([&]() { offset = directional_mean(angles, weights); }, repetitions);
+
+        std::cout << "Benchmark on a " << rows << " x " << cols << " matrix:" << std::endl;
+        std::cout << "  add:  complex exponential " << reference_add_time << " us, wrap " << add_time << " us" << std::endl;
+        std::cout << "  mean: complex exponential " << reference_mean_time << " us, sin/cos sums " << mean_time << " us\n" << std::endl;
+    }
+    std::cout << "...done!\n" << std::endl;
+
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,280 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <BayesFilters/BootstrapCorrection.h>
+#include <BayesFilters/DrawParticles.h>
+#include <BayesFilters/EstimatePublisher.h>
+#include <BayesFilters/GaussianLikelihood.h>
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/InitSurveillanceAreaGrid.h>
+#include <BayesFilters/ParticleSet.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/SIS.h>
+#include <BayesFilters/SimulatedLinearSensor.h>
+#include <BayesFilters/SimulatedStateModel.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+class SISSimulation : public SIS
+{
+public:
+    SISSimulation
+    (
+        unsigned int num_particle,
+        std::size_t state_size,
+        unsigned int simulation_steps,
+        std::unique_ptr<ParticleSetInitialization> initialization,
+        std::unique_ptr<PFPrediction> prediction,
+        std::unique_ptr<PFCorrection> correction,
+        std::unique_ptr<Resampling> resampling
+    ) noexcept :
+        SIS(num_particle, state_size, 0, std::move(initialization), std::move(prediction), std::move(correction), std::move(resampling), false),
+        simulation_steps_(simulation_steps)
+    { }
+
+protected:
+    bool runCondition() override
+    {
+        return getFilteringStep() < simulation_steps_;
+    }
+
+private:
+    unsigned int simulation_steps_;
+};
+
+
+/**
+ * Fill all the published data with the same value, so that a torn read is detected.
+ */
+void fill(ParticleSet& particles, VectorXd& estimate, const double value)
+{
+    particles.state().setConstant(value);
+    particles.weight().setConstant(value);
+    estimate.setConstant(value);
+}
+
+
+bool is_consistent(const EstimatePublisher::Snapshot& snapshot)
+{
+    const double value = static_cast<double>(snapshot.step);
+
+    return (snapshot.estimate.array() == value).all() &&
+           (snapshot.state.array() == value).all() &&
+           (snapshot.weight.array() == value).all();
+}
+
+
+int main()
+{
+    std::cout << "Running EstimatePublisher tests." << std::endl;
+
+    /* Publication of an estimate and a Gaussian mixture. */
+    {
+        GaussianMixture belief(2, 3);
+        belief.mean() = MatrixXd::Random(3, 2);
+        belief.covariance() = MatrixXd::Random(3, 6);
+        belief.weight() << 0.3, 0.7;
+
+        EstimatePublisher publisher(3, belief);
+
+        EstimatePublisher::Snapshot snapshot;
+        if (publisher.read(snapshot) || (publisher.getPublications() != 0))
+        {
+            std::cerr << "[Gaussian mixture] Read before any publication." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const VectorXd estimate = belief.mean() * belief.weight();
+        publisher.publish(7, estimate, belief);
+
+        const std::pair<bool, EstimatePublisher::Snapshot> latest = publisher.read();
+
+        if (!latest.first || (latest.second.step != 7) || (latest.second.estimate != estimate) || (latest.second.mean != belief.mean()) ||
+            (latest.second.covariance != belief.covariance()) || (latest.second.weight != belief.weight()) || (latest.second.state.size() != 0))
+        {
+            std::cerr << "[Gaussian mixture] Wrong snapshot." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        bool thrown = false;
+        try
+        {
+            publisher.publish(8, VectorXd::Zero(4), belief);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+
+        if (!thrown || (publisher.read().second.step != 7))
+        {
+            std::cerr << "[Gaussian mixture] A publication with wrong sizes has been accepted." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Gaussian mixture] Passed." << std::endl;
+    }
+
+    /* Readers never see a partially written publication. */
+    {
+        const std::size_t publications = 20000;
+
+        ParticleSet particles(500, 4, 0, false);
+        VectorXd estimate(4);
+        EstimatePublisher publisher(4, particles);
+
+        std::atomic<bool> done(false);
+        std::atomic<std::size_t> reads(0);
+        std::atomic<bool> failed(false);
+
+        std::vector<std::thread> readers;
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            readers.emplace_back([&]()
+            {
+                EstimatePublisher::Snapshot snapshot;
+                std::size_t previous_step = 0;
+
+                while (!done)
+                {
+                    if (!publisher.read(snapshot))
+                        continue;
+
+                    if (!is_consistent(snapshot) || (snapshot.step < previous_step))
+                        failed = true;
+
+                    previous_step = snapshot.step;
+                    ++reads;
+                }
+            });
+        }
+
+        for (std::size_t k = 1; k <= publications; k++)
+        {
+            fill(particles, estimate, static_cast<double>(k));
+            publisher.publish(k, estimate, particles);
+        }
+
+        done = true;
+        for (auto& reader : readers)
+            reader.join();
+
+        EstimatePublisher::Snapshot snapshot;
+        if (failed || !publisher.read(snapshot) || (snapshot.step != publications) || !is_consistent(snapshot) || (publisher.getPublications() != publications))
+        {
+            std::cerr << "[Concurrent readers] Inconsistent snapshot." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Concurrent readers] Passed, " << reads << " consistent reads during " << publications << " publications." << std::endl;
+    }
+
+    /* Publication from a running particle filter. */
+    {
+        const unsigned int num_particle = 900;
+        const unsigned int simulation_steps = 50;
+        const double T = 1.0;
+        const double tilde_q = 10.0;
+
+        std::unique_ptr<PFPrediction> prediction = utils::make_unique<DrawParticles>();
+        prediction->setStateModel(utils::make_unique<WhiteNoiseAcceleration>(T, tilde_q));
+
+        std::unique_ptr<SimulatedStateModel> simulated_state_model = utils::make_unique<SimulatedStateModel>(utils::make_unique<WhiteNoiseAcceleration>(T, tilde_q), Vector4d(10.0, 0.0, 10.0, 0.0), simulation_steps);
+
+        std::unique_ptr<PFCorrection> correction = utils::make_unique<BoostrapCorrection>();
+        correction->setLikelihoodModel(utils::make_unique<GaussianLikelihood>());
+        correction->setMeasurementModel(utils::make_unique<SimulatedLinearSensor>(std::move(simulated_state_model)));
+
+        SISSimulation sis_pf(num_particle, 4, simulation_steps,
+                             utils::make_unique<InitSurveillanceAreaGrid>(1000.0, 1000.0, 30, 30),
+                             std::move(prediction), std::move(correction), utils::make_unique<Resampling>());
+
+        sis_pf.enablePublication(true);
+        const EstimatePublisher& publisher = sis_pf.getPublisher();
+
+        sis_pf.boot();
+        sis_pf.run();
+
+        /* Poll the filter while it runs. */
+        EstimatePublisher::Snapshot snapshot;
+        std::size_t polls = 0;
+        while (sis_pf.isRunning() || (publisher.getPublications() == 0))
+        {
+            if (publisher.read(snapshot))
+                ++polls;
+        }
+
+        if (!sis_pf.wait())
+            return EXIT_FAILURE;
+
+        if (!publisher.read(snapshot) || (snapshot.step != simulation_steps - 1) || (publisher.getPublications() != simulation_steps))
+        {
+            std::cerr << "[SIS] Wrong number of publications." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const VectorXd expected = snapshot.state * snapshot.weight.array().exp().matrix();
+        const double error = (snapshot.estimate - expected).norm() / expected.norm();
+
+        if ((snapshot.state.cols() != num_particle) || (error > 1e-12))
+        {
+            std::cerr << "[SIS] The estimate is not the weighted mean of the particles, relative error " << error << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[SIS] Passed, " << polls << " snapshots read while running." << std::endl;
+    }
+
+    /* Compare with a copy under a mutex. */
+    {
+        const std::size_t repetitions = 2000;
+
+        ParticleSet particles(10000, 4, 0, false);
+        VectorXd estimate = VectorXd::Zero(4);
+        EstimatePublisher publisher(4, particles);
+        EstimatePublisher::Snapshot snapshot;
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            publisher.publish(k, estimate, particles);
+        auto stop = std::chrono::steady_clock::now();
+        const double publish_time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            publisher.read(snapshot);
+        stop = std::chrono::steady_clock::now();
+        const double read_time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        std::mutex mutex;
+        ParticleSet copy(10000, 4, 0, false);
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            copy.state() = particles.state();
+            copy.weight() = particles.weight();
+        }
+        stop = std::chrono::steady_clock::now();
+        const double mutex_time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        std::cout << "[Benchmark] 10000 particles: publish " << publish_time << " us, read " << read_time << " us, copy under mutex " << mutex_time << " us." << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
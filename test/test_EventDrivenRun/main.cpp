@@ -0,0 +1,234 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <BayesFilters/FilteringAlgorithm.h>
+#include <BayesFilters/FilteringExecutor.h>
+
+using namespace bfl;
+
+
+/**
+ * A filter running until torn down, counting its filtering steps and recording the time of the last one.
+ */
+class CountingFilter : public FilteringAlgorithm
+{
+public:
+    bool skip(const std::string& /* what_step */, const bool /* status */) override
+    {
+        return false;
+    }
+
+    std::atomic<unsigned int> performed_steps{0};
+
+    std::atomic<long long> last_step_time{0};
+
+protected:
+    bool initialization() override
+    {
+        return true;
+    }
+
+    void filteringStep() override
+    {
+        last_step_time = std::chrono::steady_clock::now().time_since_epoch().count();
+        ++performed_steps;
+    }
+
+    bool runCondition() override
+    {
+        return true;
+    }
+};
+
+
+void sleep_ms(const unsigned int milliseconds)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+
+/**
+ * Notify measurements one at a time, waiting for the corresponding step, and return the maximum wake-up latency in microseconds.
+ * Return a negative latency if a step is missing.
+ */
+double notify_measurements(CountingFilter& filter, const unsigned int measurements)
+{
+    double max_latency = 0.0;
+
+    for (unsigned int k = 0; k < measurements; k++)
+    {
+        const unsigned int steps = filter.performed_steps;
+        const long long notification_time = std::chrono::steady_clock::now().time_since_epoch().count();
+
+        filter.notifyMeasurement();
+
+        auto start = std::chrono::steady_clock::now();
+        while (filter.performed_steps == steps)
+        {
+            if (std::chrono::steady_clock::now() - start > std::chrono::seconds(5))
+                return -1.0;
+
+            std::this_thread::yield();
+        }
+
+        const std::chrono::steady_clock::duration latency(filter.last_step_time - notification_time);
+        max_latency = std::max(max_latency, std::chrono::duration<double, std::micro>(latency).count());
+
+        sleep_ms(2);
+    }
+
+    return max_latency;
+}
+
+
+bool check_event_driven(CountingFilter& filter, const std::string& name)
+{
+    /* No step runs until a measurement is notified. The CPU time while idle is only reported. */
+    const std::clock_t idle_start = std::clock();
+    sleep_ms(100);
+    const double idle_cpu_time = 1000.0 * (std::clock() - idle_start) / CLOCKS_PER_SEC;
+
+    if (filter.performed_steps != 0)
+    {
+        std::cerr << "[" << name << "] " << filter.performed_steps << " steps run without measurements." << std::endl;
+        return false;
+    }
+
+    const double max_latency = notify_measurements(filter, 10);
+    if ((max_latency < 0.0) || (filter.performed_steps != 10))
+    {
+        std::cerr << "[" << name << "] " << filter.performed_steps << " steps run instead of 10." << std::endl;
+        return false;
+    }
+
+    filter.teardown();
+    filter.wait();
+
+    std::cout << "[" << name << "] Passed, CPU time while idle " << idle_cpu_time << " ms, maximum wake-up latency " << max_latency << " us." << std::endl;
+
+    return true;
+}
+
+
+int main()
+{
+    std::cout << "Running event-driven run mode tests." << std::endl;
+
+    /* One step per notified measurement. */
+    {
+        CountingFilter filter;
+        filter.enableEventDrivenRun();
+        filter.boot();
+        filter.run();
+
+        if (!check_event_driven(filter, "Thread"))
+            return EXIT_FAILURE;
+    }
+
+    /* The same with a filter booted on an executor. */
+    {
+        FilteringExecutor executor(2);
+
+        CountingFilter filter;
+        filter.enableEventDrivenRun();
+        filter.boot(executor);
+        filter.run();
+
+        if (!check_event_driven(filter, "Executor"))
+            return EXIT_FAILURE;
+    }
+
+    /* Without measurements, a step runs at every timeout. Only a lower bound on the steps is checked. */
+    {
+        CountingFilter filter;
+        filter.enableEventDrivenRun(std::chrono::milliseconds(10));
+        filter.boot();
+        filter.run();
+
+        auto start = std::chrono::steady_clock::now();
+        while ((filter.performed_steps < 5) && (std::chrono::steady_clock::now() - start < std::chrono::seconds(5)))
+            sleep_ms(1);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        const unsigned int steps = filter.performed_steps;
+
+        filter.teardown();
+        filter.wait();
+
+        if (steps < 5)
+        {
+            std::cerr << "[Timeout] " << steps << " steps run in " << elapsed.count() << " ms with a timeout of 10 ms and no measurements." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Timeout] Passed, " << steps << " steps run in " << elapsed.count() << " ms with a timeout of 10 ms." << std::endl;
+    }
+
+    /* The timeout is rejected by filters booted on an executor. */
+    {
+        FilteringExecutor executor(1);
+
+        CountingFilter filter;
+        filter.enableEventDrivenRun(std::chrono::milliseconds(10));
+        if (filter.boot(executor))
+        {
+            std::cerr << "[Executor timeout] A filter with the event timeout booted on an executor." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        CountingFilter booted_filter;
+        booted_filter.enableEventDrivenRun();
+        booted_filter.boot(executor);
+
+        bool thrown = false;
+        try
+        {
+            booted_filter.enableEventDrivenRun(std::chrono::milliseconds(10));
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+
+        booted_filter.teardown();
+        booted_filter.wait();
+
+        if (!thrown)
+        {
+            std::cerr << "[Executor timeout] The event timeout was enabled on a filter booted on an executor." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Executor timeout] Passed." << std::endl;
+    }
+
+    /* Disabling the event-driven run mode resumes the steps back to back. */
+    {
+        CountingFilter filter;
+        filter.enableEventDrivenRun();
+        filter.boot();
+        filter.run();
+
+        sleep_ms(10);
+        filter.disableEventDrivenRun();
+        sleep_ms(10);
+
+        filter.teardown();
+        filter.wait();
+
+        if (filter.performed_steps == 0)
+        {
+            std::cerr << "[Disable] No step run after disabling the event-driven run mode." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Disable] Passed." << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
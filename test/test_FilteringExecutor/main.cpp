@@ -0,0 +1,241 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <BayesFilters/FilteringAlgorithm.h>
+#include <BayesFilters/FilteringExecutor.h>
+
+using namespace bfl;
+
+
+/**
+ * A filter counting its filtering steps and initializations.
+ * If steps is 0, it runs until torn down. If reset_step is not 0, it resets itself once at that step.
+ */
+class CountingFilter : public FilteringAlgorithm
+{
+public:
+    CountingFilter(const unsigned int steps, const unsigned int reset_step) :
+        steps_(steps),
+        reset_step_(reset_step)
+    { }
+
+    bool skip(const std::string& /* what_step */, const bool /* status */) override
+    {
+        return false;
+    }
+
+    std::atomic<unsigned int> performed_steps{0};
+
+    std::atomic<unsigned int> initializations{0};
+
+protected:
+    bool initialization() override
+    {
+        ++initializations;
+
+        return true;
+    }
+
+    void filteringStep() override
+    {
+        ++performed_steps;
+
+        if (performed_steps == reset_step_)
+            reset();
+    }
+
+    bool runCondition() override
+    {
+        return (steps_ == 0) || (getFilteringStep() < steps_);
+    }
+
+private:
+    unsigned int steps_;
+
+    unsigned int reset_step_;
+};
+
+
+bool check_filter(CountingFilter& filter, const unsigned int steps, const unsigned int initializations, const std::string& name)
+{
+    if ((filter.performed_steps != steps) || (filter.initializations != initializations) || filter.isRunning())
+    {
+        std::cerr << "[" << name << "] Wrong recursion: " << filter.performed_steps << " steps instead of " << steps
+                  << ", " << filter.initializations << " initializations instead of " << initializations
+                  << ", running " << filter.isRunning() << "." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Run the filters to completion, with one thread per filter or with the executor if provided.
+ */
+double run_filters(std::vector<std::unique_ptr<CountingFilter>>& filters, FilteringExecutor* executor)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto& filter : filters)
+    {
+        if (executor)
+            filter->boot(*executor);
+        else
+            filter->boot();
+    }
+
+    for (auto& filter : filters)
+        filter->run();
+
+    for (auto& filter : filters)
+        filter->wait();
+
+    auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+int main()
+{
+    std::cout << "Running FilteringExecutor tests." << std::endl;
+
+    FilteringExecutor executor(4);
+
+    /* Many filters sharing the executor. */
+    {
+        std::vector<std::unique_ptr<CountingFilter>> filters;
+        for (std::size_t i = 0; i < 500; i++)
+            filters.emplace_back(new CountingFilter(100, 0));
+
+        run_filters(filters, &executor);
+
+        for (auto& filter : filters)
+        {
+            if (!check_filter(*filter, 100, 1, "Many filters"))
+                return EXIT_FAILURE;
+        }
+
+        std::cout << "[Many filters] Passed." << std::endl;
+    }
+
+    /* A reset restarts the recursion, with a new initialization. */
+    {
+        CountingFilter filter(100, 5);
+
+        filter.boot(executor);
+        filter.run();
+        filter.wait();
+
+        if (!check_filter(filter, 105, 2, "Reset"))
+            return EXIT_FAILURE;
+
+        std::cout << "[Reset] Passed." << std::endl;
+    }
+
+    /* A filter torn down before run() terminates. */
+    {
+        CountingFilter filter(100, 0);
+
+        filter.boot(executor);
+        filter.teardown();
+        filter.wait();
+
+        if (!check_filter(filter, 0, 1, "Teardown before run"))
+            return EXIT_FAILURE;
+
+        std::cout << "[Teardown before run] Passed." << std::endl;
+    }
+
+    /* The same with a filter booted on its own thread. */
+    {
+        CountingFilter filter(100, 0);
+
+        filter.boot();
+        filter.teardown();
+        filter.wait();
+
+        if (!check_filter(filter, 0, 1, "Thread teardown before run"))
+            return EXIT_FAILURE;
+
+        std::cout << "[Thread teardown before run] Passed." << std::endl;
+    }
+
+        /* A running filter torn down terminates. */
+    {
+        CountingFilter filter(0, 0);
+
+        filter.boot(executor);
+        filter.run();
+
+        while (filter.performed_steps < 1000)
+            std::this_thread::yield();
+
+        filter.teardown();
+        filter.wait();
+
+        if (filter.isRunning())
+        {
+            std::cerr << "[Teardown while running] The filter is still running." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Teardown while running] Passed after " << filter.performed_steps << " steps." << std::endl;
+    }
+
+    /* Pinned workers. */
+    {
+        FilteringExecutor pinned_executor(2, true);
+
+        std::vector<std::unique_ptr<CountingFilter>> filters;
+        for (std::size_t i = 0; i < 10; i++)
+            filters.emplace_back(new CountingFilter(100, 0));
+
+        run_filters(filters, &pinned_executor);
+
+        for (auto& filter : filters)
+        {
+            if (!check_filter(*filter, 100, 1, "Pinned workers"))
+                return EXIT_FAILURE;
+        }
+
+        std::cout << "[Pinned workers] Passed, pinned " << pinned_executor.isPinned() << "." << std::endl;
+    }
+
+    /* Compare one thread per filter with the executor. Only the recursion is checked, the timings are reported. */
+    {
+        const std::size_t num_filters = 1000;
+        const unsigned int steps = 100;
+
+        std::vector<std::unique_ptr<CountingFilter>> threaded_filters;
+        std::vector<std::unique_ptr<CountingFilter>> executed_filters;
+        for (std::size_t i = 0; i < num_filters; i++)
+        {
+            threaded_filters.emplace_back(new CountingFilter(steps, 0));
+            executed_filters.emplace_back(new CountingFilter(steps, 0));
+        }
+
+        const double threaded_time = run_filters(threaded_filters, nullptr);
+        const double executed_time = run_filters(executed_filters, &executor);
+
+        for (std::size_t i = 0; i < num_filters; i++)
+        {
+            if (!check_filter(*threaded_filters[i], steps, 1, "Benchmark") || !check_filter(*executed_filters[i], steps, 1, "Benchmark"))
+                return EXIT_FAILURE;
+        }
+
+        std::cout << "[Benchmark] " << num_filters << " filters, " << steps << " steps: " << std::fixed << std::setprecision(1)
+                  << "one thread per filter " << threaded_time << " ms, executor with " << executor.getNumberOfWorkers() << " workers " << executed_time << " ms" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    return EXIT_SUCCESS;
+}
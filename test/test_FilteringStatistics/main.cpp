@@ -0,0 +1,259 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <BayesFilters/BootstrapCorrection.h>
+#include <BayesFilters/DrawParticles.h>
+#include <BayesFilters/FilteringStatistics.h>
+#include <BayesFilters/GaussianLikelihood.h>
+#include <BayesFilters/InitSurveillanceAreaGrid.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/SIS.h>
+#include <BayesFilters/SimulatedLinearSensor.h>
+#include <BayesFilters/SimulatedStateModel.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+class SISSimulation : public SIS
+{
+public:
+    SISSimulation
+    (
+        unsigned int num_particle,
+        std::size_t state_size,
+        unsigned int simulation_steps,
+        std::unique_ptr<ParticleSetInitialization> initialization,
+        std::unique_ptr<PFPrediction> prediction,
+        std::unique_ptr<PFCorrection> correction,
+        std::unique_ptr<Resampling> resampling
+    ) noexcept :
+        SIS(num_particle, state_size, 0, std::move(initialization), std::move(prediction), std::move(correction), std::move(resampling), false),
+        simulation_steps_(simulation_steps)
+    { }
+
+protected:
+    bool runCondition() override
+    {
+        return getFilteringStep() < simulation_steps_;
+    }
+
+private:
+    unsigned int simulation_steps_;
+};
+
+
+bool check_summary(const FilteringStatistics::Summary& summary, const std::size_t samples, const double p50, const double p99, const double max, const std::string& name)
+{
+    if ((summary.samples != samples) || (std::abs(summary.p50 - p50) > 1e-6) || (std::abs(summary.p99 - p99) > 1e-6) || (std::abs(summary.max - max) > 1e-6))
+    {
+        std::cerr << "[" << name << "] Wrong summary: " << summary.samples << " samples, p50 " << summary.p50 << ", p99 " << summary.p99 << ", max " << summary.max
+                  << " instead of " << samples << " samples, p50 " << p50 << ", p99 " << p99 << ", max " << max << "." << std::endl;
+        return false;
+    }
+
+    std::cout << "[" << name << "] Passed." << std::endl;
+
+    return true;
+}
+
+
+int main()
+{
+    std::cout << "Running FilteringStatistics tests." << std::endl;
+
+    /* Percentiles of the durations 1, ..., 200 us, recorded in shuffled order. */
+    {
+        FilteringStatistics statistics(200);
+
+        for (std::size_t i = 0; i < 200; i++)
+            statistics.recordDuration(FilteringStatistics::Phase::Correction, std::chrono::microseconds((i * 77) % 200 + 1));
+
+        const FilteringStatistics::Report report = statistics.getReport();
+
+        if (!check_summary(report.phase(FilteringStatistics::Phase::Correction), 200, 100.0, 198.0, 200.0, "Percentiles"))
+            return EXIT_FAILURE;
+
+        if (!check_summary(report.phase(FilteringStatistics::Phase::Prediction), 0, 0.0, 0.0, 0.0, "Empty window"))
+            return EXIT_FAILURE;
+    }
+
+    /* Only the latest samples are kept, the steps and resamplings are counted since the last reset. */
+    {
+        FilteringStatistics statistics(10);
+
+        for (std::size_t i = 0; i < 100; i++)
+        {
+            statistics.recordDuration(FilteringStatistics::Phase::Step, std::chrono::microseconds(i + 1));
+            statistics.recordEffectiveSampleSize(static_cast<double>(i));
+
+            if (i % 4 == 0)
+                statistics.recordResampling();
+        }
+
+        FilteringStatistics::Report report = statistics.getReport();
+
+        if (!check_summary(report.phase(FilteringStatistics::Phase::Step), 10, 95.0, 100.0, 100.0, "Rolling window"))
+            return EXIT_FAILURE;
+
+        if (!check_summary(report.effective_sample_size, 10, 94.0, 99.0, 99.0, "Effective sample size"))
+            return EXIT_FAILURE;
+
+        if ((report.steps != 100) || (report.resamplings != 25) || (report.resampling_frequency != 0.25))
+        {
+            std::cerr << "[Resampling frequency] Wrong counts: " << report.steps << " steps, " << report.resamplings << " resamplings, frequency " << report.resampling_frequency << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        statistics.reset();
+        report = statistics.getReport();
+
+        if ((report.steps != 0) || (report.resamplings != 0) || (report.phase(FilteringStatistics::Phase::Step).samples != 0) || (report.effective_sample_size.samples != 0))
+        {
+            std::cerr << "[Reset] Statistics not cleared." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Resampling frequency] Passed." << std::endl;
+    }
+
+    /* A reader polling the statistics sees consistent windows while the samples are recorded. */
+    {
+        const std::size_t samples = 200000;
+
+        FilteringStatistics statistics(100);
+
+        std::atomic<bool> done(false);
+        std::atomic<bool> failed(false);
+        std::atomic<std::size_t> reports(0);
+
+        std::thread reader([&]()
+        {
+            double previous_max = 0.0;
+
+            while (!done)
+            {
+                const FilteringStatistics::Summary summary = statistics.getReport().phase(FilteringStatistics::Phase::Step);
+
+                /* The durations are increasing, hence the window holds the latest samples max - samples + 1, ..., max. */
+                if ((summary.samples > 100) || (summary.max < previous_max) ||
+                    ((summary.samples > 0) && (std::abs(summary.p50 - (summary.max - summary.samples + std::ceil(0.5 * summary.samples))) > 1e-6)))
+                    failed = true;
+
+                previous_max = summary.max;
+                ++reports;
+            }
+        });
+
+        /* Keep recording until the reader has polled the statistics a few times, also on a single core. */
+        std::size_t recorded = 0;
+        while ((recorded < samples) || (reports < 100))
+        {
+            statistics.recordDuration(FilteringStatistics::Phase::Step, std::chrono::microseconds(++recorded));
+
+            if (recorded % 1000 == 0)
+                std::this_thread::yield();
+        }
+
+        done = true;
+        reader.join();
+
+        if (failed || (statistics.getReport().steps != recorded))
+        {
+            std::cerr << "[Concurrent reader] Inconsistent report." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Concurrent reader] Passed, " << reports << " reports read while recording." << std::endl;
+    }
+
+    /* Statistics of a particle filter. */
+    {
+        const unsigned int num_particle = 900;
+        const unsigned int simulation_steps = 50;
+        const double T = 1.0;
+        const double tilde_q = 10.0;
+
+        std::unique_ptr<PFPrediction> prediction = utils::make_unique<DrawParticles>();
+        prediction->setStateModel(utils::make_unique<WhiteNoiseAcceleration>(T, tilde_q));
+
+        std::unique_ptr<SimulatedStateModel> simulated_state_model = utils::make_unique<SimulatedStateModel>(utils::make_unique<WhiteNoiseAcceleration>(T, tilde_q), Vector4d(10.0, 0.0, 10.0, 0.0), simulation_steps);
+
+        std::unique_ptr<PFCorrection> correction = utils::make_unique<BoostrapCorrection>();
+        correction->setLikelihoodModel(utils::make_unique<GaussianLikelihood>());
+        correction->setMeasurementModel(utils::make_unique<SimulatedLinearSensor>(std::move(simulated_state_model)));
+
+        SISSimulation sis_pf(num_particle, 4, simulation_steps,
+                             utils::make_unique<InitSurveillanceAreaGrid>(1000.0, 1000.0, 30, 30),
+                             std::move(prediction), std::move(correction), utils::make_unique<Resampling>());
+
+        sis_pf.boot();
+        sis_pf.run();
+        if (!sis_pf.wait())
+            return EXIT_FAILURE;
+
+        const std::pair<bool, FilteringStatistics::Report> statistics = sis_pf.getStatistics();
+
+#if defined(BFL_INSTRUMENTATION)
+        const FilteringStatistics::Report& report = statistics.second;
+
+        const bool valid = statistics.first &&
+                           (report.steps == simulation_steps) &&
+                           (report.phase(FilteringStatistics::Phase::Step).samples == simulation_steps) &&
+                           (report.phase(FilteringStatistics::Phase::Prediction).samples == simulation_steps - 1) &&
+                           (report.phase(FilteringStatistics::Phase::Correction).samples == simulation_steps) &&
+                           (report.phase(FilteringStatistics::Phase::Normalization).samples == simulation_steps) &&
+                           (report.phase(FilteringStatistics::Phase::Logging).samples == simulation_steps) &&
+                           (report.phase(FilteringStatistics::Phase::Resampling).samples == report.resamplings) &&
+                           (report.effective_sample_size.samples == simulation_steps) &&
+                           (report.effective_sample_size.max <= num_particle + 1e-6) &&
+                           (report.resamplings > 0) &&
+                           (report.phase(FilteringStatistics::Phase::Correction).max <= report.phase(FilteringStatistics::Phase::Step).max);
+
+        if (!valid)
+        {
+            std::cerr << "[SIS] Wrong statistics." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const char* names[] = {"prediction", "correction", "normalization", "resampling", "logging", "step"};
+        for (std::size_t i = 0; i < FilteringStatistics::number_of_phases; i++)
+            std::cout << "  " << names[i] << ": p50 " << report.phases[i].p50 << " us, p99 " << report.phases[i].p99 << " us, max " << report.phases[i].max << " us" << std::endl;
+        std::cout << "  effective sample size: p50 " << report.effective_sample_size.p50 << ", resampling frequency " << report.resampling_frequency << std::endl;
+#else
+        if (statistics.first)
+        {
+            std::cerr << "[SIS] Statistics reported without instrumentation." << std::endl;
+            return EXIT_FAILURE;
+        }
+#endif
+
+        std::cout << "[SIS] Passed." << std::endl;
+    }
+
+    /* Cost of timing a phase. */
+    {
+        FilteringStatistics statistics;
+
+        const std::size_t repetitions = 1000000;
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            FilteringStatistics::ScopedTimer timer(statistics, FilteringStatistics::Phase::Logging);
+        auto stop = std::chrono::steady_clock::now();
+
+        std::cout << "[Benchmark] Timing a phase costs " << std::chrono::duration<double, std::nano>(stop - start).count() / repetitions << " ns." << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <BayesFilters/GPFCorrection.h>
+#include <BayesFilters/ParticleSet.h>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * Expose the proposal of GPFCorrection, which does not need
+ * the Gaussian correction and the likelihood and state models.
+ */
+class ProposalSampler : public GPFCorrection
+{
+public:
+    ProposalSampler(const unsigned int seed) noexcept :
+        GPFCorrection(nullptr, nullptr, nullptr, seed)
+    { }
+
+    using GPFCorrection::sampleFromProposal;
+
+    using GPFCorrection::logEvaluateProposal;
+};
+
+
+/**
+ * Sample and evaluate the proposal of each particle separately,
+ * inverting the covariance matrix to evaluate the proposal.
+ */
+VectorXd reference_proposal(ParticleSet& particles, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    const std::size_t state_size = particles.state().rows();
+    VectorXd log_proposal(particles.components);
+
+    for (std::size_t i = 0; i < particles.components; ++i)
+    {
+        MatrixXd covariance = particles.covariance(i);
+
+        LDLT<MatrixXd> chol_ldlt(covariance);
+        MatrixXd sqrt_P = (chol_ldlt.transpositionsP() * MatrixXd::Identity(state_size, state_size)).transpose() *
+                           chol_ldlt.matrixL() *
+                           chol_ldlt.vectorD().real().cwiseSqrt().asDiagonal();
+
+        VectorXd rand_vectors(state_size);
+        for (int j = 0; j < rand_vectors.size(); ++j)
+            rand_vectors(j) = distribution(generator);
+
+        particles.state(i) = particles.mean(i) + sqrt_P * rand_vectors;
+
+        VectorXd difference = particles.state(i) - particles.mean(i);
+        log_proposal(i) = -0.5 * static_cast<double>(state_size) * log(2.0 * M_PI) - 0.5 * log(covariance.determinant()) - 0.5 * (difference.transpose() * covariance.inverse() * difference).coeff(0);
+    }
+
+    return log_proposal;
+}
+
+
+ParticleSet random_particle_set(const std::size_t num_particle, const std::size_t state_size, const unsigned int seed)
+{
+    std::mt19937_64 generator(seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    ParticleSet particles(num_particle, state_size);
+
+    for (std::size_t i = 0; i < num_particle; ++i)
+    {
+        MatrixXd A(state_size, state_size);
+        for (int j = 0; j < A.size(); ++j)
+            *(A.data() + j) = distribution(generator);
+
+        for (std::size_t j = 0; j < state_size; ++j)
+            particles.mean(i, j) = distribution(generator);
+
+        particles.covariance(i) = A * A.transpose() / state_size + 0.1 * MatrixXd::Identity(state_size, state_size);
+    }
+
+    return particles;
+}
+
+
+int main()
+{
+    std::cout << "Comparing the batched proposal against per-particle sampling and evaluation..." << std::endl;
+
+    const unsigned int seed = 3;
+
+    for (std::size_t state_size : {1, 4, 12})
+    {
+        ParticleSet reference_particles = random_particle_set(100, state_size, state_size);
+        std::mt19937_64 generator(seed);
+        VectorXd reference_log_proposal = reference_proposal(reference_particles, generator);
+
+        for (std::size_t num_threads : {1, 3})
+        {
+            ParticleSet particles = random_particle_set(100, state_size, state_size);
+            ProposalSampler sampler(seed);
+            sampler.setNumberOfThreads(num_threads);
+            VectorXd log_proposal = sampler.sampleFromProposal(particles);
+
+            if (((particles.state() - reference_particles.state()).array().abs() > 1e-10).any() ||
+                ((log_proposal - reference_log_proposal).array().abs() > 1e-8).any())
+            {
+                std::cerr << "Wrong proposal samples or densities with state size " << state_size << " and " << num_threads << " threads." << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            for (std::size_t i = 0; i < particles.components; ++i)
+            {
+                if (std::abs(sampler.logEvaluateProposal(particles.state(i), particles.mean(i), particles.covariance(i)) - log_proposal(i)) > 1e-8)
+                {
+                    std::cerr << "GPFCorrection::logEvaluateProposal() differs from the batched proposal with state size " << state_size << "." << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+    }
+
+    std::cout << "The batched proposal produced correct results.\n" << std::endl;
+
+
+    std::cout << "Sampling from rank-deficient covariance matrices..." << std::endl;
+
+    {
+        const std::size_t state_size = 4;
+        ParticleSet particles = random_particle_set(100, state_size, 5);
+
+        std::mt19937_64 generator(seed);
+        std::normal_distribution<double> distribution(0.0, 1.0);
+
+        for (std::size_t i = 0; i < particles.components; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                /* Exactly zero variance along the second coordinate. */
+                particles.covariance(i) = particles.covariance(i).cwiseProduct(MatrixXd::Identity(state_size, state_size));
+                particles.covariance(i).row(1).setZero();
+                particles.covariance(i).col(1).setZero();
+            }
+            else
+            {
+                /* Rank state_size - 2 covariance matrix, with zero pivots up to round-off. */
+                MatrixXd B(state_size, state_size - 2);
+                for (int j = 0; j < B.size(); ++j)
+                    *(B.data() + j) = distribution(generator);
+
+                particles.covariance(i) = B * B.transpose();
+            }
+        }
+
+        ProposalSampler sampler(seed);
+        VectorXd log_proposal = sampler.sampleFromProposal(particles);
+
+        if (!particles.state().allFinite() || !log_proposal.allFinite())
+        {
+            std::cerr << "Non-finite proposal samples or densities with rank-deficient covariance matrices." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        for (std::size_t i = 0; i < particles.components; ++i)
+        {
+            if ((i % 2 == 0) && (particles.state(i, 1) != particles.mean(i, 1)))
+            {
+                std::cerr << "The proposal sampled along a direction having zero variance." << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            if (!std::isfinite(sampler.logEvaluateProposal(particles.state(i), particles.mean(i), particles.covariance(i))))
+            {
+                std::cerr << "GPFCorrection::logEvaluateProposal() is not finite with a rank-deficient covariance matrix." << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    std::cout << "The proposal is finite with rank-deficient covariance matrices.\n" << std::endl;
+
+
+    std::cout << "Scaling benchmark (time per proposal in milliseconds):" << std::endl;
+    std::cout << std::setw(12) << "particles" << std::setw(12) << "state size" << std::setw(16) << "per-particle" << std::setw(16) << "batched" << std::endl;
+
+    for (std::size_t num_particle : {1000, 10000, 50000})
+    {
+        for (std::size_t state_size : {4, 12})
+        {
+            ParticleSet particles = random_particle_set(num_particle, state_size, 1);
+
+            std::mt19937_64 generator(seed);
+            auto start = std::chrono::steady_clock::now();
+            reference_proposal(particles, generator);
+            std::chrono::duration<double, std::milli> reference_time = std::chrono::steady_clock::now() - start;
+
+            ProposalSampler sampler(seed);
+            start = std::chrono::steady_clock::now();
+            sampler.sampleFromProposal(particles);
+            std::chrono::duration<double, std::milli> batched_time = std::chrono::steady_clock::now() - start;
+
+            std::cout << std::setw(12) << num_particle << std::setw(12) << state_size
+                      << std::setw(16) << std::fixed << std::setprecision(3) << reference_time.count()
+                      << std::setw(16) << batched_time.count() << std::endl;
+        }
+    }
+
+    std::cout << "done!" << std::endl;
+
+    return EXIT_SUCCESS;
+}
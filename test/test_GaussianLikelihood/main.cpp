@@ -0,0 +1,242 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <type_traits>
+
+#include <BayesFilters/GaussianLikelihood.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+static_assert(std::is_copy_constructible<GaussianLikelihood>::value && std::is_move_constructible<GaussianLikelihood>::value,
+              "GaussianLikelihood must be copyable and movable.");
+
+
+/**
+ * A linear measurement model of size meas_size, measuring the first meas_size
+ * components of the state, with a fixed measurement and a dense noise covariance matrix.
+ */
+class FixedLinearSensor : public LTIMeasurementModel
+{
+public:
+    FixedLinearSensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const Ref<const VectorXd>& measurement) :
+        LTIMeasurementModel(measurement_matrix, noise_covariance_matrix),
+        measurement_(measurement)
+    { }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+private:
+    MatrixXd measurement_;
+};
+
+
+/**
+ * Likelihood model providing only the likelihood, so that its logarithm
+ * is evaluated by the default implementation of LikelihoodModel::logLikelihood().
+ */
+class LinearDomainLikelihood : public LikelihoodModel
+{
+public:
+    std::pair<bool, VectorXd> likelihood(const MeasurementModel& measurement_model, const Ref<const MatrixXd>& pred_states) override
+    {
+        LikelihoodModel& likelihood_model = gaussian_likelihood_;
+
+        return likelihood_model.likelihood(measurement_model, pred_states);
+    }
+
+private:
+    GaussianLikelihood gaussian_likelihood_;
+};
+
+
+/**
+ * Likelihood evaluated inverting the noise covariance matrix for each particle.
+ */
+VectorXd reference_likelihood(const MeasurementModel& model, const Ref<const MatrixXd>& states)
+{
+    MatrixXd measurement = any::any_cast<MatrixXd>(model.measure().second);
+    MatrixXd predicted = any::any_cast<MatrixXd>(model.predictedMeasure(states).second);
+    MatrixXd innovations = any::any_cast<MatrixXd>(model.innovation(predicted, measurement).second);
+    MatrixXd R = model.getNoiseCovarianceMatrix().second;
+
+    VectorXd likelihood(innovations.cols());
+    for (int i = 0; i < innovations.cols(); ++i)
+        likelihood(i) = (-0.5 * static_cast<double>(innovations.rows()) * log(2.0 * M_PI) - 0.5 * log(R.determinant()) - 0.5 * (innovations.col(i).transpose() * R.inverse() * innovations.col(i)).array()).exp().coeff(0);
+
+    return likelihood;
+}
+
+
+std::unique_ptr<FixedLinearSensor> make_sensor(const std::size_t meas_size, const std::size_t state_size, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    MatrixXd H = MatrixXd::Identity(meas_size, state_size);
+
+    /* Dense, well conditioned, noise covariance matrix. */
+    MatrixXd A(meas_size, meas_size);
+    for (int i = 0; i < A.size(); ++i)
+        *(A.data() + i) = distribution(generator);
+    MatrixXd R = A * A.transpose() / meas_size + MatrixXd::Identity(meas_size, meas_size);
+
+    VectorXd measurement(meas_size);
+    for (int i = 0; i < measurement.size(); ++i)
+        measurement(i) = distribution(generator);
+
+    return utils::make_unique<FixedLinearSensor>(H, R, measurement);
+}
+
+
+MatrixXd random_states(const std::size_t state_size, const std::size_t num_particle, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    MatrixXd states(state_size, num_particle);
+    for (int i = 0; i < states.size(); ++i)
+        *(states.data() + i) = distribution(generator);
+
+    return states;
+}
+
+
+int main()
+{
+    std::mt19937_64 generator(1);
+
+    std::cout << "Comparing GaussianLikelihood against a per-particle inversion of the noise covariance matrix..." << std::endl;
+
+    for (std::size_t meas_size : {1, 2, 5, 16})
+    {
+        std::unique_ptr<FixedLinearSensor> sensor = make_sensor(meas_size, meas_size + 2, generator);
+        MatrixXd states = random_states(meas_size + 2, 100, generator);
+
+        GaussianLikelihood gaussian_likelihood;
+        LikelihoodModel& likelihood_model = gaussian_likelihood;
+
+        /* Evaluate twice to exercise the cached factorization. */
+        for (unsigned int k = 0; k < 2; ++k)
+        {
+            bool valid;
+            VectorXd likelihood;
+            std::tie(valid, likelihood) = likelihood_model.likelihood(*sensor, states);
+
+            VectorXd reference = reference_likelihood(*sensor, states);
+
+            if (!valid || ((likelihood - reference).array().abs() > 1e-10 * reference.array().abs().max(1e-300)).any())
+            {
+                std::cerr << "Wrong likelihood with measurement size " << meas_size << "." << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    std::cout << "GaussianLikelihood produced correct results.\n" << std::endl;
+
+
+    std::cout << "Comparing the native and the default log-likelihood..." << std::endl;
+
+    for (std::size_t meas_size : {1, 5, 16})
+    {
+        std::unique_ptr<FixedLinearSensor> sensor = make_sensor(meas_size, meas_size, generator);
+        MatrixXd states = random_states(meas_size, 100, generator);
+
+        GaussianLikelihood gaussian_likelihood;
+        LikelihoodModel& likelihood_model = gaussian_likelihood;
+
+        LinearDomainLikelihood linear_domain_likelihood;
+
+        bool valid;
+        VectorXd log_likelihood;
+        std::tie(valid, log_likelihood) = likelihood_model.logLikelihood(*sensor, states);
+
+        bool valid_default;
+        VectorXd default_log_likelihood;
+        std::tie(valid_default, default_log_likelihood) = linear_domain_likelihood.logLikelihood(*sensor, states);
+
+        if (!valid || !valid_default || ((log_likelihood - default_log_likelihood).array().abs() > 1e-10 * log_likelihood.array().abs()).any())
+        {
+            std::cerr << "Wrong log-likelihood with measurement size " << meas_size << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* With a large measurement the likelihood underflows, while its logarithm must stay finite. */
+    {
+        std::unique_ptr<FixedLinearSensor> sensor = make_sensor(1000, 1000, generator);
+        MatrixXd states = random_states(1000, 10, generator);
+
+        GaussianLikelihood gaussian_likelihood;
+        LikelihoodModel& likelihood_model = gaussian_likelihood;
+
+        bool valid;
+        VectorXd log_likelihood;
+        std::tie(valid, log_likelihood) = likelihood_model.logLikelihood(*sensor, states);
+
+        if (!valid || !log_likelihood.allFinite() || (log_likelihood.array() > std::log(std::numeric_limits<double>::min())).any())
+        {
+            std::cerr << "The log-likelihood of a large measurement is not finite or does not underflow in the linear domain." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << "The log-likelihood produced correct results.\n" << std::endl;
+
+
+    std::cout << "Scaling benchmark (time per likelihood evaluation in milliseconds):" << std::endl;
+    std::cout << std::setw(12) << "particles" << std::setw(12) << "meas size" << std::setw(16) << "per-particle" << std::setw(16) << "batched" << std::endl;
+
+    const unsigned int repetitions = 3;
+
+    for (std::size_t num_particle : {100, 1000, 10000})
+    {
+        for (std::size_t meas_size : {2, 8, 32})
+        {
+            std::unique_ptr<FixedLinearSensor> sensor = make_sensor(meas_size, meas_size, generator);
+            MatrixXd states = random_states(meas_size, num_particle, generator);
+
+            GaussianLikelihood gaussian_likelihood;
+            LikelihoodModel& likelihood_model = gaussian_likelihood;
+
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned int r = 0; r < repetitions; ++r)
+                reference_likelihood(*sensor, states);
+            std::chrono::duration<double, std::milli> reference_time = std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            for (unsigned int r = 0; r < repetitions; ++r)
+                likelihood_model.likelihood(*sensor, states);
+            std::chrono::duration<double, std::milli> batched_time = std::chrono::steady_clock::now() - start;
+
+            std::cout << std::setw(12) << num_particle << std::setw(12) << meas_size
+                      << std::setw(16) << std::fixed << std::setprecision(3) << reference_time.count() / repetitions
+                      << std::setw(16) << batched_time.count() / repetitions << std::endl;
+        }
+    }
+
+    std::cout << "done!" << std::endl;
+
+    return EXIT_SUCCESS;
+}
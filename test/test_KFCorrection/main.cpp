@@ -0,0 +1,266 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/KFCorrection.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * A linear sensor with a fixed measurement, counting how many times its matrices are fetched.
+ * The noise covariance matrix can be changed, increasing the revision of the model if the revision tracking is enabled.
+ */
+class CountingLinearSensor : public LTIMeasurementModel
+{
+public:
+    CountingLinearSensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const Ref<const VectorXd>& measurement, const bool cacheable) :
+        LTIMeasurementModel(measurement_matrix, noise_covariance_matrix),
+        measurement_(measurement)
+    {
+        if (cacheable)
+            enableRevisionTracking();
+    }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+    std::pair<bool, MatrixXd> getNoiseCovarianceMatrix() const override
+    {
+        ++fetches;
+
+        return LTIMeasurementModel::getNoiseCovarianceMatrix();
+    }
+
+    void setNoiseCovarianceMatrix(const Ref<const MatrixXd>& noise_covariance_matrix)
+    {
+        R_ = noise_covariance_matrix;
+        ++revision_;
+    }
+
+    mutable std::size_t fetches = 0;
+
+private:
+    MatrixXd measurement_;
+};
+
+
+/**
+ * KFCorrection exposing the protected KFCorrection::correctStep().
+ */
+class TestKFCorrection : public KFCorrection
+{
+public:
+    TestKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model) :
+        KFCorrection(std::move(measurement_model))
+    { }
+
+    void correctStep(const GaussianMixture& pred_state, GaussianMixture& corr_state) override
+    {
+        KFCorrection::correctStep(pred_state, corr_state);
+    }
+};
+
+
+MatrixXd random_matrix(const std::size_t rows, const std::size_t cols, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    MatrixXd matrix(rows, cols);
+    for (std::size_t i = 0; i < rows * cols; i++)
+        matrix.data()[i] = normal(generator);
+
+    return matrix;
+}
+
+
+MatrixXd random_covariance(const std::size_t size, std::mt19937_64& generator)
+{
+    MatrixXd A = random_matrix(size, size, generator);
+
+    return A * A.transpose() / size + 0.1 * MatrixXd::Identity(size, size);
+}
+
+
+GaussianMixture random_state(const std::size_t components, const std::size_t size, std::mt19937_64& generator)
+{
+    GaussianMixture state(components, size);
+    for (std::size_t i = 0; i < components; i++)
+    {
+        state.mean(i) = random_matrix(size, 1, generator);
+        state.covariance(i) = random_covariance(size, generator);
+    }
+
+    return state;
+}
+
+
+/**
+ * Kalman correction using the explicit inverse of the covariance matrix of the predicted measurement.
+ */
+void reference_correction(const GaussianMixture& pred_state, const Ref<const MatrixXd>& H, const Ref<const MatrixXd>& R, const Ref<const VectorXd>& measurement, GaussianMixture& corr_state)
+{
+    for (std::size_t i = 0; i < pred_state.components; i++)
+    {
+        MatrixXd Py = H * pred_state.covariance(i) * H.transpose() + R;
+        MatrixXd K = pred_state.covariance(i) * H.transpose() * Py.inverse();
+
+        corr_state.mean(i) = pred_state.mean(i) + K * (measurement - H * pred_state.mean(i));
+        corr_state.covariance(i) = pred_state.covariance(i) - K * Py * K.transpose();
+    }
+}
+
+
+double relative_error(const Ref<const MatrixXd>& value, const Ref<const MatrixXd>& reference)
+{
+    return (value - reference).norm() / std::max(reference.norm(), 1.0);
+}
+
+
+bool check_correction(TestKFCorrection& correction, const GaussianMixture& pred_state, const Ref<const MatrixXd>& H, const Ref<const MatrixXd>& R, const Ref<const VectorXd>& measurement, const std::string& name)
+{
+    GaussianMixture corr_state(pred_state.components, pred_state.dim);
+    GaussianMixture expected(pred_state.components, pred_state.dim);
+
+    correction.correctStep(pred_state, corr_state);
+    reference_correction(pred_state, H, R, measurement, expected);
+
+    const double mean_error = relative_error(corr_state.mean(), expected.mean());
+    const double covariance_error = relative_error(corr_state.covariance(), expected.covariance());
+
+    bool symmetric = true;
+    for (std::size_t i = 0; i < pred_state.components; i++)
+        symmetric &= (corr_state.covariance(i) == corr_state.covariance(i).transpose());
+
+    if ((mean_error > 1e-10) || (covariance_error > 1e-10) || !symmetric)
+    {
+        std::cerr << "[" << name << "] Wrong correction: mean error " << mean_error << ", covariance error " << covariance_error << ", symmetric " << symmetric << "." << std::endl;
+        return false;
+    }
+
+    std::cout << "[" << name << "] Passed, mean error " << mean_error << ", covariance error " << covariance_error << "." << std::endl;
+
+    return true;
+}
+
+
+int main()
+{
+    std::cout << "Running KFCorrection tests." << std::endl;
+
+    std::mt19937_64 generator(1);
+
+    const std::size_t state_size = 120;
+    const std::size_t meas_size = 60;
+
+    const MatrixXd H = random_matrix(meas_size, state_size, generator);
+    const MatrixXd R = random_covariance(meas_size, generator);
+    const VectorXd measurement = random_matrix(meas_size, 1, generator);
+    const GaussianMixture pred_state = random_state(2, state_size, generator);
+
+    /* Correction of a two-component mixture. */
+    std::unique_ptr<CountingLinearSensor> cacheable_sensor = utils::make_unique<CountingLinearSensor>(H, R, measurement, true);
+    CountingLinearSensor& sensor = *cacheable_sensor;
+    TestKFCorrection correction(std::move(cacheable_sensor));
+
+    for (std::size_t k = 0; k < 3; k++)
+    {
+        if (!check_correction(correction, pred_state, H, R, measurement, "Dense 120 x 60"))
+            return EXIT_FAILURE;
+    }
+
+    /* The matrices of a model reporting a revision are fetched once. */
+    if (sensor.fetches != 1)
+    {
+        std::cerr << "[Cache] The noise covariance matrix has been fetched " << sensor.fetches << " times instead of 1." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /* A new revision is fetched again. */
+    const MatrixXd new_R = random_covariance(meas_size, generator);
+    sensor.setNoiseCovarianceMatrix(new_R);
+
+    if (!check_correction(correction, pred_state, H, new_R, measurement, "New noise covariance matrix"))
+        return EXIT_FAILURE;
+
+    if (sensor.fetches != 2)
+    {
+        std::cerr << "[Cache] The noise covariance matrix has been fetched " << sensor.fetches << " times instead of 2." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /* The matrices of a model not reporting a revision are fetched at every step. */
+    std::unique_ptr<CountingLinearSensor> uncacheable_sensor = utils::make_unique<CountingLinearSensor>(H, R, measurement, false);
+    CountingLinearSensor& time_varying_sensor = *uncacheable_sensor;
+    TestKFCorrection time_varying_correction(std::move(uncacheable_sensor));
+
+    for (std::size_t k = 0; k < 3; k++)
+    {
+        if (!check_correction(time_varying_correction, pred_state, H, R, measurement, "Without revision"))
+            return EXIT_FAILURE;
+    }
+
+    if (time_varying_sensor.fetches != 3)
+    {
+        std::cerr << "[Cache] The noise covariance matrix has been fetched " << time_varying_sensor.fetches << " times instead of 3." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[Cache] Passed." << std::endl;
+
+    /* Compare the time of the correction with the one using the explicit inverse. */
+    for (const std::size_t size : {25, 50, 100, 200})
+    {
+        const std::size_t repetitions = 20000000 / (size * size * size) + 1;
+
+        const MatrixXd H_b = random_matrix(size / 2, size, generator);
+        const MatrixXd R_b = random_covariance(size / 2, generator);
+        const VectorXd measurement_b = random_matrix(size / 2, 1, generator);
+        const GaussianMixture pred_state_b = random_state(1, size, generator);
+        GaussianMixture corr_state_b(1, size);
+
+        TestKFCorrection correction_b(utils::make_unique<CountingLinearSensor>(H_b, R_b, measurement_b, true));
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            reference_correction(pred_state_b, H_b, R_b, measurement_b, corr_state_b);
+        auto stop = std::chrono::steady_clock::now();
+        const double reference_time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            correction_b.correctStep(pred_state_b, corr_state_b);
+        stop = std::chrono::steady_clock::now();
+        const double time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        std::cout << "[Benchmark] n = " << std::setw(3) << size << ", m = " << std::setw(3) << size / 2
+                  << ": explicit inverse " << std::setw(9) << std::fixed << std::setprecision(1) << reference_time << " us"
+                  << ", KFCorrection " << std::setw(9) << time << " us" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include <BayesFilters/BootstrapCorrection.h>
+#include <BayesFilters/GaussianLikelihood.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/ParticleSet.h>
+#include <BayesFilters/utils.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * A nonlinear measurement model y = H * x + 0.1 * sin(y), solved with a fixed
+ * number of fixed-point iterations to emulate an expensive measurement model.
+ */
+class ExpensiveSensor : public LTIMeasurementModel
+{
+public:
+    ExpensiveSensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const Ref<const VectorXd>& measurement, const unsigned int iterations) :
+        LTIMeasurementModel(measurement_matrix, noise_covariance_matrix),
+        measurement_(measurement),
+        iterations_(iterations)
+    { }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    std::pair<bool, Data> predictedMeasure(const Ref<const MatrixXd>& cur_states) const override
+    {
+        MatrixXd linear_measurements = H_ * cur_states;
+
+        MatrixXd predicted_measurements = linear_measurements;
+        for (unsigned int k = 0; k < iterations_; ++k)
+            predicted_measurements = linear_measurements + 0.1 * predicted_measurements.array().sin().matrix();
+
+        return std::make_pair(true, predicted_measurements);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+private:
+    MatrixXd measurement_;
+
+    unsigned int iterations_;
+};
+
+
+std::unique_ptr<BoostrapCorrection> make_correction(const std::size_t state_size, const unsigned int iterations)
+{
+    MatrixXd H = MatrixXd::Identity(state_size, state_size);
+    MatrixXd R = MatrixXd::Identity(state_size, state_size) * 0.5;
+    VectorXd measurement = VectorXd::Constant(state_size, 0.3);
+
+    std::unique_ptr<BoostrapCorrection> correction = utils::make_unique<BoostrapCorrection>();
+    correction->setMeasurementModel(utils::make_unique<ExpensiveSensor>(H, R, measurement, iterations));
+    correction->setLikelihoodModel(utils::make_unique<GaussianLikelihood>());
+
+    return correction;
+}
+
+
+ParticleSet random_particle_set(const std::size_t num_particle, const std::size_t state_size, const unsigned int seed)
+{
+    std::mt19937_64 generator(seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    ParticleSet particles(num_particle, state_size, 0, false);
+
+    for (std::size_t i = 0; i < num_particle; ++i)
+    {
+        for (std::size_t j = 0; j < state_size; ++j)
+            particles.state(i, j) = distribution(generator);
+    }
+
+    particles.weight().setConstant(-std::log(static_cast<double>(num_particle)));
+
+    return particles;
+}
+
+
+int main()
+{
+    std::cout << "Comparing parallel correction against serial correction..." << std::endl;
+
+    const std::size_t state_size = 4;
+
+    for (std::size_t num_particle : {1, 5, 100, 1001})
+    {
+        ParticleSet pred_particles = random_particle_set(num_particle, state_size, num_particle);
+
+        ParticleSet serial_particles(num_particle, state_size, 0, false);
+        std::unique_ptr<BoostrapCorrection> serial_correction = make_correction(state_size, 5);
+        serial_correction->correct(pred_particles, serial_particles);
+
+        for (std::size_t num_threads : {1, 2, 3, 8})
+        {
+            for (std::size_t block_size : {0, 1, 7, 64})
+            {
+                ParticleSet parallel_particles(num_particle, state_size, 0, false);
+                std::unique_ptr<BoostrapCorrection> parallel_correction = make_correction(state_size, 5);
+                parallel_correction->setNumberOfThreads(num_threads);
+                parallel_correction->setBlockSize(block_size);
+                parallel_correction->correct(pred_particles, parallel_particles);
+
+                if (((serial_particles.weight() - parallel_particles.weight()).array().abs() > 1e-12 * serial_particles.weight().array().abs()).any() ||
+                    (serial_particles.state().array() != parallel_particles.state().array()).any())
+                {
+                    std::cerr << "Parallel correction with " << num_threads << " threads and block size " << block_size << " differs from serial correction with " << num_particle << " particles." << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+    }
+
+    std::cout << "Parallel and serial correction produced the same results.\n" << std::endl;
+
+
+    const unsigned int hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Scaling benchmark (time per correction in milliseconds, " << hardware_threads << " hardware threads):" << std::endl;
+    std::cout << std::setw(12) << "particles" << std::setw(12) << "threads" << std::setw(12) << "block" << std::setw(12) << "time" << std::endl;
+
+    const unsigned int repetitions = 3;
+
+    for (std::size_t num_particle : {1000, 10000})
+    {
+        ParticleSet pred_particles = random_particle_set(num_particle, state_size, 1);
+        ParticleSet cor_particles(num_particle, state_size, 0, false);
+
+        for (std::size_t num_threads : {1, 2, 4, 8})
+        {
+            for (std::size_t block_size : {0, 256})
+            {
+                std::unique_ptr<BoostrapCorrection> correction = make_correction(state_size, 100);
+                correction->setNumberOfThreads(num_threads);
+                correction->setBlockSize(block_size);
+
+                auto start = std::chrono::steady_clock::now();
+                for (unsigned int r = 0; r < repetitions; ++r)
+                    correction->correct(pred_particles, cor_particles);
+                std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+                std::cout << std::setw(12) << num_particle << std::setw(12) << num_threads << std::setw(12) << block_size
+                          << std::setw(12) << std::fixed << std::setprecision(3) << elapsed.count() / repetitions << std::endl;
+            }
+        }
+    }
+
+    std::cout << "done!" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <BayesFilters/ParallelSystematicResampling.h>
+#include <BayesFilters/ParticleSet.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/utils.h>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+ParticleSet random_particle_set(const std::size_t num_particle, const std::size_t state_size, const unsigned int seed)
+{
+    std::mt19937_64 generator(seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    ParticleSet particles(num_particle, state_size);
+
+    for (std::size_t i = 0; i < num_particle; ++i)
+    {
+        for (std::size_t j = 0; j < state_size; ++j)
+            particles.state(i, j) = distribution(generator);
+
+        particles.mean(i) = particles.state(i);
+        particles.covariance(i) = MatrixXd::Identity(state_size, state_size) * (i + 1);
+
+        /* Unnormalized log weights with a large dynamic range. */
+        particles.weight(i) = 5.0 * distribution(generator);
+    }
+
+    particles.weight().array() -= utils::log_sum_exp(particles.weight());
+
+    return particles;
+}
+
+
+int main()
+{
+    std::cout << "Comparing parallel systematic resampling against serial systematic resampling..." << std::endl;
+
+    const std::size_t state_size = 4;
+    const unsigned int seed = 7;
+
+    for (std::size_t num_particle : {1, 5, 4095, 4096, 4097, 10000, 50000})
+    {
+        ParticleSet cor_particles = random_particle_set(num_particle, state_size, num_particle);
+
+        ParticleSet serial_particles(num_particle, state_size);
+        VectorXi serial_parents(num_particle);
+
+        Resampling serial_resampling(seed);
+        serial_resampling.resample(cor_particles, serial_particles, serial_parents);
+
+        for (unsigned int num_threads : {1, 2, 3, 8})
+        {
+            ParticleSet parallel_particles(num_particle, state_size);
+            VectorXi parallel_parents(num_particle);
+
+            ParallelSystematicResampling parallel_resampling(num_threads, seed);
+            parallel_resampling.resample(cor_particles, parallel_particles, parallel_parents);
+
+            if ((serial_parents.array() != parallel_parents.array()).any()                        ||
+                (serial_particles.state().array() != parallel_particles.state().array()).any()    ||
+                (serial_particles.covariance().array() != parallel_particles.covariance().array()).any() ||
+                (serial_particles.weight().array() != parallel_particles.weight().array()).any())
+            {
+                std::cerr << "Parallel resampling with " << num_threads << " threads differs from serial resampling with " << num_particle << " particles." << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    std::cout << "Parallel and serial resampling produced identical results.\n" << std::endl;
+
+
+    std::cout << "Scaling benchmark (mean time per resampling step in milliseconds):" << std::endl;
+
+    const unsigned int repetitions = 5;
+    const std::vector<unsigned int> threads = {1, 2, 4, 8};
+
+    std::cout << std::setw(12) << "particles" << std::setw(12) << "serial";
+    for (unsigned int num_threads : threads)
+        std::cout << std::setw(10) << num_threads << " th";
+    std::cout << std::endl;
+
+    for (std::size_t num_particle : {1000, 10000, 100000})
+    {
+        ParticleSet cor_particles = random_particle_set(num_particle, state_size, 1);
+        ParticleSet res_particles(num_particle, state_size);
+        VectorXi res_parents(num_particle);
+
+        auto time_resampling = [&](Resampling& resampling)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned int r = 0; r < repetitions; ++r)
+                resampling.resample(cor_particles, res_particles, res_parents);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            return elapsed.count() / repetitions;
+        };
+
+        Resampling serial_resampling(seed);
+        std::cout << std::setw(12) << num_particle << std::setw(12) << std::fixed << std::setprecision(3) << time_resampling(serial_resampling);
+
+        for (unsigned int num_threads : threads)
+        {
+            ParallelSystematicResampling parallel_resampling(num_threads, seed);
+            std::cout << std::setw(13) << time_resampling(parallel_resampling);
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "done!" << std::endl;
+
+    return EXIT_SUCCESS;
+}
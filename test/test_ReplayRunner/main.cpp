@@ -0,0 +1,219 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include <BayesFilters/Gaussian.h>
+#include <BayesFilters/GaussianFilter.h>
+#include <BayesFilters/KFCorrection.h>
+#include <BayesFilters/KFPrediction.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/RecordedAgent.h>
+#include <BayesFilters/ReplayRunner.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * A linear sensor reading the x and y coordinates from a recorded sequence.
+ */
+class RecordedSensor : public LTIMeasurementModel
+{
+public:
+    RecordedSensor(const Ref<const MatrixXd>& recording, const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix) :
+        LTIMeasurementModel(measurement_matrix, noise_covariance_matrix),
+        agent_(recording)
+    { }
+
+    bool freezeMeasurements() override
+    {
+        if (!agent_.bufferData())
+            return false;
+
+        measurement_ = any::any_cast<MatrixXd>(agent_.getData());
+
+        return true;
+    }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+private:
+    RecordedAgent agent_;
+
+    MatrixXd measurement_;
+};
+
+
+class KFReplay : public GaussianFilter
+{
+public:
+    KFReplay(Gaussian& initial_state, std::unique_ptr<GaussianPrediction> prediction, std::unique_ptr<GaussianCorrection> correction, const std::size_t steps) noexcept :
+        GaussianFilter(initial_state, std::move(prediction), std::move(correction)),
+        steps_(steps)
+    { }
+
+    const Gaussian& getCorrectedState() const
+    {
+        return corrected_state_;
+    }
+
+protected:
+    bool runCondition() override
+    {
+        return getFilteringStep() < steps_;
+    }
+
+private:
+    std::size_t steps_;
+};
+
+
+std::unique_ptr<KFReplay> make_filter(const Ref<const MatrixXd>& recording, const std::size_t steps)
+{
+    Gaussian initial_state(4);
+    initial_state.mean() << 0.0, 0.0, 0.0, 0.0;
+    initial_state.covariance() = 100.0 * Matrix4d::Identity();
+
+    MatrixXd H = MatrixXd::Zero(2, 4);
+    H(0, 0) = 1.0;
+    H(1, 2) = 1.0;
+
+    const MatrixXd R = 100.0 * Matrix2d::Identity();
+
+    return utils::make_unique<KFReplay>(initial_state,
+                                        utils::make_unique<KFPrediction>(utils::make_unique<WhiteNoiseAcceleration>(1.0, 10.0)),
+                                        utils::make_unique<KFCorrection>(utils::make_unique<RecordedSensor>(recording, H, R)),
+                                        steps);
+}
+
+
+int main()
+{
+    std::cout << "Running ReplayRunner tests." << std::endl;
+
+    /* Record the noisy positions of a target moving with constant velocity. */
+    const std::size_t length = 20000;
+
+    std::mt19937_64 generator(1);
+    std::normal_distribution<double> noise(0.0, 10.0);
+
+    MatrixXd recording(2, length);
+    for (std::size_t k = 0; k < length; k++)
+    {
+        recording(0, k) = 10.0 + 1.0 * k + noise(generator);
+        recording(1, k) = 10.0 + 0.5 * k + noise(generator);
+    }
+
+    /* The replay gives the same estimate of the threaded filtering recursion. */
+    std::unique_ptr<KFReplay> threaded_filter = make_filter(recording, length);
+
+    auto start = std::chrono::steady_clock::now();
+    threaded_filter->boot();
+    threaded_filter->run();
+    if (!threaded_filter->wait())
+        return EXIT_FAILURE;
+    auto stop = std::chrono::steady_clock::now();
+    const double threaded_steps_per_second = length / std::chrono::duration<double>(stop - start).count();
+
+    std::unique_ptr<KFReplay> replayed_filter = make_filter(recording, length);
+    ReplayRunner runner(*replayed_filter);
+    const ReplayRunner::Report report = runner.run();
+
+    if ((report.steps != length) || (replayed_filter->getFilteringStep() != length) ||
+        (replayed_filter->getCorrectedState().mean() != threaded_filter->getCorrectedState().mean()) ||
+        (replayed_filter->getCorrectedState().covariance() != threaded_filter->getCorrectedState().covariance()))
+    {
+        std::cerr << "[Replay] The replayed filter differs from the threaded one after " << report.steps << " steps." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const Vector2d position(replayed_filter->getCorrectedState().mean()(0), replayed_filter->getCorrectedState().mean()(2));
+    const Vector2d expected(10.0 + 1.0 * (length - 1), 10.0 + 0.5 * (length - 1));
+    if ((position - expected).norm() > 30.0)
+    {
+        std::cerr << "[Replay] Wrong estimate of the position, error " << (position - expected).norm() << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[Replay] Passed." << std::endl;
+
+    /* The number of steps can be bounded, e.g. by the length of a recording. */
+    {
+        std::unique_ptr<KFReplay> filter = make_filter(recording, length);
+        ReplayRunner bounded_runner(*filter);
+
+        if ((bounded_runner.run(100).steps != 100) || (filter->getFilteringStep() != 100))
+        {
+            std::cerr << "[Bounded replay] Wrong number of steps." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Bounded replay] Passed." << std::endl;
+    }
+
+    /* A teardown() issued before the replay is honored. */
+    {
+        std::unique_ptr<KFReplay> filter = make_filter(recording, length);
+        ReplayRunner torn_down_runner(*filter);
+
+        filter->teardown();
+
+        if ((torn_down_runner.run().steps != 0) || (filter->getFilteringStep() != 0))
+        {
+            std::cerr << "[Teardown] A filter torn down before the replay ran filtering steps." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Teardown] Passed." << std::endl;
+    }
+
+    /* A booted filter cannot be replayed. */
+    {
+        std::unique_ptr<KFReplay> filter = make_filter(recording, length);
+        ReplayRunner booted_runner(*filter);
+
+        filter->boot();
+
+        bool thrown = false;
+        try
+        {
+            booted_runner.run();
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+
+        filter->teardown();
+        filter->wait();
+
+        if (!thrown)
+        {
+            std::cerr << "[Booted filter] A booted filter has been replayed." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Booted filter] Passed." << std::endl;
+    }
+
+    /* The throughput depends on the machine, hence it is only reported. */
+    std::cout << "[Benchmark] " << length << " steps: replay " << report.steps_per_second << " steps/s, threaded recursion " << threaded_steps_per_second << " steps/s." << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,203 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <BayesFilters/BootstrapCorrection.h>
+#include <BayesFilters/DrawParticles.h>
+#include <BayesFilters/GaussianLikelihood.h>
+#include <BayesFilters/InitSurveillanceAreaGrid.h>
+#include <BayesFilters/MetropolisResampling.h>
+#include <BayesFilters/ParallelSystematicResampling.h>
+#include <BayesFilters/RejectionResampling.h>
+#include <BayesFilters/Resampling.h>
+#include <BayesFilters/ResidualResampling.h>
+#include <BayesFilters/SimulatedLinearSensor.h>
+#include <BayesFilters/SimulatedStateModel.h>
+#include <BayesFilters/SIS.h>
+#include <BayesFilters/StratifiedResampling.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * Wraps a resampling scheme and collects its cost, the effective sample size
+ * of the weights it is queried with and the number of distinct parents it draws.
+ */
+class ResamplingStatistics : public Resampling
+{
+public:
+    ResamplingStatistics(std::unique_ptr<Resampling> resampling) noexcept :
+        resampling_(std::move(resampling))
+    { }
+
+    void resample(const ParticleSet& cor_particles, ParticleSet& res_particles, Ref<VectorXi> res_parents) override
+    {
+        auto start = std::chrono::steady_clock::now();
+        resampling_->resample(cor_particles, res_particles, res_parents);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        resampling_time_ += elapsed.count();
+        ++resampling_steps_;
+
+        std::set<int> parents(res_parents.data(), res_parents.data() + res_parents.size());
+        unique_parents_ += static_cast<double>(parents.size()) / res_parents.size();
+
+        /* Effective sample size of the resampled set, accounting for repeated particles. */
+        VectorXd copies = VectorXd::Zero(cor_particles.weight().size());
+        for (int i = 0; i < res_parents.size(); ++i)
+            copies(res_parents(i)) += 1.0;
+        resampled_neff_ += 1.0 / (copies / res_parents.size()).squaredNorm();
+    }
+
+    double neff(const Ref<const VectorXd>& cor_weights) override
+    {
+        double neff = resampling_->neff(cor_weights);
+
+        neff_ += neff;
+        ++steps_;
+
+        return neff;
+    }
+
+    void print(const std::string& name) const
+    {
+        std::cout << std::setw(24) << name
+                  << std::setw(12) << resampling_steps_
+                  << std::setw(16) << std::fixed << std::setprecision(3) << (resampling_steps_ > 0 ? resampling_time_ / resampling_steps_ : 0.0)
+                  << std::setw(16) << std::setprecision(1) << (steps_ > 0 ? neff_ / steps_ : 0.0)
+                  << std::setw(16) << (resampling_steps_ > 0 ? resampled_neff_ / resampling_steps_ : 0.0)
+                  << std::setw(16) << std::setprecision(3) << (resampling_steps_ > 0 ? unique_parents_ / resampling_steps_ : 0.0)
+                  << std::endl;
+    }
+
+private:
+    std::unique_ptr<Resampling> resampling_;
+
+    double resampling_time_ = 0.0;
+
+    unsigned int resampling_steps_ = 0;
+
+    double unique_parents_ = 0.0;
+
+    double resampled_neff_ = 0.0;
+
+    double neff_ = 0.0;
+
+    unsigned int steps_ = 0;
+};
+
+
+class SISSimulation : public SIS
+{
+public:
+    SISSimulation
+    (
+        unsigned int num_particle,
+        std::size_t state_size,
+        unsigned int simulation_steps,
+        std::unique_ptr<ParticleSetInitialization> initialization,
+        std::unique_ptr<PFPrediction> prediction,
+        std::unique_ptr<PFCorrection> correction,
+        std::unique_ptr<Resampling> resampling
+    ) noexcept :
+        SIS(num_particle, state_size, 0, std::move(initialization), std::move(prediction), std::move(correction), std::move(resampling), false),
+        simulation_steps_(simulation_steps)
+    { }
+
+protected:
+    bool runCondition() override
+    {
+        if (getFilteringStep() < simulation_steps_)
+            return true;
+        else
+            return false;
+    }
+
+private:
+    unsigned int simulation_steps_;
+};
+
+
+/**
+ * Run the same scenario of test_SIS using the given resampling scheme.
+ */
+bool run_scenario(const std::string& name, std::unique_ptr<Resampling> resampling)
+{
+    double surv_x = 1000.0;
+    double surv_y = 1000.0;
+    unsigned int num_particle_x = 100;
+    unsigned int num_particle_y = 100;
+    unsigned int num_particle = num_particle_x * num_particle_y;
+    Vector4d initial_state(10.0f, 0.0f, 10.0f, 0.0f);
+    unsigned int simulation_time = 30;
+    std::size_t state_size = 4;
+    double T = 1.0f;
+    double tilde_q = 10.0f;
+
+    std::unique_ptr<ParticleSetInitialization> grid_initialization = utils::make_unique<InitSurveillanceAreaGrid>(surv_x, surv_y, num_particle_x, num_particle_y);
+
+    std::unique_ptr<PFPrediction> pf_prediction = utils::make_unique<DrawParticles>();
+    pf_prediction->setStateModel(utils::make_unique<WhiteNoiseAcceleration>(T, tilde_q));
+
+    std::unique_ptr<StateModel> target_model = utils::make_unique<WhiteNoiseAcceleration>(T, tilde_q);
+    std::unique_ptr<SimulatedStateModel> simulated_state_model = utils::make_unique<SimulatedStateModel>(std::move(target_model), initial_state, simulation_time);
+    std::unique_ptr<MeasurementModel> simulated_linear_sensor = utils::make_unique<SimulatedLinearSensor>(std::move(simulated_state_model));
+
+    std::unique_ptr<PFCorrection> pf_correction = utils::make_unique<BoostrapCorrection>();
+    pf_correction->setLikelihoodModel(utils::make_unique<GaussianLikelihood>());
+    pf_correction->setMeasurementModel(std::move(simulated_linear_sensor));
+
+    std::unique_ptr<ResamplingStatistics> statistics = utils::make_unique<ResamplingStatistics>(std::move(resampling));
+    ResamplingStatistics& statistics_ref = *statistics;
+
+    SISSimulation sis_pf(num_particle, state_size, simulation_time, std::move(grid_initialization), std::move(pf_prediction), std::move(pf_correction), std::move(statistics));
+
+    sis_pf.boot();
+    sis_pf.run();
+    if (!sis_pf.wait())
+        return false;
+
+    statistics_ref.print(name);
+
+    return true;
+}
+
+
+int main()
+{
+    std::cout << "Comparing resampling schemes on the test_SIS scenario." << std::endl;
+    std::cout << "Columns: number of resampling steps, mean time per resampling step in milliseconds,\n"
+              << "mean effective sample size before resampling, mean effective sample size of the resampled set\n"
+              << "and mean fraction of distinct parents.\n" << std::endl;
+
+    std::cout << std::setw(24) << "scheme"
+              << std::setw(12) << "steps"
+              << std::setw(16) << "time [ms]"
+              << std::setw(16) << "neff"
+              << std::setw(16) << "resampled neff"
+              << std::setw(16) << "distinct" << std::endl;
+
+    bool success = true;
+
+    success &= run_scenario("systematic",          utils::make_unique<Resampling>());
+    success &= run_scenario("parallel systematic", utils::make_unique<ParallelSystematicResampling>());
+    success &= run_scenario("stratified",          utils::make_unique<StratifiedResampling>());
+    success &= run_scenario("residual",            utils::make_unique<ResidualResampling>());
+    success &= run_scenario("metropolis (B = 32)", utils::make_unique<MetropolisResampling>(32));
+    success &= run_scenario("rejection",           utils::make_unique<RejectionResampling>());
+
+    if (!success)
+        return EXIT_FAILURE;
+
+    std::cout << "\ndone!" << std::endl;
+
+    return EXIT_SUCCESS;
+}
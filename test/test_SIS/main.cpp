@@ -30,7 +30,7 @@ public:
         std::unique_ptr<PFCorrection> correction,
         std::unique_ptr<Resampling> resampling
     ) noexcept :
-        SIS(num_particle, state_size, std::move(initialization), std::move(prediction), std::move(correction), std::move(resampling)),
+        SIS(num_particle, state_size, 0, std::move(initialization), std::move(prediction), std::move(correction), std::move(resampling), false),
         simulation_steps_(simulation_steps)
     { }
 
@@ -0,0 +1,478 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <BayesFilters/Gaussian.h>
+#include <BayesFilters/GaussianFilter.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/LTIStateModel.h>
+#include <BayesFilters/sigma_point.h>
+#include <BayesFilters/SquareRootCovariance.h>
+#include <BayesFilters/SRUKFCorrection.h>
+#include <BayesFilters/SRUKFPrediction.h>
+#include <BayesFilters/UKFCorrection.h>
+#include <BayesFilters/UKFPrediction.h>
+#include <BayesFilters/utils.h>
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace bfl::sigma_point;
+using namespace Eigen;
+
+
+/**
+ * A linear time invariant state model of any size.
+ */
+class LTIModel : public LTIStateModel
+{
+public:
+    LTIModel(const Ref<const MatrixXd>& transition_matrix, const Ref<const MatrixXd>& noise_covariance_matrix) :
+        LTIStateModel(transition_matrix, noise_covariance_matrix)
+    { }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(F_.rows(), 0);
+    }
+};
+
+
+/**
+ * A linear sensor whose measurement changes deterministically at every freezeMeasurements(),
+ * so that two filters receive the same sequence of measurements.
+ */
+class SequenceLinearSensor : public LTIMeasurementModel
+{
+public:
+    SequenceLinearSensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix) :
+        LTIMeasurementModel(measurement_matrix, noise_covariance_matrix),
+        measurement_(measurement_matrix.rows(), 1)
+    { }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    bool freezeMeasurements() override
+    {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(measurement_.rows()); i++)
+            measurement_(i, 0) = 10.0 * std::sin(0.05 * step_ + i) + 0.1 * i * step_;
+
+        step_++;
+
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+private:
+    MatrixXd measurement_;
+
+    std::size_t step_ = 0;
+};
+
+
+/**
+ * A nonlinear sensor measuring the position and the distance from the origin
+ * of a white noise acceleration target, with the same measurements as SequenceLinearSensor.
+ */
+class RangeSensor : public AdditiveMeasurementModel
+{
+public:
+    RangeSensor(const Ref<const MatrixXd>& noise_covariance_matrix) :
+        R_(noise_covariance_matrix),
+        measurement_(3, 1)
+    { }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    std::pair<bool, Data> predictedMeasure(const Ref<const MatrixXd>& cur_states) const override
+    {
+        MatrixXd predicted(3, cur_states.cols());
+        predicted.row(0) = cur_states.row(0);
+        predicted.row(1) = cur_states.row(2);
+        predicted.row(2) = (cur_states.row(0).array().square() + cur_states.row(2).array().square()).sqrt();
+
+        return std::make_pair(true, predicted);
+    }
+
+    std::pair<bool, Data> innovation(const Data& predicted_measurements, const Data& measurements) const override
+    {
+        MatrixXd innovation = -(any::any_cast<MatrixXd>(predicted_measurements).colwise() - any::any_cast<MatrixXd>(measurements).col(0));
+
+        return std::make_pair(true, innovation);
+    }
+
+    std::pair<bool, MatrixXd> getNoiseCovarianceMatrix() const override
+    {
+        return std::make_pair(true, R_);
+    }
+
+    bool freezeMeasurements() override
+    {
+        const double x = 10.0 + 2.0 * std::sin(0.05 * step_);
+        const double y = 10.0 + 1.0 * step_;
+        measurement_ << x, y, std::sqrt(x * x + y * y);
+
+        step_++;
+
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(3, 0);
+    }
+
+private:
+    MatrixXd R_;
+
+    MatrixXd measurement_;
+
+    std::size_t step_ = 0;
+};
+
+
+/**
+ * A GaussianFilter exposing its corrected state.
+ */
+class StepFilter : public GaussianFilter
+{
+public:
+    StepFilter(Gaussian& initial_state, std::unique_ptr<GaussianPrediction> prediction, std::unique_ptr<GaussianCorrection> correction) noexcept :
+        GaussianFilter(initial_state, std::move(prediction), std::move(correction))
+    { }
+
+    const Gaussian& getCorrectedState() const
+    {
+        return corrected_state_;
+    }
+};
+
+
+MatrixXd random_covariance(const std::size_t size, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    MatrixXd A(size, size);
+    for (std::size_t i = 0; i < size * size; i++)
+        A.data()[i] = normal(generator);
+
+    return A * A.transpose() + 0.1 * MatrixXd::Identity(size, size);
+}
+
+
+double relative_error(const Ref<const MatrixXd>& value, const Ref<const MatrixXd>& reference)
+{
+    return (value - reference).norm() / std::max(reference.norm(), 1.0);
+}
+
+
+bool check_cholesky_update()
+{
+    std::mt19937_64 generator(1);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    const std::size_t size = 8;
+    const MatrixXd covariance = random_covariance(size, generator);
+    MatrixXd L = covariance.llt().matrixL();
+
+    VectorXd v(size);
+    for (std::size_t i = 0; i < size; i++)
+        v(i) = normal(generator);
+
+    /* Update. */
+    VectorXd tmp = v;
+    if (!cholesky_update(L, tmp, 0.5))
+    {
+        std::cerr << "[cholesky_update] The update failed." << std::endl;
+        return false;
+    }
+
+    const MatrixXd updated = covariance + 0.5 * v * v.transpose();
+    if (relative_error(L.triangularView<Lower>() * L.transpose(), updated) > 1e-12)
+    {
+        std::cerr << "[cholesky_update] Wrong update." << std::endl;
+        return false;
+    }
+
+    /* Downdate back to the initial matrix. */
+    tmp = v;
+    if (!cholesky_update(L, tmp, -0.5))
+    {
+        std::cerr << "[cholesky_update] The downdate failed." << std::endl;
+        return false;
+    }
+
+    if (relative_error(L.triangularView<Lower>() * L.transpose(), covariance) > 1e-10)
+    {
+        std::cerr << "[cholesky_update] Wrong downdate." << std::endl;
+        return false;
+    }
+
+    /* A downdate resulting in a matrix that is not positive definite must fail. */
+    L = MatrixXd::Identity(size, size);
+    tmp = VectorXd::Unit(size, 3) * 2.0;
+    if (cholesky_update(L, tmp, -1.0))
+    {
+        std::cerr << "[cholesky_update] A downdate to an indefinite matrix did not fail." << std::endl;
+        return false;
+    }
+
+    std::cout << "[cholesky_update] Passed." << std::endl;
+
+    return true;
+}
+
+
+bool check_triangular_square_root()
+{
+    std::mt19937_64 generator(2);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    const std::size_t size = 6;
+    const UTWeight weight(size, 0.5, 2.0, 0.0);
+    const std::size_t num_points = weight.mean.size();
+
+    MatrixXd deviations(size, num_points);
+    for (std::size_t i = 0; i < size * num_points; i++)
+        deviations.data()[i] = normal(generator);
+
+    const MatrixXd noise = random_covariance(size, generator);
+    const MatrixXd sqrt_noise = noise.llt().matrixL();
+
+    /* With alpha < 1 the weight of the center point is negative, requiring a downdate. */
+    if (weight.covariance(0) >= 0.0)
+    {
+        std::cerr << "[triangular_square_root] Expected a negative weight." << std::endl;
+        return false;
+    }
+
+    UTWorkspace workspace;
+    MatrixXd S(size, size);
+    triangular_square_root(deviations, weight.covariance, sqrt_noise, S, workspace);
+
+    const MatrixXd expected = deviations * weight.covariance.asDiagonal() * deviations.transpose() + noise;
+    if (relative_error(S * S.transpose(), expected) > 1e-10)
+    {
+        std::cerr << "[triangular_square_root] Wrong square root." << std::endl;
+        return false;
+    }
+
+    if (!S.triangularView<StrictlyUpper>().toDenseMatrix().isZero() || (S.diagonal().array() < 0.0).any())
+    {
+        std::cerr << "[triangular_square_root] The square root is not lower triangular with non-negative diagonal." << std::endl;
+        return false;
+    }
+
+    std::cout << "[triangular_square_root] Passed." << std::endl;
+
+    return true;
+}
+
+
+/**
+ * Run a UKF and a square-root UKF, both inside a GaussianFilter, and compare their estimates.
+ */
+template<typename MeasurementModelType>
+bool check_filter(const std::string& name, const UTWeight& weight, const Ref<const MatrixXd>& noise_covariance_matrix, const std::size_t steps)
+{
+    const std::size_t state_size = 4;
+
+    Gaussian initial_state(state_size);
+    initial_state.mean() << 10.0, 0.0, 10.0, 1.0;
+    initial_state.covariance() = Vector4d(0.5, 0.1, 0.5, 0.1).asDiagonal();
+
+    std::unique_ptr<AdditiveStateModel> ukf_model = utils::make_unique<WhiteNoiseAcceleration>(1.0, 0.1);
+    std::unique_ptr<AdditiveMeasurementModel> ukf_sensor = utils::make_unique<MeasurementModelType>(noise_covariance_matrix);
+    StepFilter ukf(initial_state,
+                   utils::make_unique<UKFPrediction>(std::move(ukf_model), weight),
+                   utils::make_unique<UKFCorrection>(std::move(ukf_sensor), weight));
+
+    std::shared_ptr<SquareRootCovariance> square_root = std::make_shared<SquareRootCovariance>();
+    std::unique_ptr<AdditiveStateModel> srukf_model = utils::make_unique<WhiteNoiseAcceleration>(1.0, 0.1);
+    std::unique_ptr<AdditiveMeasurementModel> srukf_sensor = utils::make_unique<MeasurementModelType>(noise_covariance_matrix);
+    StepFilter srukf(initial_state,
+                     utils::make_unique<SRUKFPrediction>(std::move(srukf_model), weight, square_root),
+                     utils::make_unique<SRUKFCorrection>(std::move(srukf_sensor), weight, square_root));
+
+    double max_error = 0.0;
+    for (std::size_t k = 0; k < steps; k++)
+    {
+        ukf.filteringStep();
+        srukf.filteringStep();
+
+        max_error = std::max(max_error, relative_error(srukf.getCorrectedState().mean(), ukf.getCorrectedState().mean()));
+        max_error = std::max(max_error, relative_error(srukf.getCorrectedState().covariance(), ukf.getCorrectedState().covariance()));
+
+        /* The square roots are handed over between the prediction and the correction. */
+        if ((k > 0) && !square_root->factorize(srukf.getCorrectedState()))
+        {
+            std::cerr << "[" << name << "] The square root of the corrected state has not been reused." << std::endl;
+            return false;
+        }
+    }
+
+    if (max_error > 1e-8)
+    {
+        std::cerr << "[" << name << "] The estimates differ from the UKF, relative error " << max_error << "." << std::endl;
+        return false;
+    }
+
+    std::cout << "[" << name << "] Passed, maximum relative error " << max_error << "." << std::endl;
+
+    return true;
+}
+
+
+/**
+ * Run a long filtering session with very accurate measurements, where the covariance
+ * matrices become ill-conditioned, and check that the covariance stays positive definite.
+ */
+bool check_long_run()
+{
+    const std::size_t state_size = 4;
+    const std::size_t steps = 20000;
+
+    Gaussian state(state_size);
+    state.mean() << 10.0, 0.0, 10.0, 1.0;
+    state.covariance() = Vector4d(1.0, 1.0, 1.0, 1.0).asDiagonal();
+
+    MatrixXd H(2, 4);
+    H << 1.0, 0.0, 0.0, 0.0,
+         0.0, 0.0, 1.0, 0.0;
+
+    std::shared_ptr<SquareRootCovariance> square_root = std::make_shared<SquareRootCovariance>();
+    const UTWeight weight(state_size, 1e-3, 2.0, 0.0);
+    SRUKFPrediction prediction(utils::make_unique<WhiteNoiseAcceleration>(1.0, 1e-6), weight, square_root);
+    SRUKFCorrection correction(utils::make_unique<SequenceLinearSensor>(H, 1e-10 * MatrixXd::Identity(2, 2)), weight, square_root);
+
+    Gaussian predicted(state_size);
+    for (std::size_t k = 0; k < steps; k++)
+    {
+        prediction.predict(state, predicted);
+        correction.correct(predicted, state);
+    }
+
+    const SelfAdjointEigenSolver<MatrixXd> eigen(state.covariance());
+    if (!state.covariance().allFinite() || (eigen.eigenvalues().minCoeff() <= 0.0) || !state.covariance().isApprox(state.covariance().transpose()))
+    {
+        std::cerr << "[Long run] The covariance matrix is not positive definite after " << steps << " steps." << std::endl;
+        return false;
+    }
+
+    std::cout << "[Long run] Passed, minimum eigenvalue " << eigen.eigenvalues().minCoeff() << " after " << steps << " steps." << std::endl;
+
+    return true;
+}
+
+
+/**
+ * Time the prediction and correction steps of the UKF and of the square-root UKF.
+ */
+void benchmark(const std::size_t state_size, const std::size_t meas_size, const std::size_t steps)
+{
+    std::mt19937_64 generator(3);
+
+    const MatrixXd F = 0.999 * MatrixXd::Identity(state_size, state_size);
+    const MatrixXd Q = 1e-2 * random_covariance(state_size, generator);
+    MatrixXd H = MatrixXd::Zero(meas_size, state_size);
+    H.leftCols(meas_size) = MatrixXd::Identity(meas_size, meas_size);
+    const MatrixXd R = random_covariance(meas_size, generator);
+
+    Gaussian initial_state(state_size);
+    initial_state.mean().setZero();
+    initial_state.covariance() = random_covariance(state_size, generator);
+
+    const UTWeight weight(state_size, 1.0, 2.0, 0.0);
+
+    StepFilter ukf(initial_state,
+                   utils::make_unique<UKFPrediction>(std::unique_ptr<AdditiveStateModel>(utils::make_unique<LTIModel>(F, Q)), weight),
+                   utils::make_unique<UKFCorrection>(std::unique_ptr<AdditiveMeasurementModel>(utils::make_unique<SequenceLinearSensor>(H, R)), weight));
+
+    std::shared_ptr<SquareRootCovariance> square_root = std::make_shared<SquareRootCovariance>();
+    StepFilter srukf(initial_state,
+                     utils::make_unique<SRUKFPrediction>(utils::make_unique<LTIModel>(F, Q), weight, square_root),
+                     utils::make_unique<SRUKFCorrection>(utils::make_unique<SequenceLinearSensor>(H, R), weight, square_root));
+
+    auto time = [steps](StepFilter& filter)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < steps; k++)
+            filter.filteringStep();
+        auto stop = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::micro>(stop - start).count() / steps;
+    };
+
+    const double ukf_time = time(ukf);
+    const double srukf_time = time(srukf);
+
+    std::cout << "[Benchmark] n = " << std::setw(3) << state_size << ", m = " << std::setw(3) << meas_size
+              << ": UKF " << std::setw(10) << std::fixed << std::setprecision(1) << ukf_time << " us/step"
+              << ", SRUKF " << std::setw(10) << srukf_time << " us/step" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
+
+
+int main()
+{
+    std::cout << "Running square-root UKF tests." << std::endl;
+
+    if (!check_cholesky_update())
+        return EXIT_FAILURE;
+
+    if (!check_triangular_square_root())
+        return EXIT_FAILURE;
+
+    /* Linear measurements of the position, for all the sets of sigma points. */
+    struct LinearSensor : public SequenceLinearSensor
+    {
+        LinearSensor(const Ref<const MatrixXd>& R) :
+            SequenceLinearSensor((MatrixXd(2, 4) << 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0).finished(), R)
+        { }
+    };
+
+    const MatrixXd R_linear = (MatrixXd(2, 2) << 0.5, 0.1, 0.1, 0.3).finished();
+    const MatrixXd R_range = (Vector3d(0.5, 0.5, 0.2)).asDiagonal();
+
+    if (!check_filter<LinearSensor>("Symmetric, linear", UTWeight(4, 1.0, 2.0, 0.0), R_linear, 200))
+        return EXIT_FAILURE;
+
+    if (!check_filter<LinearSensor>("Symmetric with negative weight, linear", UTWeight(4, 0.5, 2.0, 0.0), R_linear, 200))
+        return EXIT_FAILURE;
+
+    if (!check_filter<LinearSensor>("SphericalSimplex, linear", UTWeight(SigmaPointSet::SphericalSimplex, 4, 0.2), R_linear, 200))
+        return EXIT_FAILURE;
+
+    if (!check_filter<LinearSensor>("Cubature, linear", UTWeight(SigmaPointSet::Cubature, 4, 0.0), R_linear, 200))
+        return EXIT_FAILURE;
+
+    if (!check_filter<RangeSensor>("Symmetric, range", UTWeight(4, 1.0, 2.0, 0.0), R_range, 200))
+        return EXIT_FAILURE;
+
+    if (!check_filter<RangeSensor>("Cubature, range", UTWeight(SigmaPointSet::Cubature, 4, 0.0), R_range, 200))
+        return EXIT_FAILURE;
+
+    if (!check_long_run())
+        return EXIT_FAILURE;
+
+    for (const std::size_t state_size : {4, 16, 64})
+        benchmark(state_size, state_size / 2, 200);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <BayesFilters/AdditiveMeasurementModel.h>
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/SUKFCorrection.h>
+#include <BayesFilters/UKFCorrection.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * A linear sensor made of many 3D points, y = H * x + v, with block diagonal noise covariance matrix.
+ * If reduced, the noise covariance matrix of a single point is returned.
+ */
+class PointCloudSensor : public AdditiveMeasurementModel
+{
+public:
+    PointCloudSensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const Ref<const VectorXd>& measurement, const bool reduced) :
+        H_(measurement_matrix),
+        R_(noise_covariance_matrix),
+        measurement_(measurement),
+        reduced_(reduced)
+    { }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    std::pair<bool, Data> predictedMeasure(const Ref<const MatrixXd>& cur_states) const override
+    {
+        MatrixXd prediction = H_ * cur_states;
+        return std::make_pair(true, std::move(prediction));
+    }
+
+    std::pair<bool, Data> innovation(const Data& predicted_measurements, const Data& measurements) const override
+    {
+        MatrixXd innovation = -(any::any_cast<MatrixXd>(predicted_measurements).colwise() - any::any_cast<MatrixXd>(measurements).col(0));
+        return std::make_pair(true, std::move(innovation));
+    }
+
+    std::pair<bool, MatrixXd> getNoiseCovarianceMatrix() const override
+    {
+        if (reduced_)
+            return std::make_pair(true, R_);
+
+        MatrixXd R = MatrixXd::Zero(H_.rows(), H_.rows());
+        for (Index j = 0; j < H_.rows() / 3; j++)
+            R.block<3, 3>(3 * j, 3 * j) = R_;
+
+        return std::make_pair(true, R);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+private:
+    MatrixXd H_;
+
+    MatrixXd R_;
+
+    MatrixXd measurement_;
+
+    bool reduced_;
+};
+
+
+std::unique_ptr<AdditiveMeasurementModel> make_sensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const Ref<const VectorXd>& measurement, const bool reduced)
+{
+    return utils::make_unique<PointCloudSensor>(measurement_matrix, noise_covariance_matrix, measurement, reduced);
+}
+
+
+/**
+ * Correction steps exposing the protected correctStep().
+ */
+template<typename Correction>
+class TestCorrection : public Correction
+{
+public:
+    template<typename... Args>
+    TestCorrection(Args&&... args) :
+        Correction(std::forward<Args>(args)...)
+    { }
+
+    void correctStep(const GaussianMixture& pred_state, GaussianMixture& corr_state) override
+    {
+        Correction::correctStep(pred_state, corr_state);
+    }
+};
+
+
+MatrixXd random_matrix(const std::size_t rows, const std::size_t cols, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    MatrixXd matrix(rows, cols);
+    for (std::size_t i = 0; i < rows * cols; i++)
+        matrix.data()[i] = normal(generator);
+
+    return matrix;
+}
+
+
+MatrixXd random_covariance(const std::size_t size, std::mt19937_64& generator)
+{
+    MatrixXd A = random_matrix(size, size, generator);
+
+    return A * A.transpose() / size + 0.1 * MatrixXd::Identity(size, size);
+}
+
+
+GaussianMixture random_state(const std::size_t components, const std::size_t size, std::mt19937_64& generator)
+{
+    GaussianMixture state(components, size);
+    for (std::size_t i = 0; i < components; i++)
+    {
+        state.mean(i) = random_matrix(size, 1, generator);
+        state.covariance(i) = random_covariance(size, generator);
+    }
+
+    return state;
+}
+
+
+double relative_error(const Ref<const MatrixXd>& value, const Ref<const MatrixXd>& reference)
+{
+    return (value - reference).norm() / std::max(reference.norm(), 1.0);
+}
+
+
+int main()
+{
+    std::cout << "Running SUKFCorrection tests." << std::endl;
+
+    std::mt19937_64 generator(1);
+
+    const std::size_t state_size = 6;
+    const double alpha = 1.0;
+    const double beta = 2.0;
+    const double kappa = 0.0;
+
+    /* The serial correction must match the UKF correction. */
+    {
+        const std::size_t meas_size = 3 * 200;
+
+        const MatrixXd H = random_matrix(meas_size, state_size, generator) / 10.0;
+        const MatrixXd R = random_covariance(3, generator);
+        const VectorXd measurement = random_matrix(meas_size, 1, generator);
+        const GaussianMixture pred_state = random_state(2, state_size, generator);
+
+        TestCorrection<UKFCorrection> reference(make_sensor(H, R, measurement, false), state_size, alpha, beta, kappa);
+        GaussianMixture expected(pred_state.components, state_size);
+        reference.correctStep(pred_state, expected);
+
+        for (const bool reduced : {false, true})
+        {
+            GaussianMixture single_thread_state(pred_state.components, state_size);
+
+            for (const unsigned int num_threads : {1, 3})
+            {
+                const std::string name = std::string(reduced ? "Reduced" : "Full") + " noise covariance matrix, " + std::to_string(num_threads) + " threads";
+
+                TestCorrection<SUKFCorrection> correction(make_sensor(H, R, measurement, reduced), state_size, alpha, beta, kappa, 3, reduced, num_threads);
+
+                GaussianMixture corr_state(pred_state.components, state_size);
+                correction.correctStep(pred_state, corr_state);
+
+                const double mean_error = relative_error(corr_state.mean(), expected.mean());
+                const double covariance_error = relative_error(corr_state.covariance(), expected.covariance());
+
+                bool symmetric = true;
+                for (std::size_t i = 0; i < pred_state.components; i++)
+                    symmetric &= (corr_state.covariance(i) == corr_state.covariance(i).transpose());
+
+                if ((mean_error > 1e-10) || (covariance_error > 1e-10) || !symmetric)
+                {
+                    std::cerr << "[" << name << "] Wrong correction: mean error " << mean_error << ", covariance error " << covariance_error << ", symmetric " << symmetric << "." << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                /* The partial sums are reduced in a fixed order, independent of the number of threads. */
+                if (num_threads == 1)
+                    single_thread_state = corr_state;
+                else if ((corr_state.mean() != single_thread_state.mean()) || (corr_state.covariance() != single_thread_state.covariance()))
+                {
+                    std::cerr << "[" << name << "] The correction depends on the number of threads." << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                std::cout << "[" << name << "] Passed, mean error " << mean_error << ", covariance error " << covariance_error << "." << std::endl;
+            }
+        }
+    }
+
+    /* Time the correction with a large measurement and a reduced noise covariance matrix. */
+    for (const std::size_t points : {1000, 10000})
+    {
+        const std::size_t meas_size = 3 * points;
+        const std::size_t repetitions = 10;
+
+        const MatrixXd H = random_matrix(meas_size, state_size, generator) / 10.0;
+        const MatrixXd R = random_covariance(3, generator);
+        const VectorXd measurement = random_matrix(meas_size, 1, generator);
+        const GaussianMixture pred_state = random_state(1, state_size, generator);
+        GaussianMixture corr_state(1, state_size);
+
+        for (const unsigned int num_threads : {1, 2, 4})
+        {
+            TestCorrection<SUKFCorrection> correction(make_sensor(H, R, measurement, true), state_size, alpha, beta, kappa, 3, true, num_threads);
+
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t k = 0; k < repetitions; k++)
+                correction.correctStep(pred_state, corr_state);
+            auto stop = std::chrono::steady_clock::now();
+            const double time = std::chrono::duration<double, std::milli>(stop - start).count() / repetitions;
+
+            std::cout << "[Benchmark] " << std::setw(5) << points << " points, " << num_threads << " threads: "
+                      << std::fixed << std::setprecision(2) << time << " ms" << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
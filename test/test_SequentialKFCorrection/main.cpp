@@ -0,0 +1,268 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/KFCorrection.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/SequentialKFCorrection.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * A linear sensor with a fixed measurement.
+ */
+class FixedLinearSensor : public LTIMeasurementModel
+{
+public:
+    FixedLinearSensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const Ref<const VectorXd>& measurement) :
+        LTIMeasurementModel(measurement_matrix, noise_covariance_matrix),
+        measurement_(measurement)
+    {
+        enableRevisionTracking();
+    }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+private:
+    MatrixXd measurement_;
+};
+
+
+/**
+ * Correction steps exposing the protected correctStep().
+ */
+template<typename Correction>
+class TestCorrection : public Correction
+{
+public:
+    template<typename... Args>
+    TestCorrection(Args&&... args) :
+        Correction(std::forward<Args>(args)...)
+    { }
+
+    void correctStep(const GaussianMixture& pred_state, GaussianMixture& corr_state) override
+    {
+        Correction::correctStep(pred_state, corr_state);
+    }
+};
+
+
+MatrixXd random_matrix(const std::size_t rows, const std::size_t cols, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    MatrixXd matrix(rows, cols);
+    for (std::size_t i = 0; i < rows * cols; i++)
+        matrix.data()[i] = normal(generator);
+
+    return matrix;
+}
+
+
+MatrixXd random_covariance(const std::size_t size, std::mt19937_64& generator)
+{
+    MatrixXd A = random_matrix(size, size, generator);
+
+    return A * A.transpose() / size + 0.1 * MatrixXd::Identity(size, size);
+}
+
+
+/**
+ * A block diagonal covariance matrix with blocks of the given sizes.
+ */
+MatrixXd random_block_covariance(const std::vector<std::size_t>& block_sizes, std::mt19937_64& generator)
+{
+    std::size_t size = 0;
+    for (const std::size_t block_size : block_sizes)
+        size += block_size;
+
+    MatrixXd covariance = MatrixXd::Zero(size, size);
+
+    std::size_t row = 0;
+    for (const std::size_t block_size : block_sizes)
+    {
+        covariance.block(row, row, block_size, block_size) = random_covariance(block_size, generator);
+        row += block_size;
+    }
+
+    return covariance;
+}
+
+
+GaussianMixture random_state(const std::size_t components, const std::size_t size, std::mt19937_64& generator)
+{
+    GaussianMixture state(components, size);
+    for (std::size_t i = 0; i < components; i++)
+    {
+        state.mean(i) = random_matrix(size, 1, generator);
+        state.covariance(i) = random_covariance(size, generator);
+    }
+
+    return state;
+}
+
+
+double relative_error(const Ref<const MatrixXd>& value, const Ref<const MatrixXd>& reference)
+{
+    return (value - reference).norm() / std::max(reference.norm(), 1.0);
+}
+
+
+/**
+ * Compare the sequential correction with KFCorrection.
+ */
+bool check_correction(TestCorrection<SequentialKFCorrection>& correction, const Ref<const MatrixXd>& H, const Ref<const MatrixXd>& R, const Ref<const VectorXd>& measurement, const GaussianMixture& pred_state, const std::string& name)
+{
+    TestCorrection<KFCorrection> reference(utils::make_unique<FixedLinearSensor>(H, R, measurement));
+
+    GaussianMixture corr_state(pred_state.components, pred_state.dim);
+    GaussianMixture expected(pred_state.components, pred_state.dim);
+
+    correction.correctStep(pred_state, corr_state);
+    reference.correctStep(pred_state, expected);
+
+    const double mean_error = relative_error(corr_state.mean(), expected.mean());
+    const double covariance_error = relative_error(corr_state.covariance(), expected.covariance());
+
+    bool symmetric = true;
+    for (std::size_t i = 0; i < pred_state.components; i++)
+        symmetric &= (corr_state.covariance(i) == corr_state.covariance(i).transpose());
+
+    if ((mean_error > 1e-10) || (covariance_error > 1e-10) || !symmetric)
+    {
+        std::cerr << "[" << name << "] Wrong correction: mean error " << mean_error << ", covariance error " << covariance_error << ", symmetric " << symmetric << "." << std::endl;
+        return false;
+    }
+
+    std::cout << "[" << name << "] Passed, mean error " << mean_error << ", covariance error " << covariance_error << "." << std::endl;
+
+    return true;
+}
+
+
+int main()
+{
+    std::cout << "Running SequentialKFCorrection tests." << std::endl;
+
+    std::mt19937_64 generator(1);
+
+    const std::size_t state_size = 30;
+    const std::size_t meas_size = 24;
+
+    const MatrixXd H = random_matrix(meas_size, state_size, generator);
+    const VectorXd measurement = random_matrix(meas_size, 1, generator);
+    const GaussianMixture pred_state = random_state(2, state_size, generator);
+
+    /* Diagonal noise covariance matrix, processed one scalar at a time. */
+    {
+        const MatrixXd R = random_block_covariance(std::vector<std::size_t>(meas_size, 1), generator);
+        TestCorrection<SequentialKFCorrection> correction(utils::make_unique<FixedLinearSensor>(H, R, measurement));
+
+        if (!check_correction(correction, H, R, measurement, pred_state, "Diagonal"))
+            return EXIT_FAILURE;
+    }
+
+    /* Block diagonal noise covariance matrix, with detected blocks. */
+    const std::vector<std::size_t> block_sizes = {3, 1, 6, 2, 2, 10};
+    const MatrixXd block_R = random_block_covariance(block_sizes, generator);
+    {
+        TestCorrection<SequentialKFCorrection> correction(utils::make_unique<FixedLinearSensor>(H, block_R, measurement));
+
+        if (!check_correction(correction, H, block_R, measurement, pred_state, "Detected blocks"))
+            return EXIT_FAILURE;
+    }
+
+    /* Block diagonal noise covariance matrix, with given blocks. */
+    {
+        TestCorrection<SequentialKFCorrection> correction(utils::make_unique<FixedLinearSensor>(H, block_R, measurement), block_sizes);
+
+        if (!check_correction(correction, H, block_R, measurement, pred_state, "Given blocks"))
+            return EXIT_FAILURE;
+    }
+
+    /* Dense noise covariance matrix, corrected at once. */
+    {
+        const MatrixXd R = random_covariance(meas_size, generator);
+        TestCorrection<SequentialKFCorrection> correction(utils::make_unique<FixedLinearSensor>(H, R, measurement));
+
+        if (!check_correction(correction, H, R, measurement, pred_state, "Dense"))
+            return EXIT_FAILURE;
+    }
+
+    /* Blocks not matching the size of the measurement. */
+    {
+        TestCorrection<SequentialKFCorrection> correction(utils::make_unique<FixedLinearSensor>(H, block_R, measurement), std::vector<std::size_t>{3, 1});
+
+        GaussianMixture corr_state(pred_state.components, pred_state.dim);
+        try
+        {
+            correction.correctStep(pred_state, corr_state);
+
+            std::cerr << "[Wrong blocks] No exception thrown." << std::endl;
+            return EXIT_FAILURE;
+        }
+        catch (const std::runtime_error&)
+        {
+            std::cout << "[Wrong blocks] Passed." << std::endl;
+        }
+    }
+
+    /* Compare the time of the sequential correction with KFCorrection for a diagonal noise covariance matrix. */
+    for (const std::size_t meas_size_b : {25, 100, 400})
+    {
+        const std::size_t state_size_b = 50;
+        const std::size_t repetitions = 200000000 / (meas_size_b * meas_size_b * meas_size_b + meas_size_b * state_size_b * state_size_b) + 1;
+
+        const MatrixXd H_b = random_matrix(meas_size_b, state_size_b, generator);
+        const MatrixXd R_b = random_block_covariance(std::vector<std::size_t>(meas_size_b, 1), generator);
+        const VectorXd measurement_b = random_matrix(meas_size_b, 1, generator);
+        const GaussianMixture pred_state_b = random_state(1, state_size_b, generator);
+        GaussianMixture corr_state_b(1, state_size_b);
+
+        TestCorrection<KFCorrection> reference_b(utils::make_unique<FixedLinearSensor>(H_b, R_b, measurement_b));
+        TestCorrection<SequentialKFCorrection> correction_b(utils::make_unique<FixedLinearSensor>(H_b, R_b, measurement_b));
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            reference_b.correctStep(pred_state_b, corr_state_b);
+        auto stop = std::chrono::steady_clock::now();
+        const double reference_time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            correction_b.correctStep(pred_state_b, corr_state_b);
+        stop = std::chrono::steady_clock::now();
+        const double time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        std::cout << "[Benchmark] n = " << std::setw(3) << state_size_b << ", m = " << std::setw(3) << meas_size_b
+                  << ": KFCorrection " << std::setw(9) << std::fixed << std::setprecision(1) << reference_time << " us"
+                  << ", SequentialKFCorrection " << std::setw(9) << time << " us" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 #include <cmath>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include <BayesFilters/Gaussian.h>
 #include <BayesFilters/sigma_point.h>
@@ -68,7 +69,7 @@ int main()
 
     VectorXd sigma_point_test_r0((2 * gaussian.dim) + 1);
     VectorXd sigma_point_test_r3((2 * gaussian.dim) + 1);
-    sigma_point_test_r0 << 1, 1, 1, 3, 1, 1, 1, 1, 1, -1, 1, 1, 1;
+    sigma_point_test_r0 << 1, 3, 1, 1, 1, 1, 1, -1, 1, 1, 1, 1, 1;
     sigma_point_test_r3 << 3.14159, 3.14159, 3.14159, 3.14159, -2.34913, 3.14159, 3.14159, 3.14159, 3.14159, 3.14159, 2.34913, 3.14159, 3.14159;
 
     if (((sigma_points.row(0) - sigma_point_test_r0.transpose()).cwiseAbs().sum() > 0.0001) ||
@@ -80,6 +81,115 @@ int main()
         std::cout << "Correct sigma points." << std::endl;
 
 
+    std::cout << "Running square root of covariance matrices..." << std::endl;
+
+    MatrixXd positive_definite(3, 3);
+    positive_definite << 4.0, 1.0, 0.5,
+                         1.0, 3.0, 0.2,
+                         0.5, 0.2, 2.0;
+
+    MatrixXd positive_semidefinite(3, 3);
+    positive_semidefinite << 1.0, 1.0, 0.0,
+                             1.0, 1.0, 0.0,
+                             0.0, 0.0, 2.0;
+
+    MatrixXd indefinite(2, 2);
+    indefinite << 1.0,  0.0,
+                  0.0, -1.0;
+
+    MatrixXd sqrt_positive_definite(3, 3);
+    MatrixXd sqrt_positive_semidefinite(3, 3);
+    MatrixXd sqrt_indefinite(2, 2);
+
+    if ((square_root(positive_definite, sqrt_positive_definite) != SquareRootMethod::LLT)            ||
+        (square_root(positive_semidefinite, sqrt_positive_semidefinite) != SquareRootMethod::LDLT)   ||
+        (square_root(indefinite, sqrt_indefinite) != SquareRootMethod::SVD))
+    {
+        std::cerr << "Wrong decomposition used to evaluate the square root." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (((sqrt_positive_definite * sqrt_positive_definite.transpose() - positive_definite).cwiseAbs().maxCoeff() > 1e-10) ||
+        ((sqrt_positive_semidefinite * sqrt_positive_semidefinite.transpose() - positive_semidefinite).cwiseAbs().maxCoeff() > 1e-10))
+    {
+        std::cerr << "Wrong square root." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<SquareRootMethod> methods;
+    sigma_point::sigma_point(gaussian, weight.c, methods);
+
+    if ((methods.size() != 1) || (methods[0] != SquareRootMethod::LLT))
+    {
+        std::cerr << "Wrong decomposition reported by sigma_point." << std::endl;
+        return EXIT_FAILURE;
+    }
+        std::cout << "Correct square root of covariance matrices." << std::endl;
+
+
+    std::cout << "Running reduced sets of sigma points..." << std::endl;
+
+    Gaussian linear_gaussian(3);
+    linear_gaussian.mean() << 1.0, -2.0, 0.5;
+    linear_gaussian.covariance() << 2.0, 0.3, 0.1,
+                                    0.3, 1.0, 0.2,
+                                    0.1, 0.2, 0.5;
+
+    MatrixXd F(2, 3);
+    F << 1.0, 0.5, 0.0,
+         0.0, 1.0, 2.0;
+
+    FunctionEvaluation linear_function = [&F](const Ref<const MatrixXd>& points)
+                                         {
+                                             return std::make_tuple(true, Data(MatrixXd(F * points)), std::make_pair(std::size_t(2), std::size_t(0)));
+                                         };
+
+    for (SigmaPointSet point_set : {SigmaPointSet::Symmetric, SigmaPointSet::SphericalSimplex, SigmaPointSet::Cubature})
+    {
+        UTWeight set_weight(point_set, linear_gaussian.dim, 0.2);
+
+        std::size_t expected_points = linear_gaussian.dim * 2 + 1;
+        if (point_set == SigmaPointSet::SphericalSimplex)
+            expected_points = linear_gaussian.dim + 2;
+        else if (point_set == SigmaPointSet::Cubature)
+            expected_points = linear_gaussian.dim * 2;
+
+        /* The standard normal sigma points must have zero mean and identity covariance. */
+        MatrixXd points_covariance = set_weight.points * set_weight.covariance.asDiagonal() * set_weight.points.transpose();
+
+        if ((static_cast<std::size_t>(set_weight.mean.size()) != expected_points) ||
+            (std::abs(set_weight.mean.sum() - 1.0) > 1e-12) ||
+            ((set_weight.points * set_weight.mean).cwiseAbs().maxCoeff() > 1e-12) ||
+            ((points_covariance - MatrixXd::Identity(linear_gaussian.dim, linear_gaussian.dim)).cwiseAbs().maxCoeff() > 1e-12))
+        {
+            std::cerr << "Wrong weights of a reduced set of sigma points." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (static_cast<std::size_t>(sigma_point::sigma_point(linear_gaussian, set_weight).cols()) != expected_points)
+        {
+            std::cerr << "Wrong number of sigma points of a reduced set." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* The unscented transform of a linear function is exact. */
+        bool valid;
+        GaussianMixture output;
+        MatrixXd cross_covariance;
+        std::tie(valid, output, cross_covariance) = unscented_transform(linear_gaussian, set_weight, linear_function);
+
+        if (!valid ||
+            ((output.mean() - F * linear_gaussian.mean()).cwiseAbs().maxCoeff() > 1e-10) ||
+            ((output.covariance() - F * linear_gaussian.covariance() * F.transpose()).cwiseAbs().maxCoeff() > 1e-10) ||
+            ((cross_covariance - linear_gaussian.covariance() * F.transpose()).cwiseAbs().maxCoeff() > 1e-10))
+        {
+            std::cerr << "Wrong unscented transform with a reduced set of sigma points." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+        std::cout << "Correct reduced sets of sigma points." << std::endl;
+
+
     std::cout << "done!\n" << std::endl;
 
     return EXIT_SUCCESS;
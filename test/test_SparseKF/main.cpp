@@ -0,0 +1,312 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/KFCorrection.h>
+#include <BayesFilters/KFPrediction.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/LTIStateModel.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * A time invariant state model, optionally hiding the sparse representation of the state transition matrix.
+ */
+class TestStateModel : public LTIStateModel
+{
+public:
+    TestStateModel(const Ref<const MatrixXd>& transition_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const bool sparse) :
+        LTIStateModel(transition_matrix, noise_covariance_matrix),
+        sparse_(sparse)
+    {
+        enableRevisionTracking();
+    }
+
+    std::pair<bool, SparseMatrix<double>> getSparseStateTransitionMatrix() override
+    {
+        if (!sparse_)
+            return std::make_pair(false, SparseMatrix<double>());
+
+        return LTIStateModel::getSparseStateTransitionMatrix();
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(F_.rows(), 0);
+    }
+
+private:
+    bool sparse_;
+};
+
+
+/**
+ * A linear sensor with a fixed measurement, optionally hiding the sparse representation of the measurement matrix.
+ */
+class TestLinearSensor : public LTIMeasurementModel
+{
+public:
+    TestLinearSensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix, const Ref<const VectorXd>& measurement, const bool sparse) :
+        LTIMeasurementModel(measurement_matrix, noise_covariance_matrix),
+        measurement_(measurement),
+        sparse_(sparse)
+    {
+        enableRevisionTracking();
+    }
+
+    std::pair<bool, SparseMatrix<double>> getSparseMeasurementMatrix() const override
+    {
+        if (!sparse_)
+            return std::make_pair(false, SparseMatrix<double>());
+
+        return LTIMeasurementModel::getSparseMeasurementMatrix();
+    }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+    void setMeasurementMatrix(const Ref<const MatrixXd>& measurement_matrix)
+    {
+        H_ = measurement_matrix;
+        ++revision_;
+    }
+
+private:
+    MatrixXd measurement_;
+
+    bool sparse_;
+};
+
+
+/**
+ * Filtering steps exposing the protected predictStep() and correctStep().
+ */
+class TestKFPrediction : public KFPrediction
+{
+public:
+    TestKFPrediction(std::unique_ptr<LinearStateModel> state_model) :
+        KFPrediction(std::move(state_model))
+    { }
+
+    void predictStep(const GaussianMixture& prev_state, GaussianMixture& pred_state) override
+    {
+        KFPrediction::predictStep(prev_state, pred_state);
+    }
+};
+
+
+class TestKFCorrection : public KFCorrection
+{
+public:
+    TestKFCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model) :
+        KFCorrection(std::move(measurement_model))
+    { }
+
+    void correctStep(const GaussianMixture& pred_state, GaussianMixture& corr_state) override
+    {
+        KFCorrection::correctStep(pred_state, corr_state);
+    }
+};
+
+
+MatrixXd random_matrix(const std::size_t rows, const std::size_t cols, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    MatrixXd matrix(rows, cols);
+    for (std::size_t i = 0; i < rows * cols; i++)
+        matrix.data()[i] = normal(generator);
+
+    return matrix;
+}
+
+
+MatrixXd random_covariance(const std::size_t size, std::mt19937_64& generator)
+{
+    MatrixXd A = random_matrix(size, size, generator);
+
+    return A * A.transpose() / size + 0.1 * MatrixXd::Identity(size, size);
+}
+
+
+/**
+ * Block diagonal state transition matrix of a white noise acceleration model
+ * for each of the targets, with state (x, x_dot, y, y_dot).
+ */
+MatrixXd white_noise_acceleration_transition(const std::size_t targets, const double T)
+{
+    Matrix4d F;
+    F << 1.0,   T, 0.0, 0.0,
+         0.0, 1.0, 0.0, 0.0,
+         0.0, 0.0, 1.0,   T,
+         0.0, 0.0, 0.0, 1.0;
+
+    MatrixXd transition = MatrixXd::Zero(4 * targets, 4 * targets);
+    for (std::size_t i = 0; i < targets; i++)
+        transition.block<4, 4>(4 * i, 4 * i) = F;
+
+    return transition;
+}
+
+
+/**
+ * Selection matrix measuring the positions (x, y) of each of the targets.
+ */
+MatrixXd position_selection(const std::size_t targets)
+{
+    MatrixXd selection = MatrixXd::Zero(2 * targets, 4 * targets);
+    for (std::size_t i = 0; i < targets; i++)
+    {
+        selection(2 * i, 4 * i) = 1.0;
+        selection(2 * i + 1, 4 * i + 2) = 1.0;
+    }
+
+    return selection;
+}
+
+
+GaussianMixture random_state(const std::size_t components, const std::size_t size, std::mt19937_64& generator)
+{
+    GaussianMixture state(components, size);
+    for (std::size_t i = 0; i < components; i++)
+    {
+        state.mean(i) = random_matrix(size, 1, generator);
+        state.covariance(i) = random_covariance(size, generator);
+    }
+
+    return state;
+}
+
+
+double relative_error(const Ref<const MatrixXd>& value, const Ref<const MatrixXd>& reference)
+{
+    return (value - reference).norm() / std::max(reference.norm(), 1.0);
+}
+
+
+template<typename Function>
+double time_per_call(Function function, const std::size_t repetitions)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t k = 0; k < repetitions; k++)
+        function();
+    auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+}
+
+
+int main()
+{
+    std::cout << "Running sparse Kalman filter tests." << std::endl;
+
+    std::mt19937_64 generator(1);
+
+    /* The sparse representation is provided only for sparse enough matrices. */
+    if (!utils::sparse_view(position_selection(10), utils::default_max_sparse_density).first || utils::sparse_view(random_matrix(20, 40, generator), utils::default_max_sparse_density).first)
+    {
+        std::cerr << "[Sparse view] Wrong choice of the representation." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[Sparse view] Passed." << std::endl;
+
+    /* The sparse representation of a model matrix is evaluated again when the revision of the model changes. */
+    {
+        TestLinearSensor sensor(position_selection(10), MatrixXd::Identity(20, 20), VectorXd::Zero(20), true);
+
+        const MatrixXd first = MatrixXd(sensor.getSparseMeasurementMatrix().second);
+
+        sensor.setMeasurementMatrix(2.0 * position_selection(10));
+        const std::pair<bool, SparseMatrix<double>> second = sensor.getSparseMeasurementMatrix();
+
+        if ((first != position_selection(10)) || !second.first || (MatrixXd(second.second) != 2.0 * position_selection(10)))
+        {
+            std::cerr << "[Sparse cache] Stale sparse measurement matrix." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[Sparse cache] Passed." << std::endl;
+    }
+
+    for (const std::size_t targets : {5, 25, 125})
+    {
+        const std::size_t state_size = 4 * targets;
+        const std::size_t meas_size = 2 * targets;
+        const std::size_t repetitions = 200000000 / (state_size * state_size * state_size) + 1;
+
+        const MatrixXd F = white_noise_acceleration_transition(targets, 0.1);
+        const MatrixXd Q = random_covariance(state_size, generator);
+        const MatrixXd H = position_selection(targets);
+        const MatrixXd R = random_covariance(meas_size, generator);
+        const VectorXd measurement = random_matrix(meas_size, 1, generator);
+
+        TestKFPrediction dense_prediction(utils::make_unique<TestStateModel>(F, Q, false));
+        TestKFPrediction sparse_prediction(utils::make_unique<TestStateModel>(F, Q, true));
+        TestKFCorrection dense_correction(utils::make_unique<TestLinearSensor>(H, R, measurement, false));
+        TestKFCorrection sparse_correction(utils::make_unique<TestLinearSensor>(H, R, measurement, true));
+
+        const GaussianMixture prev_state = random_state(2, state_size, generator);
+        GaussianMixture dense_state(2, state_size);
+        GaussianMixture sparse_state(2, state_size);
+
+        /* The sparse kernels must give the same results of the dense ones. */
+        dense_prediction.predictStep(prev_state, dense_state);
+        sparse_prediction.predictStep(prev_state, sparse_state);
+
+        const double prediction_error = std::max(relative_error(sparse_state.mean(), dense_state.mean()),
+                                                 relative_error(sparse_state.covariance(), dense_state.covariance()));
+
+        dense_correction.correctStep(prev_state, dense_state);
+        sparse_correction.correctStep(prev_state, sparse_state);
+
+        const double correction_error = std::max(relative_error(sparse_state.mean(), dense_state.mean()),
+                                                 relative_error(sparse_state.covariance(), dense_state.covariance()));
+
+        if ((prediction_error > 1e-12) || (correction_error > 1e-12))
+        {
+            std::cerr << "[" << targets << " targets] Wrong results: prediction error " << prediction_error << ", correction error " << correction_error << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "[" << targets << " targets] Passed, prediction error " << prediction_error << ", correction error " << correction_error << "." << std::endl;
+
+        /* Compare the time of the dense and of the sparse kernels. */
+        const GaussianMixture state = random_state(1, state_size, generator);
+        GaussianMixture output(1, state_size);
+
+        const double dense_prediction_time = time_per_call([&]() { dense_prediction.predictStep(state, output); }, repetitions);
+        const double sparse_prediction_time = time_per_call([&]() { sparse_prediction.predictStep(state, output); }, repetitions);
+        const double dense_correction_time = time_per_call([&]() { dense_correction.correctStep(state, output); }, repetitions);
+        const double sparse_correction_time = time_per_call([&]() { sparse_correction.correctStep(state, output); }, repetitions);
+
+        std::cout << "[Benchmark] n = " << std::setw(3) << state_size << ", m = " << std::setw(3) << meas_size << std::fixed << std::setprecision(1)
+                  << ": prediction dense " << std::setw(9) << dense_prediction_time << " us, sparse " << std::setw(9) << sparse_prediction_time << " us"
+                  << "; correction dense " << std::setw(9) << dense_correction_time << " us, sparse " << std::setw(9) << sparse_correction_time << " us" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,327 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <BayesFilters/GaussianMixture.h>
+#include <BayesFilters/KFCorrection.h>
+#include <BayesFilters/KFPrediction.h>
+#include <BayesFilters/LTIMeasurementModel.h>
+#include <BayesFilters/LTIStateModel.h>
+#include <BayesFilters/SteadyStateKFCorrection.h>
+#include <BayesFilters/SteadyStateKFPrediction.h>
+#include <BayesFilters/utils.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * A time invariant state model whose noise covariance matrix can be changed, increasing the revision of the model.
+ */
+class TunableStateModel : public LTIStateModel
+{
+public:
+    TunableStateModel(const Ref<const MatrixXd>& transition_matrix, const Ref<const MatrixXd>& noise_covariance_matrix) :
+        LTIStateModel(transition_matrix, noise_covariance_matrix)
+    {
+        enableRevisionTracking();
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(F_.rows(), 0);
+    }
+
+    void setNoiseCovarianceMatrix(const Ref<const MatrixXd>& noise_covariance_matrix)
+    {
+        Q_ = noise_covariance_matrix;
+        ++revision_;
+    }
+};
+
+
+/**
+ * A time invariant sensor returning the measurement set by the test.
+ */
+class ReplayLinearSensor : public LTIMeasurementModel
+{
+public:
+    ReplayLinearSensor(const Ref<const MatrixXd>& measurement_matrix, const Ref<const MatrixXd>& noise_covariance_matrix) :
+        LTIMeasurementModel(measurement_matrix, noise_covariance_matrix)
+    {
+        enableRevisionTracking();
+    }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(H_.rows(), 0);
+    }
+
+    MatrixXd measurement;
+};
+
+
+/**
+ * Filtering steps exposing the protected predictStep() and correctStep().
+ */
+template<typename Prediction>
+class TestPrediction : public Prediction
+{
+public:
+    TestPrediction(std::unique_ptr<LinearStateModel> state_model) :
+        Prediction(std::move(state_model))
+    { }
+
+    void predictStep(const GaussianMixture& prev_state, GaussianMixture& pred_state) override
+    {
+        Prediction::predictStep(prev_state, pred_state);
+    }
+};
+
+
+template<typename Correction>
+class TestCorrection : public Correction
+{
+public:
+    TestCorrection(std::unique_ptr<LinearMeasurementModel> measurement_model) :
+        Correction(std::move(measurement_model))
+    { }
+
+    void correctStep(const GaussianMixture& pred_state, GaussianMixture& corr_state) override
+    {
+        Correction::correctStep(pred_state, corr_state);
+    }
+};
+
+
+MatrixXd random_matrix(const std::size_t rows, const std::size_t cols, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    MatrixXd matrix(rows, cols);
+    for (std::size_t i = 0; i < rows * cols; i++)
+        matrix.data()[i] = normal(generator);
+
+    return matrix;
+}
+
+
+MatrixXd random_covariance(const std::size_t size, std::mt19937_64& generator)
+{
+    MatrixXd A = random_matrix(size, size, generator);
+
+    return A * A.transpose() / size + 0.1 * MatrixXd::Identity(size, size);
+}
+
+
+/**
+ * A random stable state transition matrix.
+ */
+MatrixXd random_transition(const std::size_t size, std::mt19937_64& generator)
+{
+    MatrixXd F = MatrixXd::Identity(size, size) + 0.1 * random_matrix(size, size, generator) / std::sqrt(size);
+
+    return 0.95 * F / F.operatorNorm();
+}
+
+
+double relative_error(const Ref<const MatrixXd>& value, const Ref<const MatrixXd>& reference)
+{
+    return (value - reference).norm() / std::max(reference.norm(), 1.0);
+}
+
+
+/**
+ * A Kalman filter made of the given steps, run on the same measurements of another one.
+ */
+template<typename Prediction, typename Correction>
+struct Filter
+{
+    Filter(const Ref<const MatrixXd>& F, const Ref<const MatrixXd>& Q, const Ref<const MatrixXd>& H, const Ref<const MatrixXd>& R, const std::size_t components) :
+        Filter(utils::make_unique<TunableStateModel>(F, Q), utils::make_unique<ReplayLinearSensor>(H, R), F.rows(), components)
+    { }
+
+    Filter(std::unique_ptr<TunableStateModel> state_model, std::unique_ptr<ReplayLinearSensor> sensor, const std::size_t size, const std::size_t components) :
+        state_model(*state_model),
+        sensor(*sensor),
+        prediction(std::move(state_model)),
+        correction(std::move(sensor)),
+        pred_state(components, size),
+        corr_state(components, size)
+    {
+        for (std::size_t i = 0; i < components; i++)
+        {
+            corr_state.mean(i) = VectorXd::Constant(size, i);
+            corr_state.covariance(i) = (i + 1) * MatrixXd::Identity(size, size);
+        }
+    }
+
+    void step(const Ref<const MatrixXd>& measurement)
+    {
+        sensor.measurement = measurement;
+
+        prediction.predictStep(corr_state, pred_state);
+        correction.correctStep(pred_state, corr_state);
+    }
+
+    TunableStateModel& state_model;
+
+    ReplayLinearSensor& sensor;
+
+    TestPrediction<Prediction> prediction;
+
+    TestCorrection<Correction> correction;
+
+    GaussianMixture pred_state;
+
+    GaussianMixture corr_state;
+};
+
+
+using FullFilter = Filter<KFPrediction, KFCorrection>;
+
+using SteadyStateFilter = Filter<SteadyStateKFPrediction, SteadyStateKFCorrection>;
+
+
+int main()
+{
+    std::cout << "Running steady state Kalman filter tests." << std::endl;
+
+    std::mt19937_64 generator(1);
+
+    const std::size_t state_size = 40;
+    const std::size_t meas_size = 20;
+    const std::size_t components = 2;
+
+    const MatrixXd F = random_transition(state_size, generator);
+    const MatrixXd Q = random_covariance(state_size, generator);
+    const MatrixXd H = random_matrix(meas_size, state_size, generator);
+    const MatrixXd R = random_covariance(meas_size, generator);
+
+    FullFilter full(F, Q, H, R, components);
+    SteadyStateFilter steady(F, Q, H, R, components);
+
+    /* The steady state filter must reach the steady state and follow the full recursion. */
+    std::size_t first_steady_step = 0;
+    for (std::size_t k = 0; k < 400; k++)
+    {
+        if (k == 200)
+        {
+            /* A new revision of the state model restores the full recursion. */
+            const MatrixXd new_Q = random_covariance(state_size, generator);
+            full.state_model.setNoiseCovarianceMatrix(new_Q);
+            steady.state_model.setNoiseCovarianceMatrix(new_Q);
+        }
+
+        const MatrixXd measurement = random_matrix(meas_size, components, generator);
+        full.step(measurement);
+        steady.step(measurement);
+
+        const double mean_error = relative_error(steady.corr_state.mean(), full.corr_state.mean());
+        const double covariance_error = relative_error(steady.corr_state.covariance(), full.corr_state.covariance());
+
+        if ((mean_error > 1e-8) || (covariance_error > 1e-8))
+        {
+            std::cerr << "[Step " << k << "] Wrong estimate: mean error " << mean_error << ", covariance error " << covariance_error << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const bool steady_state = steady.prediction.isSteadyState() && steady.correction.isSteadyState();
+        if ((k == 200) && (steady.prediction.isSteadyState() || steady.correction.isSteadyState()))
+        {
+            std::cerr << "[Revision] The steady state has been used after a change of the state model." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (steady_state && (first_steady_step == 0))
+            first_steady_step = k;
+
+        if ((k == 199) || (k == 399))
+        {
+            if (!steady_state)
+            {
+                std::cerr << "[Step " << k << "] The steady state has not been reached." << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            std::cout << "[Step " << k << "] Passed, steady state reached at step " << first_steady_step
+                      << ", mean error " << mean_error << ", covariance error " << covariance_error << "." << std::endl;
+
+            first_steady_step = 0;
+        }
+    }
+
+    /* A state with different covariance matrices restores the full recursion. */
+    for (std::size_t i = 0; i < components; i++)
+    {
+        full.corr_state.covariance(i) = MatrixXd::Identity(state_size, state_size);
+        steady.corr_state.covariance(i) = MatrixXd::Identity(state_size, state_size);
+    }
+
+    const MatrixXd measurement = random_matrix(meas_size, components, generator);
+    full.step(measurement);
+    steady.step(measurement);
+
+    if (steady.prediction.isSteadyState() || steady.correction.isSteadyState() ||
+        (relative_error(steady.corr_state.covariance(), full.corr_state.covariance()) > 1e-12))
+    {
+        std::cerr << "[Reset] The steady state has been used after a change of the state." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[Reset] Passed." << std::endl;
+
+    /* Compare the time of a filtering step before and after the convergence. */
+    for (const std::size_t size : {25, 50, 100, 200})
+    {
+        const std::size_t repetitions = 20000000 / (size * size * size) + 1;
+
+        const MatrixXd F_b = random_transition(size, generator);
+        const MatrixXd Q_b = random_covariance(size, generator);
+        const MatrixXd H_b = random_matrix(size / 2, size, generator);
+        const MatrixXd R_b = random_covariance(size / 2, generator);
+        const MatrixXd measurement_b = random_matrix(size / 2, 1, generator);
+
+        FullFilter full_b(F_b, Q_b, H_b, R_b, 1);
+        SteadyStateFilter steady_b(F_b, Q_b, H_b, R_b, 1);
+
+        for (std::size_t k = 0; (k < 1000) && !steady_b.correction.isSteadyState(); k++)
+            steady_b.step(measurement_b);
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            full_b.step(measurement_b);
+        auto stop = std::chrono::steady_clock::now();
+        const double full_time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t k = 0; k < repetitions; k++)
+            steady_b.step(measurement_b);
+        stop = std::chrono::steady_clock::now();
+        const double steady_time = std::chrono::duration<double, std::micro>(stop - start).count() / repetitions;
+
+        std::cout << "[Benchmark] n = " << std::setw(3) << size << ", m = " << std::setw(3) << size / 2
+                  << ": full recursion " << std::setw(9) << std::fixed << std::setprecision(1) << full_time << " us"
+                  << ", steady state " << std::setw(9) << steady_time << " us"
+                  << (steady_b.correction.isSteadyState() ? "" : " (not converged)") << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,408 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <BayesFilters/AdditiveMeasurementModel.h>
+#include <BayesFilters/AdditiveStateModel.h>
+#include <BayesFilters/Gaussian.h>
+#include <BayesFilters/sigma_point.h>
+#include <BayesFilters/StateModel.h>
+#include <BayesFilters/UKFCorrection.h>
+#include <BayesFilters/UKFPrediction.h>
+#include <BayesFilters/utils.h>
+
+using namespace bfl;
+using namespace bfl::sigma_point;
+using namespace Eigen;
+
+
+/*
+ * Count the heap allocations by interposing malloc and friends, which are used both by Eigen and by
+ * the default operator new. This is only possible with the GNU C library.
+ */
+#if defined(__GLIBC__)
+
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_calloc(std::size_t num, std::size_t size);
+extern "C" void* __libc_realloc(void* ptr, std::size_t size);
+extern "C" void __libc_free(void* ptr);
+
+static bool count_allocations = false;
+static std::size_t allocations = 0;
+
+extern "C" void* malloc(std::size_t size) noexcept
+{
+    if (count_allocations)
+        ++allocations;
+
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t num, std::size_t size) noexcept
+{
+    if (count_allocations)
+        ++allocations;
+
+    return __libc_calloc(num, size);
+}
+
+extern "C" void* realloc(void* ptr, std::size_t size) noexcept
+{
+    if (count_allocations)
+        ++allocations;
+
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void* ptr) noexcept
+{
+    __libc_free(ptr);
+}
+
+#define ALLOCATION_COUNTING_AVAILABLE
+
+#endif
+
+
+/**
+ * Start counting the heap allocations and return the number of allocations
+ * performed since the last call.
+ */
+std::size_t restart_allocation_counter()
+{
+#if defined(ALLOCATION_COUNTING_AVAILABLE)
+    std::size_t counted = allocations;
+
+    allocations = 0;
+    count_allocations = true;
+
+    return counted;
+#else
+    return 0;
+#endif
+}
+
+
+/**
+ * A nonlinear state model, with noise entering through the motion model.
+ * None of its methods allocates memory, except getNoiseCovarianceMatrix().
+ */
+class NonlinearStateModel : public StateModel
+{
+public:
+    NonlinearStateModel() :
+        Q_(MatrixXd::Identity(2, 2) * 0.01)
+    { }
+
+    void propagate(const Ref<const MatrixXd>& cur_states, Ref<MatrixXd> prop_states) override
+    {
+        prop_states.row(0) = cur_states.row(0) + 0.1 * cur_states.row(1).array().sin().matrix();
+        prop_states.row(1) = 0.9 * cur_states.row(1);
+    }
+
+    void motion(const Ref<const MatrixXd>& cur_states, Ref<MatrixXd> mot_states) override
+    {
+        propagate(cur_states.topRows(2), mot_states.topRows(2));
+        mot_states.topRows(2) += cur_states.bottomRows(2);
+        mot_states.bottomRows(2) = cur_states.bottomRows(2);
+    }
+
+    MatrixXd getNoiseCovarianceMatrix() override
+    {
+        return Q_;
+    }
+
+    bool setProperty(const std::string& property) override
+    {
+        return false;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(2, 0);
+    }
+
+private:
+    MatrixXd Q_;
+};
+
+
+/**
+ * The same model, with additive noise.
+ */
+class NonlinearAdditiveStateModel : public AdditiveStateModel
+{
+public:
+    NonlinearAdditiveStateModel() :
+        Q_(MatrixXd::Identity(2, 2) * 0.01)
+    { }
+
+    void propagate(const Ref<const MatrixXd>& cur_states, Ref<MatrixXd> prop_states) override
+    {
+        prop_states.row(0) = cur_states.row(0) + 0.1 * cur_states.row(1).array().sin().matrix();
+        prop_states.row(1) = 0.9 * cur_states.row(1);
+    }
+
+    MatrixXd getNoiseCovarianceMatrix() override
+    {
+        return Q_;
+    }
+
+    bool setProperty(const std::string& property) override
+    {
+        return false;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(2, 0);
+    }
+
+private:
+    MatrixXd Q_;
+};
+
+
+/**
+ * A nonlinear measurement model, with additive noise and a constant measurement.
+ * Its methods allocate memory only for the returned Data and matrices.
+ */
+class NonlinearAdditiveMeasurementModel : public AdditiveMeasurementModel
+{
+public:
+    NonlinearAdditiveMeasurementModel() :
+        R_(MatrixXd::Identity(2, 2) * 0.04),
+        measurement_(MatrixXd::Ones(2, 1))
+    { }
+
+    std::pair<bool, Data> measure() const override
+    {
+        return std::make_pair(true, measurement_);
+    }
+
+    std::pair<bool, Data> predictedMeasure(const Ref<const MatrixXd>& cur_states) const override
+    {
+        MatrixXd predicted_measurements(2, cur_states.cols());
+        predicted_measurements.row(0) = cur_states.row(0) + 0.1 * cur_states.row(1).array().sin().matrix();
+        predicted_measurements.row(1) = 0.5 * cur_states.row(1).array().square().matrix();
+
+        return std::make_pair(true, predicted_measurements);
+    }
+
+    std::pair<bool, Data> innovation(const Data& predicted_measurements, const Data& measurements) const override
+    {
+        const MatrixXd& predicted = any::any_cast<const MatrixXd&>(predicted_measurements);
+
+        MatrixXd innovations = (-predicted).colwise() + any::any_cast<const MatrixXd&>(measurements).col(0);
+
+        return std::make_pair(true, innovations);
+    }
+
+    std::pair<bool, MatrixXd> getNoiseCovarianceMatrix() const override
+    {
+        return std::make_pair(true, R_);
+    }
+
+    bool freezeMeasurements() override
+    {
+        return true;
+    }
+
+    std::pair<std::size_t, std::size_t> getOutputSize() const override
+    {
+        return std::make_pair(2, 0);
+    }
+
+private:
+    MatrixXd R_;
+
+    MatrixXd measurement_;
+};
+
+
+bool is_equal(const GaussianMixture& a, const GaussianMixture& b)
+{
+    return (a.dim == b.dim) && (a.components == b.components) &&
+           ((a.mean() - b.mean()).cwiseAbs().maxCoeff() < 1e-12) &&
+           ((a.covariance() - b.covariance()).cwiseAbs().maxCoeff() < 1e-12);
+}
+
+
+int main()
+{
+#if !defined(ALLOCATION_COUNTING_AVAILABLE)
+    std::cout << "Heap allocations cannot be counted on this platform, only the results of the transform are checked." << std::endl;
+#endif
+
+    GaussianMixture state(2, 2);
+    state.mean(0) << 1.0, 0.5;
+    state.mean(1) << -1.0, 0.2;
+    state.covariance(0) << 0.2, 0.05, 0.05, 0.1;
+    state.covariance(1) << 0.3, 0.0, 0.0, 0.4;
+
+    NonlinearStateModel state_model;
+    NonlinearAdditiveStateModel additive_state_model;
+
+    MatrixXd noise_covariance_matrix = state_model.getNoiseCovarianceMatrix();
+
+    UTWeight augmented_weight(4, 1.0, 2.0, 0.0);
+    UTWeight weight(2, 1.0, 2.0, 0.0);
+
+
+    std::cout << "Comparing the unscented transform with and without workspace..." << std::endl;
+
+    UTWorkspace workspace;
+
+    GaussianMixture state_augmented = state;
+    state_augmented.augmentWithNoise(noise_covariance_matrix);
+
+    GaussianMixture output;
+    std::tie(output, std::ignore) = unscented_transform(state_augmented, augmented_weight, state_model);
+
+    /* Call twice, the second time the workspace is reused. */
+    for (unsigned int k = 0; k < 2; ++k)
+    {
+        unscented_transform(augment_with_noise(state, noise_covariance_matrix, workspace), augmented_weight, state_model, workspace);
+
+        if (!is_equal(workspace.output, output))
+        {
+            std::cerr << "The unscented transform with workspace differs from the unscented transform." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::tie(output, std::ignore) = unscented_transform(state, weight, additive_state_model);
+    for (unsigned int k = 0; k < 2; ++k)
+    {
+        unscented_transform(state, weight, additive_state_model, workspace);
+
+        if (!is_equal(workspace.output, output))
+        {
+            std::cerr << "The additive unscented transform with workspace differs from the additive unscented transform." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* The UKF correction against the Kalman gain evaluated with the inverse of the predicted measurement covariance. */
+    {
+        NonlinearAdditiveMeasurementModel measurement_model;
+
+        GaussianMixture pred_meas;
+        MatrixXd Pxy;
+        std::tie(std::ignore, pred_meas, Pxy) = unscented_transform(state, weight, measurement_model);
+
+        GaussianMixture expected(2, 2);
+        for (std::size_t i = 0; i < state.components; ++i)
+        {
+            MatrixXd K = Pxy.middleCols(2 * i, 2) * pred_meas.covariance(i).inverse();
+            expected.mean(i) = state.mean(i) + K * (VectorXd::Ones(2) - pred_meas.mean(i));
+            expected.covariance(i) = state.covariance(i) - K * pred_meas.covariance(i) * K.transpose();
+        }
+
+        std::unique_ptr<AdditiveMeasurementModel> ukf_measurement_model = utils::make_unique<NonlinearAdditiveMeasurementModel>();
+        UKFCorrection ukf_correction(std::move(ukf_measurement_model), 2, 1.0, 2.0, 0.0);
+        GaussianMixture corr_state(2, 2);
+        for (unsigned int k = 0; k < 2; ++k)
+        {
+            ukf_correction.correct(state, corr_state);
+
+            if (!is_equal(corr_state, expected))
+            {
+                std::cerr << "The UKF correction differs from the correction using the inverse of the measurement covariance." << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    std::cout << "The unscented transforms produced the same results.\n" << std::endl;
+
+
+    std::cout << "Counting heap allocations of the unscented transform with workspace..." << std::endl;
+
+    const std::size_t repetitions = 100;
+
+    /* Allocations performed by the model when returning its noise covariance matrix. */
+    restart_allocation_counter();
+    additive_state_model.getNoiseCovarianceMatrix();
+    std::size_t model_allocations = restart_allocation_counter();
+
+    /* Warm-up. */
+    unscented_transform(augment_with_noise(state, noise_covariance_matrix, workspace), augmented_weight, state_model, workspace);
+
+    restart_allocation_counter();
+    for (std::size_t k = 0; k < repetitions; ++k)
+        unscented_transform(augment_with_noise(state, noise_covariance_matrix, workspace), augmented_weight, state_model, workspace);
+    std::size_t transform_allocations = restart_allocation_counter();
+
+    unscented_transform(state, weight, additive_state_model, workspace);
+
+    restart_allocation_counter();
+    for (std::size_t k = 0; k < repetitions; ++k)
+        unscented_transform(state, weight, additive_state_model, workspace);
+    std::size_t additive_transform_allocations = restart_allocation_counter();
+
+    /* A complete prediction step of the UKF, using an additive state model. */
+    std::unique_ptr<AdditiveStateModel> ukf_state_model = utils::make_unique<NonlinearAdditiveStateModel>();
+    UKFPrediction ukf_prediction(std::move(ukf_state_model), 2, 1.0, 2.0, 0.0);
+    GaussianMixture pred_state(2, 2);
+    ukf_prediction.predict(state, pred_state);
+
+    restart_allocation_counter();
+    for (std::size_t k = 0; k < repetitions; ++k)
+        ukf_prediction.predict(state, pred_state);
+    std::size_t prediction_allocations = restart_allocation_counter();
+
+    /* A complete correction step of the UKF, using an additive measurement model. */
+    NonlinearAdditiveMeasurementModel measurement_model;
+    MatrixXd sigma_points = MatrixXd::Zero(2, weight.mean.size() * state.components);
+    Data predicted_measurements = MatrixXd(MatrixXd::Zero(2, state.components));
+    Data measurements = MatrixXd(MatrixXd::Ones(2, 1));
+
+    /* Allocations performed by the measurement model in a correction step. */
+    restart_allocation_counter();
+    measurement_model.measure();
+    measurement_model.predictedMeasure(sigma_points);
+    measurement_model.getNoiseCovarianceMatrix();
+    measurement_model.innovation(predicted_measurements, measurements);
+    std::size_t measurement_model_allocations = restart_allocation_counter();
+
+    std::unique_ptr<AdditiveMeasurementModel> ukf_measurement_model = utils::make_unique<NonlinearAdditiveMeasurementModel>();
+    UKFCorrection ukf_correction(std::move(ukf_measurement_model), 2, 1.0, 2.0, 0.0);
+    GaussianMixture corr_state(2, 2);
+    ukf_correction.correct(state, corr_state);
+
+    restart_allocation_counter();
+    for (std::size_t k = 0; k < repetitions; ++k)
+        ukf_correction.correct(state, corr_state);
+    std::size_t correction_allocations = restart_allocation_counter();
+
+#if defined(ALLOCATION_COUNTING_AVAILABLE)
+    count_allocations = false;
+#endif
+
+    std::cout << "Allocations per call:"
+              << "\n\tnoise covariance matrix of the model:     " << model_allocations
+              << "\n\tunscented transform:                      " << static_cast<double>(transform_allocations) / repetitions
+              << "\n\tadditive unscented transform:             " << static_cast<double>(additive_transform_allocations) / repetitions
+              << "\n\tUKF prediction with additive state model: " << static_cast<double>(prediction_allocations) / repetitions
+              << "\n\tmeasurement model in a correction:        " << measurement_model_allocations
+              << "\n\tUKF correction with additive measurement model: " << static_cast<double>(correction_allocations) / repetitions << std::endl;
+
+    /* The only allocations left are those performed by the model. */
+    if ((transform_allocations != 0) ||
+        (additive_transform_allocations != repetitions * model_allocations) ||
+        (prediction_allocations != repetitions * model_allocations) ||
+        (correction_allocations != repetitions * measurement_model_allocations))
+    {
+        std::cerr << "The unscented transform or the UKF steps with workspace perform heap allocations." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "The unscented transform and the UKF steps with workspace do not perform heap allocations." << std::endl;
+
+    std::cout << "done!" << std::endl;
+
+    return EXIT_SUCCESS;
+}
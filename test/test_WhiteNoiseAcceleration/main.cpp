@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <BayesFilters/WhiteNoiseAcceleration.h>
+
+#include <Eigen/Dense>
+
+using namespace bfl;
+using namespace Eigen;
+
+
+/**
+ * Transition probability evaluated inverting the noise covariance matrix for each state.
+ */
+VectorXd reference_log_transition_probability(WhiteNoiseAcceleration& wna, const Ref<const MatrixXd>& prev_states, const Ref<const MatrixXd>& cur_states)
+{
+    MatrixXd Q = wna.getNoiseCovarianceMatrix();
+
+    VectorXd log_probabilities(prev_states.cols());
+    for (int i = 0; i < prev_states.cols(); ++i)
+    {
+        VectorXd difference = cur_states.col(i) - prev_states.col(i);
+        log_probabilities(i) = -0.5 * static_cast<double>(difference.size()) * log(2.0 * M_PI) - 0.5 * log(Q.determinant()) - 0.5 * (difference.transpose() * Q.inverse() * difference).coeff(0);
+    }
+
+    return log_probabilities;
+}
+
+
+MatrixXd random_states(const std::size_t num_states, std::mt19937_64& generator)
+{
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    MatrixXd states(4, num_states);
+    for (int i = 0; i < states.size(); ++i)
+        *(states.data() + i) = distribution(generator);
+
+    return states;
+}
+
+
+int main()
+{
+    std::mt19937_64 generator(1);
+
+    std::cout << "Comparing the transition probability of WhiteNoiseAcceleration against a per-state inversion of the noise covariance matrix..." << std::endl;
+
+    WhiteNoiseAcceleration wna(0.5, 2.0);
+
+    MatrixXd prev_states = random_states(100, generator);
+    MatrixXd cur_states = prev_states + wna.getNoiseSample(100);
+
+    VectorXd log_probabilities = wna.getLogTransitionProbability(prev_states, cur_states);
+    VectorXd probabilities = wna.getTransitionProbability(prev_states, cur_states);
+    VectorXd reference = reference_log_transition_probability(wna, prev_states, cur_states);
+
+    if (((log_probabilities - reference).array().abs() > 1e-8).any() ||
+        ((probabilities.array().log() - reference.array()).abs() > 1e-8).any())
+    {
+        std::cerr << "Wrong transition probability." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /* Copies must keep the cached inverse of the noise covariance matrix. */
+    WhiteNoiseAcceleration wna_copy(wna);
+    if (((wna_copy.getLogTransitionProbability(prev_states, cur_states) - log_probabilities).array().abs() > 0.0).any())
+    {
+        std::cerr << "Wrong transition probability of a copy." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "The transition probability is correct.\n" << std::endl;
+
+
+    std::cout << "Scaling benchmark (time per evaluation in milliseconds):" << std::endl;
+    std::cout << std::setw(12) << "states" << std::setw(16) << "per-state" << std::setw(16) << "batched" << std::endl;
+
+    for (std::size_t num_states : {1000, 10000, 100000})
+    {
+        prev_states = random_states(num_states, generator);
+        cur_states = prev_states + wna.getNoiseSample(num_states);
+
+        auto start = std::chrono::steady_clock::now();
+        reference_log_transition_probability(wna, prev_states, cur_states);
+        std::chrono::duration<double, std::milli> reference_time = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        wna.getLogTransitionProbability(prev_states, cur_states);
+        std::chrono::duration<double, std::milli> batched_time = std::chrono::steady_clock::now() - start;
+
+        std::cout << std::setw(12) << num_states
+                  << std::setw(16) << std::fixed << std::setprecision(3) << reference_time.count()
+                  << std::setw(16) << batched_time.count() << std::endl;
+    }
+
+    std::cout << "done!" << std::endl;
+
+    return EXIT_SUCCESS;
+}